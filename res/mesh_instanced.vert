@@ -0,0 +1,63 @@
+#version 460
+
+#extension GL_GOOGLE_include_directive : require
+#extension GL_EXT_buffer_reference : require
+
+#include "input_structures.glsl"
+
+layout (location = 0) out vec3 outNormal;
+layout (location = 1) out vec3 outColor;
+layout (location = 2) out vec2 outUV;
+
+struct Vertex {
+
+	vec3 position;
+	float uv_x;
+	vec3 normal;
+	float uv_y;
+	vec4 color;
+}; 
+
+layout(buffer_reference, std430) readonly buffer VertexBuffer{ 
+	Vertex vertices[];
+};
+
+// Must match GPUDrawInstance
+struct DrawInstance {
+	mat4 worldMatrix;
+	vec4 boundingSphere;
+	VertexBuffer vertexBuffer;
+	uint indexCount;
+	uint firstIndex;
+	uint batchIndex;
+	uint firstCommand;
+	uvec2 padding;
+};
+
+layout(buffer_reference, std430) readonly buffer InstanceBuffer{
+	DrawInstance instances[];
+};
+
+//push constants block, same layout as mesh.vert so both share the pipeline layout
+layout( push_constant ) uniform constants
+{
+	mat4 render_matrix;
+	InstanceBuffer instanceBuffer;
+} PushConstants;
+
+void main() 
+{
+	// Instanced draws start at the first instance of their group, the culling pass writes the instance index as
+	// firstInstance of each indirect command
+	DrawInstance instance = PushConstants.instanceBuffer.instances[gl_InstanceIndex];
+	Vertex v = instance.vertexBuffer.vertices[gl_VertexIndex];
+	
+	vec4 position = vec4(v.position, 1.0f);
+
+	gl_Position =  sceneData.viewproj * instance.worldMatrix * position;	
+
+	outNormal = (instance.worldMatrix * vec4(v.normal, 0.f)).xyz;
+	outColor = v.color.xyz * materialData.colorFactors.xyz;	
+	outUV.x = v.uv_x;
+	outUV.y = v.uv_y;
+}
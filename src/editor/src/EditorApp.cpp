@@ -3,6 +3,7 @@
 //
 
 #include "IApplication.hpp"
+#include "StatsPanel.hpp"
 #include "UI.hpp"
 
 #include <memory>
@@ -30,6 +31,7 @@ public:
     void Update(float delta) override
     {
         this->m_scene->Update(delta);
+        this->m_timeSinceStatsUpdate += delta;
     }
 
     void FixedUpdate(float delta) override
@@ -37,9 +39,22 @@ public:
         this->m_scene->FixedUpdate(delta);
     }
 
+    void SetInterpolationAlpha(float alpha) override
+    {
+        this->m_scene->SetInterpolationAlpha(alpha);
+    }
+
     void OnRender() override
     {
         this->m_scene->Render();
+
+        // Gathering the scene statistics walks every table, so the panel is not refreshed every frame
+        if (this->m_timeSinceStatsUpdate >= STATS_UPDATE_INTERVAL)
+        {
+            this->userInterface.GetPanel<Hush::StatsPanel>().SetSceneStats(this->m_scene->GetStats());
+            this->m_timeSinceStatsUpdate = 0.0f;
+        }
+
         this->userInterface.DrawPanels();
     }
 
@@ -59,8 +74,12 @@ public:
     }
 
 private:
+    /// Seconds between two refreshes of the scene statistics of the stats panel
+    static constexpr float STATS_UPDATE_INTERVAL = 0.5f;
+
     Hush::UI userInterface;
     std::unique_ptr<Hush::Scene> m_scene;
+    float m_timeSinceStatsUpdate = STATS_UPDATE_INTERVAL;
 };
 
 extern "C" bool BundledAppExists_Internal_() // NOLINT(*-identifier-naming)
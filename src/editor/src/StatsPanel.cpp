@@ -1,17 +1,139 @@
 #include "StatsPanel.hpp"
+#include "FrameAllocator.hpp"
+#include "InputManager.hpp"
 #include "imgui/imgui.h"
 
+#include <chrono>
+#include <utility>
+
 
 void Hush::StatsPanel::OnRender() noexcept
 {
 	ImGui::Begin("Hush Engine Stats");
 	ImGui::Text("Delta time: %.4fs", this->m_deltaTime);
 	ImGui::Text("FPS: %.2f", this->m_framesPerSecond);
+	const InputLatencyStats& inputLatency = InputManager::GetInputLatency();
+	ImGui::Text("Input latency: %.0fms (avg %.1fms, max %.0fms)", inputLatency.lastMilliseconds,
+				inputLatency.averageMilliseconds, inputLatency.maxMilliseconds);
+	if (const FrameAllocator* frameAllocator = FrameAllocator::GetMain(); frameAllocator != nullptr)
+	{
+		const FrameAllocatorStats frameMemory = frameAllocator->GetStats();
+		ImGui::Text("Frame memory: %.1f KiB (peak %.1f KiB, reserved %.1f KiB, %u threads)",
+					static_cast<float>(frameMemory.usedBytes) / 1024.0f,
+					static_cast<float>(frameMemory.highWaterMark) / 1024.0f,
+					static_cast<float>(frameMemory.capacity) / 1024.0f, frameMemory.threadCount);
+	}
 	ImGui::Text("Draw calls: %d", this->m_drawCallCount);
 	ImGui::Text("GPU driver: %s", this->m_deviceName.c_str());
+	this->RenderSceneStats();
 	ImGui::End();
 }
 
+void Hush::StatsPanel::RenderSceneStats() noexcept
+{
+	const SceneStats& stats = this->m_sceneStats;
+
+	if (!ImGui::CollapsingHeader("ECS"))
+	{
+		return;
+	}
+
+	ImGui::Text("Entities: %zu", stats.entities);
+	ImGui::Text("Tables: %zu (%zu empty, %zu small)", stats.tables, stats.emptyTables, stats.smallTables);
+	ImGui::Text("Component memory: %.2f KiB", static_cast<float>(stats.bytes) / 1024.0f);
+	ImGui::Text("Tables created/deleted: %llu/%llu", static_cast<unsigned long long>(stats.tablesCreated),
+				static_cast<unsigned long long>(stats.tablesDeleted));
+	ImGui::Text("Structural changes: %.3fms",
+				std::chrono::duration<float, std::milli>(stats.structuralChangeTime).count());
+	ImGui::Text("Query cache: %llu hits, %llu misses", static_cast<unsigned long long>(stats.queryCache.hits),
+				static_cast<unsigned long long>(stats.queryCache.misses));
+
+	constexpr ImGuiTableFlags tableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+										   ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable;
+	const ImVec2 tableSize(0.0f, ImGui::GetTextLineHeightWithSpacing() * 10.0f);
+
+	if (ImGui::TreeNode("Tables"))
+	{
+		if (ImGui::BeginTable("##tables", 3, tableFlags, tableSize))
+		{
+			ImGui::TableSetupColumn("Components");
+			ImGui::TableSetupColumn("Entities");
+			ImGui::TableSetupColumn("Bytes");
+			ImGui::TableHeadersRow();
+
+			for (const TableStats& table : stats.tableStats)
+			{
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(table.type.c_str());
+				ImGui::TableNextColumn();
+				ImGui::Text("%zu", table.entities);
+				ImGui::TableNextColumn();
+				ImGui::Text("%zu", table.bytes);
+			}
+
+			ImGui::EndTable();
+		}
+
+		ImGui::TreePop();
+	}
+
+	if (ImGui::TreeNode("Components"))
+	{
+		if (ImGui::BeginTable("##components", 4, tableFlags, tableSize))
+		{
+			ImGui::TableSetupColumn("Component");
+			ImGui::TableSetupColumn("Tables");
+			ImGui::TableSetupColumn("Entities");
+			ImGui::TableSetupColumn("Bytes");
+			ImGui::TableHeadersRow();
+
+			for (const ComponentStats& component : stats.componentStats)
+			{
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(component.name.c_str());
+				ImGui::TableNextColumn();
+				ImGui::Text("%zu", component.tables);
+				ImGui::TableNextColumn();
+				ImGui::Text("%zu", component.entities);
+				ImGui::TableNextColumn();
+				ImGui::Text("%zu", component.bytes);
+			}
+
+			ImGui::EndTable();
+		}
+
+		ImGui::TreePop();
+	}
+
+	if (ImGui::TreeNode("Queries"))
+	{
+		if (ImGui::BeginTable("##queries", 3, tableFlags, tableSize))
+		{
+			ImGui::TableSetupColumn("Components");
+			ImGui::TableSetupColumn("Tables");
+			ImGui::TableSetupColumn("Entities");
+			ImGui::TableHeadersRow();
+
+			for (const QueryStats& query : stats.queries)
+			{
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(query.terms.c_str());
+				ImGui::TableNextColumn();
+				ImGui::Text("%zu", query.matchedTables);
+				ImGui::TableNextColumn();
+				ImGui::Text("%zu", query.matchedEntities);
+			}
+
+			ImGui::EndTable();
+		}
+
+		ImGui::TreePop();
+	}
+}
+
 void Hush::StatsPanel::SetDeltaTime(float delta)
 {
 	this->m_deltaTime = delta;
@@ -27,3 +149,8 @@ void Hush::StatsPanel::SetDeviceName(const std::string& deviceName)
 {
 	this->m_deviceName = deviceName;
 }
+
+void Hush::StatsPanel::SetSceneStats(SceneStats stats)
+{
+	this->m_sceneStats = std::move(stats);
+}
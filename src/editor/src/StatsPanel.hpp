@@ -1,5 +1,6 @@
 #pragma once
 #include "IEditorPanel.hpp"
+#include <Scene.hpp>
 #include <cstdint>
 #include <string>
 
@@ -15,10 +16,15 @@ namespace Hush {
 
 		void SetDeviceName(const std::string& deviceName);
 
+		void SetSceneStats(SceneStats stats);
+
 	private:
+		void RenderSceneStats() noexcept;
+
 		float m_deltaTime;
 		float m_framesPerSecond;
 		int32_t m_drawCallCount;
 		std::string m_deviceName;
+		SceneStats m_sceneStats;
 	};
 }
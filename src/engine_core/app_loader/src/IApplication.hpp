@@ -32,6 +32,14 @@ namespace Hush
 
         virtual void FixedUpdate(float delta) = 0;
 
+        /// Called before OnPreRender with how far the frame is between the last fixed update and the next one, in
+        /// [0, 1). Applications forward it to their scenes, see \ref Scene::SetInterpolationAlpha.
+        /// @param alpha Interpolation alpha.
+        virtual void SetInterpolationAlpha(float alpha)
+        {
+            (void)alpha;
+        }
+
         virtual void OnPreRender() = 0;
 
         virtual void OnRender() = 0;
@@ -0,0 +1,108 @@
+/*! \file CommandBuffer.cpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Deferred structural changes for scenes
+*/
+
+#include "CommandBuffer.hpp"
+
+#include <algorithm>
+#include <memory>
+
+Hush::CommandBuffer::CommandBuffer(Scene *scene)
+    : m_scene(scene)
+{
+}
+
+Hush::CommandBuffer::~CommandBuffer()
+{
+    Clear();
+}
+
+Hush::CommandBuffer::PendingEntity Hush::CommandBuffer::CreateEntity()
+{
+    const PendingEntity pendingEntity{m_pendingEntities++};
+
+    m_commands.push_back(MakeCommand(ECommandType::Create, pendingEntity, 0));
+
+    return pendingEntity;
+}
+
+void Hush::CommandBuffer::DestroyEntity(Target target)
+{
+    m_commands.push_back(MakeCommand(ECommandType::Destroy, target, 0));
+}
+
+void Hush::CommandBuffer::AddComponentRaw(Target target, EntityId componentId)
+{
+    m_commands.push_back(MakeCommand(ECommandType::Add, target, componentId));
+}
+
+void Hush::CommandBuffer::RemoveComponentRaw(Target target, EntityId componentId)
+{
+    m_commands.push_back(MakeCommand(ECommandType::Remove, target, componentId));
+}
+
+void Hush::CommandBuffer::Clear()
+{
+    for (const Command &command : m_commands)
+    {
+        if (command.destroyData != nullptr)
+        {
+            command.destroyData(command.data);
+        }
+    }
+
+    m_commands.clear();
+    m_pendingEntities = 0;
+    m_sortKey = 0;
+
+    // Keep the chunks, they will be reused by the next commands.
+    m_currentChunk = 0;
+    m_chunkOffset = 0;
+}
+
+Hush::CommandBuffer::Command Hush::CommandBuffer::MakeCommand(ECommandType type,
+                                                              Target target,
+                                                              EntityId componentId) const noexcept
+{
+    return Command{
+        .type = type,
+        .addBeforeSet = false,
+        .target = target,
+        .componentId = componentId,
+        .sortKey = m_sortKey,
+        .data = nullptr,
+        .moveToComponent = nullptr,
+        .destroyData = nullptr,
+    };
+}
+
+void *Hush::CommandBuffer::Allocate(std::size_t size, std::size_t alignment)
+{
+    while (m_currentChunk < m_dataChunks.size())
+    {
+        DataChunk &chunk = m_dataChunks[m_currentChunk];
+
+        void *data = chunk.data.get() + m_chunkOffset;
+        std::size_t space = chunk.size - m_chunkOffset;
+
+        if (std::align(alignment, size, data, space) != nullptr)
+        {
+            m_chunkOffset = chunk.size - space + size;
+            return data;
+        }
+
+        ++m_currentChunk;
+        m_chunkOffset = 0;
+    }
+
+    // No chunk has enough space left, values bigger than a chunk get a chunk of their own.
+    const std::size_t chunkSize = std::max(size + alignment, DATA_CHUNK_SIZE);
+    m_dataChunks.push_back(DataChunk{
+        .data = std::make_unique_for_overwrite<std::byte[]>(chunkSize),
+        .size = chunkSize,
+    });
+
+    return Allocate(size, alignment);
+}
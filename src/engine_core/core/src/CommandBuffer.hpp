@@ -0,0 +1,275 @@
+/*! \file CommandBuffer.hpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Deferred structural changes for scenes
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Hush
+{
+    class Scene;
+
+    /// Records structural changes (create, destroy, add, remove and set) to be applied later by the scene.
+    ///
+    /// Structural changes are not allowed while iterating a query, and the world cannot be written from several
+    /// threads at once. Instead, systems record the changes into a command buffer, and the scene applies all of them
+    /// at the end of the current system bucket. Get the command buffer of the current thread with
+    /// \ref Hush::Scene::GetCommandBuffer.
+    ///
+    /// Commands are applied sorted by their sort key, see \ref SetSortKey. Commands with the same key keep the order
+    /// in which they were recorded, so recording from a single thread is always deterministic. Ties between threads are
+    /// broken by thread pool worker index, but which worker runs a job is not deterministic, so parallel jobs should
+    /// set a key that depends on the work they process (i.e. the chunk index), not on the thread they run on.
+    ///
+    /// ```cpp
+    /// Hush::CommandBuffer &commands = scene.GetCommandBuffer();
+    /// query.Each([&commands](Hush::Entity::EntityId entity, Health &health) {
+    ///     if (health.value <= 0)
+    ///     {
+    ///         commands.DestroyEntity(entity);
+    ///         Hush::CommandBuffer::PendingEntity corpse = commands.CreateEntity();
+    ///         commands.SetComponent(corpse, Corpse{entity});
+    ///     }
+    /// });
+    /// ```
+    class CommandBuffer
+    {
+    public:
+        using EntityId = std::uint64_t;
+
+        /// Entity created by the command buffer. It only gets an id when the command buffer is applied.
+        struct PendingEntity
+        {
+            std::uint32_t index;
+        };
+
+        /// Entity a command applies to, either an existing entity or one created by this command buffer.
+        struct Target
+        {
+            Target(EntityId entityId) noexcept
+                : id(entityId)
+            {
+            }
+
+            Target(PendingEntity pendingEntity) noexcept
+                : id(pendingEntity.index),
+                  isPending(true)
+            {
+            }
+
+            /// Entity id, or pending entity index if isPending is true.
+            EntityId id;
+            bool isPending = false;
+        };
+
+        /// Constructor.
+        /// @param scene Scene the commands are applied to.
+        explicit CommandBuffer(Scene *scene);
+
+        CommandBuffer(const CommandBuffer &) = delete;
+        CommandBuffer &operator=(const CommandBuffer &) = delete;
+        CommandBuffer(CommandBuffer &&) = delete;
+        CommandBuffer &operator=(CommandBuffer &&) = delete;
+
+        ~CommandBuffer();
+
+        /// Record the creation of an entity.
+        /// @return Handle that can be used as the target of other commands of this command buffer.
+        PendingEntity CreateEntity();
+
+        /// Record the destruction of an entity.
+        /// @param target Entity to destroy.
+        void DestroyEntity(Target target);
+
+        /// Record the addition of a default constructed component.
+        /// @tparam T Type of the component.
+        /// @param target Entity to add the component to.
+        template <typename T>
+            requires std::is_default_constructible_v<std::remove_cvref_t<T>>
+        void AddComponent(Target target)
+        {
+            AddComponentRaw(target, GetComponentId<T>());
+        }
+
+        /// Record the override of a component shared with a prefab, see \ref Hush::Entity::OverrideComponent. Unlike
+        /// the entity version, it can be recorded while iterating a query.
+        /// @tparam T Type of the component.
+        /// @param target Entity that gets its own copy of the component.
+        template <typename T>
+        void OverrideComponent(Target target)
+        {
+            // Adding a component that is inherited from a prefab copies the prefab value into the entity.
+            AddComponentRaw(target, GetComponentId<T>());
+        }
+
+        /// Record the removal of a component.
+        /// @tparam T Type of the component.
+        /// @param target Entity to remove the component from.
+        template <typename T>
+        void RemoveComponent(Target target)
+        {
+            RemoveComponentRaw(target, GetComponentId<T>());
+        }
+
+        /// Record the assignment of a component. The component is added if the entity does not have it.
+        /// @tparam T Type of the component.
+        /// @param target Entity to set the component to.
+        /// @param value Value of the component. It is moved into the command buffer.
+        template <typename T>
+        void SetComponent(Target target, T &&value)
+        {
+            using Component = std::remove_cvref_t<T>;
+
+            void *data = Allocate(sizeof(Component), alignof(Component));
+            new (data) Component(std::forward<T>(value));
+
+            Command command = MakeCommand(ECommandType::Set, target, GetComponentId<Component>());
+            command.data = data;
+            command.moveToComponent = &MoveToComponent<Component>;
+            command.destroyData = std::is_trivially_destructible_v<Component> ? nullptr : &DestroyData<Component>;
+            // Components without a default constructor cannot be added in the structural pass.
+            command.addBeforeSet = std::is_default_constructible_v<Component>;
+
+            m_commands.push_back(command);
+        }
+
+        /// Record the addition of a component by id.
+        /// @param target Entity to add the component to.
+        /// @param componentId Id of the component.
+        void AddComponentRaw(Target target, EntityId componentId);
+
+        /// Record the removal of a component by id.
+        /// @param target Entity to remove the component from.
+        /// @param componentId Id of the component.
+        void RemoveComponentRaw(Target target, EntityId componentId);
+
+        /// Set the sort key of the commands recorded from now on.
+        /// @param sortKey Sort key.
+        void SetSortKey(std::uint64_t sortKey) noexcept
+        {
+            m_sortKey = sortKey;
+        }
+
+        /// Check if the command buffer has commands to apply.
+        /// @return True if there are no commands.
+        [[nodiscard]]
+        bool IsEmpty() const noexcept
+        {
+            return m_commands.empty();
+        }
+
+        /// Get the number of recorded commands.
+        /// @return Number of commands.
+        [[nodiscard]]
+        std::size_t Size() const noexcept
+        {
+            return m_commands.size();
+        }
+
+        /// Discard all the recorded commands.
+        void Clear();
+
+        /// Get the id of an entity created by the last applied commands. Valid until the next flush of the scene.
+        /// @param pendingEntity Handle returned by \ref CreateEntity.
+        /// @return Id of the created entity.
+        [[nodiscard]]
+        EntityId GetCreatedEntity(PendingEntity pendingEntity) const noexcept
+        {
+            return m_resolvedEntities[pendingEntity.index];
+        }
+
+    private:
+        friend class Scene;
+
+        /// Size of the chunks used to store the values of set commands.
+        static constexpr std::size_t DATA_CHUNK_SIZE = 16 * 1024;
+
+        enum class ECommandType : std::uint8_t
+        {
+            Create,
+            Destroy,
+            Add,
+            Remove,
+            Set
+        };
+
+        struct Command
+        {
+            ECommandType type;
+            bool addBeforeSet;
+            Target target;
+            EntityId componentId;
+            std::uint64_t sortKey;
+
+            /// Value of set commands
+            void *data;
+            void (*moveToComponent)(void *component, void *data, bool isNew);
+            void (*destroyData)(void *data);
+        };
+
+        template <typename T>
+        static void MoveToComponent(void *component, void *data, bool isNew)
+        {
+            T &value = *static_cast<T *>(data);
+
+            if (isNew)
+            {
+                new (component) T(std::move(value));
+            }
+            else
+            {
+                *static_cast<T *>(component) = std::move(value);
+            }
+        }
+
+        template <typename T>
+        static void DestroyData(void *data)
+        {
+            static_cast<T *>(data)->~T();
+        }
+
+        /// Get the id of a component in the scene. Defined in Scene.hpp, as it needs the complete scene type.
+        /// @tparam T Type of the component.
+        /// @return Id of the component.
+        template <typename T>
+        [[nodiscard]]
+        EntityId GetComponentId() const;
+
+        Command MakeCommand(ECommandType type, Target target, EntityId componentId) const noexcept;
+
+        /// Allocate storage for the value of a set command. Storage is never moved, so values do not need to be
+        /// relocatable.
+        /// @param size Size of the value.
+        /// @param alignment Alignment of the value.
+        /// @return Pointer to the storage.
+        void *Allocate(std::size_t size, std::size_t alignment);
+
+        Scene *m_scene;
+        std::vector<Command> m_commands;
+
+        /// Ids of the pending entities, filled by the scene when the command buffer is applied.
+        std::vector<EntityId> m_resolvedEntities;
+
+        std::uint64_t m_sortKey = 0;
+        std::uint32_t m_pendingEntities = 0;
+
+        struct DataChunk
+        {
+            std::unique_ptr<std::byte[]> data;
+            std::size_t size;
+        };
+
+        std::vector<DataChunk> m_dataChunks;
+        std::size_t m_currentChunk = 0;
+        std::size_t m_chunkOffset = 0;
+    };
+} // namespace Hush
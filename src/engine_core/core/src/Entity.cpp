@@ -4,7 +4,9 @@
     \brief Scene entity
 */
 #include "Entity.hpp"
+#include "Assertions.hpp"
 #include "Scene.hpp"
+#include "Transform.hpp"
 
 #include <flecs.h>
 
@@ -13,39 +15,72 @@ Hush::Entity::EntityId Hush::Entity::RegisterComponentRaw(const ComponentTraits:
     return m_ownerScene->RegisterComponentRaw(desc);
 }
 
-void *Hush::Entity::AddComponentRaw(const EntityId componentId)
+Hush::Entity::EntityId Hush::Entity::InternalCppComponentId(const std::uint32_t &typeIndex,
+                                                            ComponentTraits::ComponentInfo (*getInfo)()) const
 {
-    auto *world = static_cast<ecs_world_t *>(m_ownerScene->GetWorld());
+    return m_ownerScene->GetCppComponentId(typeIndex, getInfo);
+}
 
-    ecs_add_id(world, m_entityId, componentId);
+void *Hush::Entity::AddComponentRaw(const EntityId componentId)
+{
+    auto *world = static_cast<ecs_world_t *>(m_ownerScene->GetStage());
 
-    return ecs_get_mut_id(world, m_entityId, componentId);
+    // In a stage, the component is added when the stage is merged. Ensure returns storage for the value either way.
+    return ecs_ensure_id(world, m_entityId, componentId);
 }
 
 void *Hush::Entity::GetComponentRaw(EntityId componentId)
 {
-    auto *world = static_cast<ecs_world_t *>(m_ownerScene->GetWorld());
+    auto *world = static_cast<ecs_world_t *>(m_ownerScene->GetStage());
+
+    void *component = ecs_get_mut_id(world, m_entityId, componentId);
+
+    // The caller is expected to write it. Flagging it marks its table as changed for change detection.
+    if (component != nullptr)
+    {
+        ecs_modified_id(world, m_entityId, componentId);
+    }
+
+    return component;
+}
+
+void *Hush::Entity::OverrideComponentRaw(EntityId componentId)
+{
+    HUSH_ASSERT(!m_ownerScene->IsIterating(),
+                "Cannot override a component while iterating a query, use CommandBuffer::OverrideComponent instead");
+
+    auto *world = static_cast<ecs_world_t *>(m_ownerScene->GetStage());
 
-    return ecs_get_mut_id(world, m_entityId, componentId);
+    HUSH_ASSERT(ecs_has_id(world, m_entityId, componentId), "Entity does not have the component to override");
+
+    // Ensuring a component inherited from a prefab overrides it with a copy of the prefab value.
+    return ecs_ensure_id(world, m_entityId, componentId);
 }
 
 void *Hush::Entity::GetComponentRaw(EntityId componentId) const
 {
-    auto *world = static_cast<ecs_world_t *>(m_ownerScene->GetWorld());
+    auto *world = static_cast<ecs_world_t *>(m_ownerScene->GetStage());
 
-    return ecs_get_mut_id(world, m_entityId, componentId);
+    return const_cast<void *>(ecs_get_id(world, m_entityId, componentId));
 }
 
 bool Hush::Entity::HasComponentRaw(EntityId componentId)
 {
-    auto *world = static_cast<ecs_world_t *>(m_ownerScene->GetWorld());
+    auto *world = static_cast<ecs_world_t *>(m_ownerScene->GetStage());
 
     return ecs_has_id(world, m_entityId, componentId);
 }
 
+bool Hush::Entity::OwnsComponentRaw(EntityId componentId)
+{
+    auto *world = static_cast<ecs_world_t *>(m_ownerScene->GetStage());
+
+    return ecs_owns_id(world, m_entityId, componentId);
+}
+
 void *Hush::Entity::EmplaceComponentRaw(EntityId componentId, bool &is_new)
 {
-    auto *world = static_cast<ecs_world_t *>(m_ownerScene->GetWorld());
+    auto *world = static_cast<ecs_world_t *>(m_ownerScene->GetStage());
 
     void *component = ecs_emplace_id(world, m_entityId, componentId, &is_new);
 
@@ -54,7 +89,7 @@ void *Hush::Entity::EmplaceComponentRaw(EntityId componentId, bool &is_new)
 
 bool Hush::Entity::RemoveComponentRaw(EntityId componentId)
 {
-    auto world = static_cast<ecs_world_t *>(m_ownerScene->GetWorld());
+    auto *world = static_cast<ecs_world_t *>(m_ownerScene->GetStage());
 
     if (ecs_has_id(world, m_entityId, componentId))
     {
@@ -65,6 +100,31 @@ bool Hush::Entity::RemoveComponentRaw(EntityId componentId)
     return false;
 }
 
+void Hush::Entity::SetParent(EntityId parentId)
+{
+    auto *world = static_cast<ecs_world_t *>(m_ownerScene->GetStage());
+
+    ecs_remove_pair(world, m_entityId, EcsChildOf, EcsWildcard);
+
+    if (parentId != 0)
+    {
+        ecs_add_pair(world, m_entityId, EcsChildOf, parentId);
+    }
+
+    // The world transform must be recomputed against the new parent.
+    if (auto *localTransform = GetComponent<LocalTransform>(); localTransform != nullptr)
+    {
+        localTransform->isDirty = true;
+    }
+}
+
+Hush::Entity::EntityId Hush::Entity::GetParent() const
+{
+    auto *world = static_cast<ecs_world_t *>(m_ownerScene->GetStage());
+
+    return ecs_get_target(world, m_entityId, EcsChildOf, 0);
+}
+
 void Hush::Entity::Destroy(Entity &&entity)
 {
     Scene *scene = entity.m_ownerScene;
@@ -74,7 +134,7 @@ void Hush::Entity::Destroy(Entity &&entity)
 
 std::optional<std::string_view> Hush::Entity::GetName() const
 {
-    auto *world = static_cast<ecs_world_t *>(m_ownerScene->GetWorld());
+    auto *world = static_cast<ecs_world_t *>(m_ownerScene->GetStage());
 
     const char* name = ecs_get_name(world, m_entityId);
 
@@ -93,15 +153,7 @@ void *Hush::Entity::GetSceneWorld() const
 
 bool Hush::Entity::IsComponentRegistered(EntityId componentId) const
 {
-    return ecs_has_id(static_cast<ecs_world_t *>(m_ownerScene->GetWorld()), m_entityId, componentId);
-}
-
-Hush::Entity::EntityId Hush::Entity::InternalRegisterCppComponent(
-    ComponentTraits::detail::EEntityRegisterStatus registerStatus,
-    std::uint64_t *id,
-    const ComponentTraits::ComponentInfo &desc) const
-{
-    return m_ownerScene->InternalRegisterCppComponent(registerStatus, id, desc);
+    return ecs_has_id(static_cast<ecs_world_t *>(m_ownerScene->GetStage()), m_entityId, componentId);
 }
 
 std::optional<Hush::Entity::EntityId> Hush::Entity::InternalCachedComponentId(const std::string_view name) const
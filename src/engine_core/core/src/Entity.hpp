@@ -71,11 +71,22 @@ namespace Hush
         template <typename T>
         bool HasComponent()
         {
-            EntityId componentId = RegisterIfNeededSlow<std::remove_cvref_t<T>>();
+            EntityId componentId = RegisterIfNeeded<std::remove_cvref_t<T>>();
 
             return HasComponentRaw(componentId);
         }
 
+        /// Checks if the entity has its own copy of a component, instead of sharing the one of its prefab.
+        /// @tparam T Type of the component.
+        /// @return True if the entity owns the component, false otherwise.
+        template <typename T>
+        bool OwnsComponent()
+        {
+            EntityId componentId = RegisterIfNeeded<std::remove_cvref_t<T>>();
+
+            return OwnsComponentRaw(componentId);
+        }
+
         /// Add a component to the entity.
         /// If the component is already added, it will return a reference to the existing component.
         /// @tparam T Type of the component.
@@ -84,7 +95,7 @@ namespace Hush
             requires std::is_default_constructible_v<T>
         std::remove_cvref_t<T> &AddComponent()
         {
-            const EntityId componentId = RegisterIfNeededSlow<T>();
+            const EntityId componentId = RegisterIfNeeded<T>();
 
             return *static_cast<std::remove_cvref_t<T> *>(AddComponentRaw(componentId));
         }
@@ -100,7 +111,7 @@ namespace Hush
             requires std::is_constructible_v<T, Args...>
         std::remove_cvref_t<T> &EmplaceComponent(Args &&...args)
         {
-            const EntityId componentId = RegisterIfNeededSlow<std::remove_cvref_t<T>>();
+            const EntityId componentId = RegisterIfNeeded<std::remove_cvref_t<T>>();
 
             bool isNew = false;
 
@@ -115,34 +126,52 @@ namespace Hush
         }
 
         /// Get a component from the entity.
+        /// Components shared with a prefab are not returned, as writing them would change every instance. Read them
+        /// through a const entity, or call \ref OverrideComponent first.
+        /// The component is flagged as modified, so the systems that skip unchanged tables see the write.
         /// @tparam T Type of the component.
-        /// @return Pointer to the component, or nullptr if the component is not found.
+        /// @return Pointer to the component, or nullptr if the entity does not own the component.
         template <typename T>
         std::remove_cvref_t<T> *GetComponent()
         {
-            const EntityId componentId = RegisterIfNeededSlow<std::remove_cvref_t<T>>();
+            const EntityId componentId = RegisterIfNeeded<std::remove_cvref_t<T>>();
 
             return static_cast<std::remove_cvref_t<T> *>(GetComponentRaw(componentId));
         }
 
         /// Get a component from the entity.
+        /// Components shared with a prefab are read from the prefab.
         /// @tparam T Type of the component.
         /// @return Pointer to the component, or nullptr if the component is not found.
         template <typename T>
         const std::remove_cvref_t<T> *GetComponent() const
         {
-            const EntityId componentId = RegisterIfNeededSlow<std::remove_cvref_t<T>>();
+            const EntityId componentId = RegisterIfNeeded<std::remove_cvref_t<T>>();
 
             return static_cast<const std::remove_cvref_t<T> *>(GetComponentRaw(componentId));
         }
 
+        /// Give the entity its own copy of a component it shares with its prefab, initialized with the prefab value.
+        /// Components the entity already owns are returned as they are.
+        /// This moves the entity to another table, so it must not be called while iterating a query. Systems should
+        /// record it in a command buffer instead, see \ref CommandBuffer::OverrideComponent.
+        /// @tparam T Type of the component. The entity must have it.
+        /// @return Reference to the component owned by the entity.
+        template <typename T>
+        std::remove_cvref_t<T> &OverrideComponent()
+        {
+            const EntityId componentId = RegisterIfNeeded<std::remove_cvref_t<T>>();
+
+            return *static_cast<std::remove_cvref_t<T> *>(OverrideComponentRaw(componentId));
+        }
+
         /// Remove a component from the entity.
         /// @tparam T Type of the component.
         /// @return True if the component was removed, false otherwise.
         template <typename T>
         bool RemoveComponent()
         {
-            const EntityId entityId = RegisterIfNeededSlow<std::remove_cvref_t<T>>();
+            const EntityId entityId = RegisterIfNeeded<std::remove_cvref_t<T>>();
 
             return RemoveComponentRaw(entityId);
         }
@@ -152,7 +181,7 @@ namespace Hush
         template <typename T>
         void RegisterComponent() const
         {
-            (void)RegisterIfNeededSlow<std::remove_cvref_t<T>>();
+            (void)RegisterIfNeeded<std::remove_cvref_t<T>>();
         }
 
         // Raw component functions. Mostly for internal use but also usable by bindings. They don't check if the
@@ -186,6 +215,17 @@ namespace Hush
         [[nodiscard]]
         bool HasComponentRaw(EntityId componentId);
 
+        /// Give the entity its own copy of a component it shares with its prefab.
+        /// @param componentId Id of the component.
+        /// @return Pointer to the component owned by the entity.
+        void *OverrideComponentRaw(EntityId componentId);
+
+        /// Check if the entity owns a component, instead of sharing the one of its prefab.
+        /// @param componentId Id of the component.
+        /// @return True if the entity owns the component, false otherwise.
+        [[nodiscard]]
+        bool OwnsComponentRaw(EntityId componentId);
+
         /// Emplace a component to the entity.
         /// If the component is already added, it will return a reference to the existing component.
         /// If the component is new, the user is in charge of constructing it. Not constructing it is undefined
@@ -202,6 +242,16 @@ namespace Hush
         /// @return True if the component was removed, false otherwise.
         bool RemoveComponentRaw(EntityId componentId);
 
+        /// Set the parent of the entity. The entity is destroyed with its parent, and its \ref LocalTransform is
+        /// relative to the parent.
+        /// @param parentId Id of the new parent, or 0 to remove the parent.
+        void SetParent(EntityId parentId);
+
+        /// Get the parent of the entity.
+        /// @return Id of the parent, or 0 if the entity has no parent.
+        [[nodiscard]]
+        EntityId GetParent() const;
+
         /// Destroy an entity. This will remove all components from the entity and destroy it.
         /// This consumes the entity, so it should not be used after this function is called.
         /// @param entity Entity to destroy.
@@ -223,19 +273,25 @@ namespace Hush
         friend class Query<>;
 
         /// Register a component if it is not registered.
+        /// See \ref Hush::Scene::GetComponentId.
         /// @tparam T Type of the component.
         /// @return Id of the component.
         template <typename T>
         [[nodiscard]]
-        EntityId RegisterIfNeededSlow() const
+        EntityId RegisterIfNeeded() const
         {
-            // First, get the entity id, and check if the component is registered.
-            auto [status, componentId] = ComponentTraits::detail::GetEntityId<T>(m_ownerScene);
-            const ComponentTraits::ComponentInfo info = ComponentTraits::GetComponentInfo<T>();
-
-            return InternalRegisterCppComponent(status, componentId, info);
+            return InternalCppComponentId(ComponentTraits::detail::GetTypeIndex<T>(),
+                                          &ComponentTraits::GetComponentInfo<std::remove_cvref_t<T>>);
         }
 
+        /// Get the id of a C++ component from the scene, registering it if needed.
+        /// @param typeIndex Type index of the component.
+        /// @param getInfo Function returning the description of the component.
+        /// @return Id of the component.
+        [[nodiscard]]
+        EntityId InternalCppComponentId(const std::uint32_t &typeIndex,
+                                        ComponentTraits::ComponentInfo (*getInfo)()) const;
+
         [[nodiscard]]
         void *GetSceneWorld() const;
 
@@ -244,15 +300,6 @@ namespace Hush
         /// @return True if the component is registered, false otherwise.
         bool IsComponentRegistered(EntityId componentId) const;
 
-        /// Register a C++ component. C++ components are special because they use a cache in the scene to
-        /// avoid registering the same component multiple times.
-        /// @param desc Component description.
-        /// @return ID of the component.
-        [[nodiscard]]
-        EntityId InternalRegisterCppComponent(ComponentTraits::detail::EEntityRegisterStatus registerStatus,
-                                              std::uint64_t *id,
-                                              const ComponentTraits::ComponentInfo &desc) const;
-
         /// Get the id of a component from the cache.
         /// @param name Name of the component.
         /// @return Id of the component, or std::nullopt if the component is not found.
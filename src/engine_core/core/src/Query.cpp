@@ -9,9 +9,10 @@
 #include <Scene.hpp>
 #include <flecs.h>
 
-Hush::RawQuery::RawQuery(Scene *scene, void *query)
+Hush::RawQuery::RawQuery(Scene *scene, void *query, bool isOwned)
     : m_query(query),
-      m_scene(scene)
+      m_scene(scene),
+      m_isOwned(isOwned)
 {
 }
 
@@ -29,6 +30,7 @@ bool Hush::RawQuery::QueryIterator::Next()
     if (!hasNext)
     {
         m_hasBeenDestroyed = true;
+        m_scene->m_activeIterators.fetch_sub(1, std::memory_order_relaxed);
     }
 
     return hasNext;
@@ -55,11 +57,38 @@ std::size_t Hush::RawQuery::QueryIterator::Size() const
 
 void *const Hush::RawQuery::QueryIterator::GetComponentAt(std::int8_t index, std::size_t size) const
 {
+    if (IsComponentSparse(index))
+    {
+        return nullptr;
+    }
+
     auto *queryIter = reinterpret_cast<const ecs_iter_t *>(m_iterData.data());
 
     return ecs_field_w_size(queryIter, size, index);
 }
 
+void *Hush::RawQuery::QueryIterator::GetComponentAt(std::int8_t index, std::size_t size, std::size_t row) const
+{
+    auto *queryIter = reinterpret_cast<const ecs_iter_t *>(m_iterData.data());
+
+    return ecs_field_at_w_size(queryIter, size, index, static_cast<std::int32_t>(row));
+}
+
+bool Hush::RawQuery::QueryIterator::IsComponentShared(std::int8_t index) const
+{
+    auto *queryIter = reinterpret_cast<const ecs_iter_t *>(m_iterData.data());
+
+    return !ecs_field_is_self(queryIter, index);
+}
+
+bool Hush::RawQuery::QueryIterator::IsComponentSparse(std::int8_t index) const
+{
+    auto *queryIter = reinterpret_cast<const ecs_iter_t *>(m_iterData.data());
+
+    // Fields in row_fields have no column in the table, flecs only gives them one entity at a time.
+    return (queryIter->query->row_fields & (1u << index)) != 0;
+}
+
 std::uint64_t Hush::RawQuery::QueryIterator::GetEntityAt(std::size_t index) const
 {
     auto *queryIter = reinterpret_cast<const ecs_iter_t *>(m_iterData.data());
@@ -69,6 +98,7 @@ std::uint64_t Hush::RawQuery::QueryIterator::GetEntityAt(std::size_t index) cons
 
 Hush::RawQuery::QueryIterator::QueryIterator(QueryIterator &&rhs) noexcept
     : m_iterData(std::move(rhs.m_iterData)),
+      m_scene(rhs.m_scene),
       m_hasBeenDestroyed(std::exchange(rhs.m_hasBeenDestroyed, true))
 {
 }
@@ -77,7 +107,10 @@ Hush::RawQuery::QueryIterator &Hush::RawQuery::QueryIterator::operator=(QueryIte
 {
     if (this != &rhs)
     {
+        Release();
+
         m_iterData = std::move(rhs.m_iterData);
+        m_scene = rhs.m_scene;
         m_hasBeenDestroyed = std::exchange(rhs.m_hasBeenDestroyed, true);
     }
 
@@ -85,6 +118,11 @@ Hush::RawQuery::QueryIterator &Hush::RawQuery::QueryIterator::operator=(QueryIte
 }
 
 Hush::RawQuery::QueryIterator::~QueryIterator()
+{
+    Release();
+}
+
+void Hush::RawQuery::QueryIterator::Release() noexcept
 {
     if (m_hasBeenDestroyed)
     {
@@ -94,11 +132,14 @@ Hush::RawQuery::QueryIterator::~QueryIterator()
     auto *queryIter = reinterpret_cast<ecs_iter_t *>(m_iterData.data());
 
     ecs_iter_fini(queryIter);
+    m_hasBeenDestroyed = true;
+    m_scene->m_activeIterators.fetch_sub(1, std::memory_order_relaxed);
 }
 
 Hush::RawQuery::RawQuery(RawQuery &&rhs) noexcept
     : m_query(std::exchange(rhs.m_query, nullptr)),
-      m_scene(rhs.m_scene)
+      m_scene(rhs.m_scene),
+      m_isOwned(rhs.m_isOwned)
 {
 }
 
@@ -108,6 +149,7 @@ Hush::RawQuery &Hush::RawQuery::operator=(RawQuery &&rhs) noexcept
     {
         m_query = std::exchange(rhs.m_query, nullptr);
         m_scene = rhs.m_scene;
+        m_isOwned = rhs.m_isOwned;
     }
 
     return *this;
@@ -117,7 +159,7 @@ Hush::RawQuery::~RawQuery() noexcept
 {
     auto query = static_cast<ecs_query_t *>(m_query);
 
-    if (query == nullptr)
+    if (query == nullptr || !m_isOwned)
     {
         return;
     }
@@ -127,21 +169,13 @@ Hush::RawQuery::~RawQuery() noexcept
 
 Hush::RawQuery::QueryIterator Hush::RawQuery::GetIterator()
 {
-    auto world = static_cast<ecs_world_t *>(m_scene->GetWorld());
+    // Iterating from a stage lets workers run queries in a staged section.
+    auto world = static_cast<ecs_world_t *>(m_scene->GetStage());
 
     auto queryIter = QueryIterator(m_scene);
 
     ::new (queryIter.m_iterData.data()) ecs_iter_t(ecs_query_iter(world, static_cast<ecs_query_t *>(m_query)));
+    m_scene->m_activeIterators.fetch_add(1, std::memory_order_relaxed);
 
     return queryIter;
-}
-
-Hush::impl::QueryImpl::EntityId Hush::impl::QueryImpl::InternalRegisterCppComponent(
-    ComponentTraits::detail::EEntityRegisterStatus registerStatus,
-    std::uint64_t *id,
-    const ComponentTraits::ComponentInfo &desc)
-{
-    Scene *scene = m_rawQuery.GetScene();
-
-    return scene->InternalRegisterCppComponent(registerStatus, id, desc);
 }
\ No newline at end of file
@@ -18,6 +18,9 @@ namespace Hush
     class Scene;
     class RawQuery;
 
+    template <typename... Components>
+    class QueryHandle;
+
     ///
     /// Low-level query for entities.
     /// This allows getting raw void pointers to components.
@@ -25,7 +28,7 @@ namespace Hush
     /// For more information about the iterator, see \ref QueryIterator.
     class RawQuery
     {
-        RawQuery(Scene *scene, void *query);
+        RawQuery(Scene *scene, void *query, bool isOwned = true);
 
     public:
         /// Cache mode for the query.
@@ -97,7 +100,11 @@ namespace Hush
             /// if the query was creating with a list of components [Position, Velocity], then
             /// Position would be at index 0 and Velocity at index 1.
             ///
-            /// The length of the array is given by \ref Size.
+            /// The length of the array is given by \ref Size, except for components shared with a prefab (see
+            /// \ref IsComponentShared), which point to a single value for the whole table. Shared values belong to the
+            /// prefab and must not be written.
+            ///
+            /// Sparse components (see \ref IsComponentSparse) are not stored in arrays, this returns nullptr for them.
             ///
             /// @param index Index of the component.
             /// @param size Size of the component.
@@ -105,6 +112,28 @@ namespace Hush
             [[nodiscard]]
             void *const GetComponentAt(std::int8_t index, std::size_t size) const;
 
+            /// Get the component of a single entity. Works for every component, and is the only way to read sparse
+            /// ones.
+            /// @param index Index of the component.
+            /// @param size Size of the component.
+            /// @param row Index of the entity. This must be in range [0, Size()).
+            /// @return Pointer to the component of the entity.
+            [[nodiscard]]
+            void *GetComponentAt(std::int8_t index, std::size_t size, std::size_t row) const;
+
+            /// Check if a component of the current table is shared with a prefab instead of owned by the entities.
+            /// @param index Index of the component.
+            /// @return True if \ref GetComponentAt points to a single value of the prefab.
+            [[nodiscard]]
+            bool IsComponentShared(std::int8_t index) const;
+
+            /// Check if a component is stored in a sparse set (\ref ComponentTraits::EComponentFlags::Sparse or
+            /// \ref ComponentTraits::EComponentFlags::DontFragment) instead of in the columns of the table.
+            /// @param index Index of the component.
+            /// @return True if the component must be read one entity at a time with \ref GetComponentAt.
+            [[nodiscard]]
+            bool IsComponentSparse(std::int8_t index) const;
+
             /// Get the entity id at the given index.
             /// @param index Index of the entity. This must be in range [0, Size()).
             /// @return Entity id at the given index.
@@ -124,6 +153,9 @@ namespace Hush
             /// Alignment of the ecs_query_iter_t struct.
             static constexpr std::size_t ECS_ITER_ALIGNMENT = 8;
 
+            /// Finish the iteration if it has not finished yet.
+            void Release() noexcept;
+
             alignas(ECS_ITER_ALIGNMENT) std::array<std::byte, ECS_ITER_SIZE> m_iterData{};
             Scene *m_scene = nullptr;
             bool m_hasBeenDestroyed = false;
@@ -162,8 +194,14 @@ namespace Hush
     private:
         friend class Scene;
 
+        template <typename... Components>
+        friend class QueryHandle;
+
         void *m_query;
         Scene *m_scene;
+
+        /// Whether this object owns the underlying query. Views over scene-cached queries do not.
+        bool m_isOwned = true;
     };
 
     namespace impl
@@ -209,14 +247,16 @@ namespace Hush
                 return m_rawQuery;
             }
 
-            [[nodiscard]]
-            EntityId InternalRegisterCppComponent(ComponentTraits::detail::EEntityRegisterStatus registerStatus,
-                                                  std::uint64_t *id,
-                                                  const ComponentTraits::ComponentInfo &desc);
-
         private:
             RawQuery m_rawQuery;
         };
+
+        /// Type of the values a query gives for a component. Components that can be shared with a prefab are always
+        /// const, use \ref Hush::Entity::OverrideComponent to get a mutable copy.
+        template <typename T>
+        using QueryComponent = std::conditional_t<ComponentTraits::SharedComponent<T>,
+                                                  std::add_const_t<std::remove_reference_t<T>>,
+                                                  std::remove_reference_t<T>>;
     } // namespace impl
 
     /// Query for entities. This wraps the raw query and allows getting components in a type-safe way.
@@ -266,6 +306,10 @@ namespace Hush
     /// query.Each([](Hush::Entity &entity, Position &position, Velocity &velocity) { });
     /// ```
     ///
+    /// Components flagged as \ref ComponentTraits::EComponentFlags::Shared are given as const, as instances of a prefab
+    /// read them from the prefab. In the component arrays, a shared component has a single value for the whole table,
+    /// see \ref QueryIterator::IsShared.
+    ///
     /// @tparam Components Components to query.
     template <typename... Components>
     class Query : public impl::QueryImpl
@@ -275,7 +319,7 @@ namespace Hush
     public:
         using ECacheMode = RawQuery::ECacheMode;
 
-        using ComponentTuple = std::tuple<std::span<std::remove_reference_t<Components>>...>;
+        using ComponentTuple = std::tuple<std::span<impl::QueryComponent<Components>>...>;
         using ConstComponentTuple = std::tuple<std::span<std::add_const_t<std::remove_reference_t<Components>>>...>;
 
         /// Constructor.
@@ -390,6 +434,26 @@ namespace Hush
                 return m_iter.Size();
             }
 
+            /// Check if a component of the current table is shared with a prefab. Its span then has a single value,
+            /// common to all the entities of the table.
+            /// @param index Index of the component in the query.
+            /// @return True if the component is shared.
+            [[nodiscard]]
+            bool IsShared(std::size_t index) const
+            {
+                return m_iter.IsComponentShared(static_cast<std::int8_t>(index));
+            }
+
+            /// Check if a component is stored in a sparse set. Its span is then empty, use \ref Query::Each or
+            /// \ref RawQuery::QueryIterator::GetComponentAt with a row to read it.
+            /// @param index Index of the component in the query.
+            /// @return True if the component is sparse.
+            [[nodiscard]]
+            bool IsSparse(std::size_t index) const
+            {
+                return m_iter.IsComponentSparse(static_cast<std::int8_t>(index));
+            }
+
             /// Get the entity id at the given index. Range is [0, Size()).
             /// @param index Index of the entity.
             /// @return Entity id at the given index.
@@ -419,10 +483,10 @@ namespace Hush
             [[nodiscard]]
             ComponentTuple GetComponents(std::index_sequence<I...>)
             {
-                return std::make_tuple(std::span<std::remove_reference_t<Components>>(
-                    static_cast<std::remove_reference_t<Components> *>(
+                return std::make_tuple(std::span<impl::QueryComponent<Components>>(
+                    static_cast<impl::QueryComponent<Components> *>(
                         m_iter.GetComponentAt(I, sizeof(std::remove_reference_t<Components>))),
-                    m_iter.Size())...);
+                    SpanSize(I))...);
             }
 
             /// Get a tuple of spans of the components.
@@ -436,7 +500,21 @@ namespace Hush
                 return std::make_tuple(std::span<std::add_const_t<std::remove_reference_t<Components>>>(
                     static_cast<std::add_const_t<std::remove_reference_t<Components>> *>(
                         m_iter.GetComponentAt(I, sizeof(std::remove_reference_t<Components>))),
-                    m_iter.Size())...);
+                    SpanSize(I))...);
+            }
+
+            /// Get the length of the span of a component in the current table.
+            /// @param index Index of the component in the query.
+            /// @return Zero for sparse components, one for shared ones and \ref Size otherwise.
+            [[nodiscard]]
+            std::size_t SpanSize(std::size_t index) const
+            {
+                if (IsSparse(index))
+                {
+                    return 0;
+                }
+
+                return IsShared(index) ? 1 : m_iter.Size();
             }
 
             RawQuery::QueryIterator m_iter;
@@ -483,28 +561,10 @@ namespace Hush
         /// @tparam Func Function type.
         /// @param func Function to apply to each entity.
         template <typename Func>
-            requires std::is_invocable_v<Func, std::add_lvalue_reference_t<Components>...>
+            requires std::is_invocable_v<Func, std::add_lvalue_reference_t<impl::QueryComponent<Components>>...>
         void Each(Func &&func)
         {
-            auto it = begin();
-            for (; it != end(); ++it)
-            {
-                const std::size_t size = it.Size();
-                ComponentTuple components = *it;
-
-                for (std::size_t i = 0; i < size; ++i)
-                {
-                    // Get the i-th component of each span. To do this, we convert it to a tuple of references and then
-                    // apply it.
-                    auto component = std::apply(
-                        [&i](auto &&...components) {
-                            return std::tie<std::add_lvalue_reference_t<Components>...>(components[i]...);
-                        },
-                        components);
-
-                    std::apply(func, component);
-                }
-            }
+            EachRow([&func](QueryIterator &, std::size_t, auto &...components) { func(components...); });
         }
 
         /// Apply a function to each entity in the query.
@@ -512,30 +572,13 @@ namespace Hush
         /// @tparam Func Function type.
         /// @param func Function to apply to each entity.
         template <typename Func>
-            requires std::is_invocable_v<Func, EntityId, std::add_lvalue_reference_t<Components>...>
+            requires std::is_invocable_v<Func, EntityId,
+                                         std::add_lvalue_reference_t<impl::QueryComponent<Components>>...>
         void Each(Func &&func)
         {
-            auto it = begin();
-            for (; it != end(); ++it)
-            {
-                const std::size_t size = it.Size();
-                ComponentTuple components = *it;
-
-                for (std::size_t i = 0; i < size; ++i)
-                {
-                    // Get the i-th component of each span. To do this, we convert it to a tuple of references and then
-                    // apply it.
-                    auto entityId = it.GetRawIterator().GetEntityAt(i);
-                    auto component = std::apply(
-                        [&i](auto &&...components) {
-                            return std::tie<std::add_lvalue_reference_t<Components>...>(components[i]...);
-                        },
-                        components);
-
-                    auto finalTuple = std::tuple_cat(std::make_tuple(entityId), component);
-                    std::apply(func, finalTuple);
-                }
-            }
+            EachRow([&func](QueryIterator &it, std::size_t row, auto &...components) {
+                func(it.GetEntityId(row), components...);
+            });
         }
 
         /// Apply a function to each entity in the query.
@@ -543,44 +586,122 @@ namespace Hush
         /// @tparam Func Function type.
         /// @param func Function to apply to each entity.
         template <typename Func>
-            requires std::is_invocable_v<Func, Entity &, std::add_lvalue_reference_t<Components>...>
+            requires std::is_invocable_v<Func, Entity &,
+                                         std::add_lvalue_reference_t<impl::QueryComponent<Components>>...>
         void Each(Func &&func)
         {
-            auto it = begin();
-            for (; it != end(); ++it)
+            EachRow([&func](QueryIterator &it, std::size_t row, auto &...components) {
+                Entity entity = it.GetEntity(row);
+                func(entity, components...);
+            });
+        }
+
+    private:
+        /// Call a function with the components of each entity in the query.
+        /// @tparam Func Function type, called with the iterator, the row in the table and the components.
+        /// @param func Function to call.
+        template <typename Func>
+        void EachRow(Func &&func)
+        {
+            for (auto it = begin(); it != end(); ++it)
             {
-                const std::size_t size = it.Size();
-                ComponentTuple components = *it;
+                EachRowOfTable(it, func, std::make_index_sequence<sizeof...(Components)>{});
+            }
+        }
 
-                for (std::size_t i = 0; i < size; ++i)
-                {
-                    // Get the i-th component of each span. To do this, we convert it to a tuple of references and then
-                    // apply it.
-                    auto entityId = it.GetRawIterator().GetEntityAt(i);
-                    auto component = std::apply(
-                        [&i](auto &&...components) {
-                            return std::tie<std::add_lvalue_reference_t<Components>...>(components[i]...);
-                        },
-                        components);
-
-                    auto finalTuple =
-                        std::tuple_cat(std::make_tuple(Entity(GetRawQuery().GetScene(), entityId)), component);
-                    std::apply(func, finalTuple);
-                }
+        /// Call a function with the components of each entity of the current table. Shared components have a single
+        /// value for the whole table, so they are indexed with a stride of zero. Sparse components are not in the
+        /// columns of the table and are fetched one entity at a time.
+        /// @tparam Func Function type.
+        /// @tparam I Index sequence.
+        /// @param it Iterator of the query.
+        /// @param func Function to call.
+        template <typename Func, std::size_t... I>
+        static void EachRowOfTable(QueryIterator &it, Func &func, std::index_sequence<I...>)
+        {
+            RawQuery::QueryIterator &rawIter = it.GetRawIterator();
+            const std::size_t size = rawIter.Size();
+
+            const std::tuple<impl::QueryComponent<Components> *...> components = {
+                static_cast<impl::QueryComponent<Components> *>(
+                    rawIter.GetComponentAt(I, sizeof(std::remove_reference_t<Components>)))...};
+            const std::array<std::size_t, sizeof...(Components)> strides = {
+                (rawIter.IsComponentShared(I) ? 0u : 1u)...};
+            const std::array<bool, sizeof...(Components)> isSparse = {rawIter.IsComponentSparse(I)...};
+
+            for (std::size_t row = 0; row < size; ++row)
+            {
+                func(it, row,
+                     (isSparse[I] ? *static_cast<impl::QueryComponent<Components> *>(
+                                        rawIter.GetComponentAt(I, sizeof(std::remove_reference_t<Components>), row))
+                                  : std::get<I>(components)[row * strides[I]])...);
             }
         }
+    };
 
-    private:
-        template <typename T>
+    /// Copyable handle to a query cached by the scene. See \ref Hush::Scene::GetCachedQuery.
+    ///
+    /// The scene owns the underlying query, so handles are cheap to copy and stay valid for the lifetime of the scene.
+    /// Systems can either store the handle or fetch it every frame; fetching only costs a hash lookup, the query is
+    /// compiled and matched against tables only once.
+    ///
+    /// ```cpp
+    /// QueryHandle<Position, Velocity> query = scene.GetCachedQuery<Position, Velocity>();
+    /// query.Each([](Position &position, Velocity &velocity) { });
+    /// ```
+    ///
+    /// @tparam Components Components to query.
+    template <typename... Components>
+    class QueryHandle
+    {
+    public:
+        QueryHandle() = default;
+
+        /// Constructor.
+        /// @param scene Scene that owns the query.
+        /// @param query Cached query.
+        QueryHandle(Scene *scene, void *query) noexcept
+            : m_scene(scene),
+              m_query(query)
+        {
+        }
+
+        /// Check if the handle points to a query.
+        /// @return True if the handle is valid, false otherwise.
         [[nodiscard]]
-        EntityId RegisterIfNeededSlow() const
+        bool IsValid() const noexcept
         {
-            // First, get the entity id, and check if the component is registered.
-            auto [status, componentId] = ComponentTraits::detail::GetEntityId<T>(GetRawQuery().GetScene());
-            const ComponentTraits::ComponentInfo info = ComponentTraits::GetComponentInfo<T>();
+            return m_query != nullptr;
+        }
 
-            return InternalRegisterCppComponent(status, componentId, info);
+        /// Get the scene that owns the query.
+        /// @return Scene that owns the query.
+        [[nodiscard]]
+        Scene *GetScene() const noexcept
+        {
+            return m_scene;
         }
+
+        /// Get a non-owning typed view of the cached query. Destroying the view does not destroy the query.
+        /// @return Query view.
+        [[nodiscard]]
+        Query<Components...> Get() const
+        {
+            return Query<Components...>(RawQuery(m_scene, m_query, false));
+        }
+
+        /// Apply a function to each entity in the query. See \ref Hush::Query::Each.
+        /// @tparam Func Function type.
+        /// @param func Function to apply to each entity.
+        template <typename Func>
+        void Each(Func &&func) const
+        {
+            Get().Each(std::forward<Func>(func));
+        }
+
+    private:
+        Scene *m_scene = nullptr;
+        void *m_query = nullptr;
     };
 
 } // namespace Hush
\ No newline at end of file
@@ -5,22 +5,124 @@
 */
 
 #include "Scene.hpp"
+#include "Assertions.hpp"
+#include "SpatialIndex.hpp"
+#include "Transform.hpp"
+
+#include <ThreadPool.hpp>
 
 #define FLECS_NO_CPP
 #include <flecs.h>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <ranges>
+#include <thread>
+#include <unordered_set>
+
 constexpr std::size_t DEFAULT_SYSTEMS_CAPACITY = 128;
 
+/// Number of scenes whose command buffer each thread remembers
+constexpr std::size_t COMMAND_BUFFER_CACHE_SIZE = 4;
+
+/// Tables with fewer entities than this are counted as small in the scene statistics
+constexpr std::size_t SMALL_TABLE_SIZE = 4;
+
+namespace
+{
+/// Adds the time between its construction and destruction to a total. Only the outermost timer of a thread counts, so
+/// operations that call each other (i.e. a flush creating entities in bulk) are not counted twice.
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer(std::atomic<std::chrono::nanoseconds::rep> &total) noexcept
+        : m_total(total),
+          m_isOutermost(s_depth++ == 0)
+    {
+        if (m_isOutermost)
+        {
+            m_start = std::chrono::steady_clock::now();
+        }
+    }
+
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+    ~ScopedTimer()
+    {
+        --s_depth;
+
+        if (m_isOutermost)
+        {
+            const auto elapsed = std::chrono::steady_clock::now() - m_start;
+            m_total.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                              std::memory_order_relaxed);
+        }
+    }
+
+private:
+    /// Number of timers alive in the calling thread
+    static thread_local std::uint32_t s_depth;
+
+    std::atomic<std::chrono::nanoseconds::rep> &m_total;
+    std::chrono::steady_clock::time_point m_start;
+    bool m_isOutermost;
+};
+
+thread_local std::uint32_t ScopedTimer::s_depth = 0;
+
+/// Hash of an (entity, component) pair.
+struct ComponentKeyHash
+{
+    std::size_t operator()(const std::pair<std::uint64_t, std::uint64_t> &key) const noexcept
+    {
+        return std::hash<std::uint64_t>{}(key.first ^ (key.second * 0x9E3779B97F4A7C15ull));
+    }
+};
+} // namespace
+
+static std::uint64_t NextSceneId()
+{
+    static std::atomic<std::uint64_t> nextSceneId = 1;
+
+    return nextSceneId.fetch_add(1, std::memory_order_relaxed);
+}
+
 Hush::Scene::Scene(HushEngine *engine)
-    : m_engine(engine),
+    : m_sceneId(NextSceneId()),
+      m_engine(engine),
       m_world(ecs_init())
 {
     // Reserve the buckets
     m_userSystems.reserve(DEFAULT_SYSTEMS_CAPACITY);
+
+    m_transformSystem = std::make_unique<TransformSystem>(*this);
+    AddEngineSystem(m_transformSystem.get());
+    m_spatialIndex = std::make_unique<SpatialIndexSystem>(*this);
+    AddEngineSystem(m_spatialIndex.get());
+    SortSystems();
 }
 
 Hush::Scene::~Scene()
 {
+    // Pending commands might hold component values that must be destroyed.
+    m_commandBuffers.clear();
+
+    // Engine systems own queries of the world.
+    m_engineSystems.clear();
+    m_spatialIndex.reset();
+    m_transformSystem.reset();
+
+    // Cached queries are owned by the scene, they must be destroyed before the world.
+    for (const auto &[hash, bucket] : m_queryCache)
+    {
+        for (const CachedQuery &cachedQuery : bucket)
+        {
+            ecs_query_fini(static_cast<ecs_query_t *>(cachedQuery.query));
+        }
+    }
+
     ecs_fini(static_cast<ecs_world_t *>(m_world));
 }
 
@@ -33,6 +135,11 @@ void Hush::Scene::Init()
         {
             system->Init();
         }
+
+        if (!systemBucket.empty())
+        {
+            FlushCommandBuffers();
+        }
     }
 }
 
@@ -44,6 +151,11 @@ void Hush::Scene::Update(float delta)
         {
             system->OnUpdate(delta);
         }
+
+        if (!systemBucket.empty())
+        {
+            FlushCommandBuffers();
+        }
     }
 }
 
@@ -55,6 +167,11 @@ void Hush::Scene::FixedUpdate(float delta)
         {
             system->OnFixedUpdate(delta);
         }
+
+        if (!systemBucket.empty())
+        {
+            FlushCommandBuffers();
+        }
     }
 }
 
@@ -66,6 +183,11 @@ void Hush::Scene::PreRender()
         {
             system->OnPreRender();
         }
+
+        if (!systemBucket.empty())
+        {
+            FlushCommandBuffers();
+        }
     }
 }
 void Hush::Scene::Render()
@@ -76,6 +198,11 @@ void Hush::Scene::Render()
         {
             system->OnRender();
         }
+
+        if (!systemBucket.empty())
+        {
+            FlushCommandBuffers();
+        }
     }
 }
 
@@ -87,6 +214,11 @@ void Hush::Scene::PostRender()
         {
             system->OnPostRender();
         }
+
+        if (!systemBucket.empty())
+        {
+            FlushCommandBuffers();
+        }
     }
 }
 
@@ -98,6 +230,202 @@ void Hush::Scene::Shutdown()
         {
             system->OnShutdown();
         }
+
+        if (!systemBucket.empty())
+        {
+            FlushCommandBuffers();
+        }
+    }
+}
+
+Hush::CommandBuffer &Hush::Scene::GetCommandBuffer()
+{
+    struct CachedCommandBuffer
+    {
+        std::uint64_t sceneId;
+        CommandBuffer *buffer;
+    };
+
+    thread_local std::array<CachedCommandBuffer, COMMAND_BUFFER_CACHE_SIZE> cache{};
+    thread_local std::size_t nextCacheSlot = 0;
+
+    for (const CachedCommandBuffer &cached : cache)
+    {
+        if (cached.sceneId == m_sceneId)
+        {
+            return *cached.buffer;
+        }
+    }
+
+    CommandBuffer *buffer = nullptr;
+    {
+        std::lock_guard lock(m_commandBuffersMutex);
+
+        const std::thread::id threadId = std::this_thread::get_id();
+        auto it = std::ranges::find(m_commandBuffers, threadId, &ThreadCommandBuffer::threadId);
+
+        if (it == m_commandBuffers.end())
+        {
+            std::optional<std::uint32_t> threadIndex;
+            if (m_threadPool != nullptr)
+            {
+                threadIndex = m_threadPool->GetCurrentThreadIndex();
+            }
+
+            const std::uint32_t threadOrder = threadIndex.has_value() ? *threadIndex + 1 : 0;
+
+            // Keep the buffers sorted, so the flush does not depend on which thread recorded a command first.
+            it = std::ranges::upper_bound(m_commandBuffers, threadOrder, {}, &ThreadCommandBuffer::threadOrder);
+            it = m_commandBuffers.insert(it, ThreadCommandBuffer{.threadId = threadId,
+                                                                 .threadOrder = threadOrder,
+                                                                 .buffer = std::make_unique<CommandBuffer>(this)});
+        }
+
+        buffer = it->buffer.get();
+    }
+
+    cache[nextCacheSlot] = CachedCommandBuffer{.sceneId = m_sceneId, .buffer = buffer};
+    nextCacheSlot = (nextCacheSlot + 1) % COMMAND_BUFFER_CACHE_SIZE;
+
+    return *buffer;
+}
+
+void Hush::Scene::FlushCommandBuffers()
+{
+    using ECommandType = CommandBuffer::ECommandType;
+
+    std::lock_guard lock(m_commandBuffersMutex);
+    ScopedTimer timer(m_structuralChangeTime);
+
+    m_pendingCommands.clear();
+    std::size_t numCreatedEntities = 0;
+
+    // Buffers are visited in thread order, and their commands in recording order, the stable sort keeps that order
+    // for commands with the same sort key.
+    for (const ThreadCommandBuffer &threadBuffer : m_commandBuffers)
+    {
+        CommandBuffer *buffer = threadBuffer.buffer.get();
+
+        for (const CommandBuffer::Command &command : buffer->m_commands)
+        {
+            m_pendingCommands.push_back(PendingCommand{.buffer = buffer, .command = &command});
+        }
+
+        buffer->m_resolvedEntities.resize(buffer->m_pendingEntities);
+        numCreatedEntities += buffer->m_pendingEntities;
+    }
+
+    if (m_pendingCommands.empty())
+    {
+        return;
+    }
+
+    std::ranges::stable_sort(m_pendingCommands, {},
+                             [](const PendingCommand &pending) { return pending.command->sortKey; });
+
+    auto *world = static_cast<ecs_world_t *>(m_world);
+
+    // Create all the entities at once, ids are assigned in command order.
+    if (numCreatedEntities > 0)
+    {
+        std::span<const EntityId> createdEntities = CreateEntitiesRaw(numCreatedEntities, {});
+        std::size_t nextEntity = 0;
+
+        for (const PendingCommand &pending : m_pendingCommands)
+        {
+            if (pending.command->type == ECommandType::Create)
+            {
+                pending.buffer->m_resolvedEntities[pending.command->target.id] = createdEntities[nextEntity++];
+            }
+        }
+    }
+
+    const auto resolve = [](const PendingCommand &pending) {
+        const CommandBuffer::Target &target = pending.command->target;
+        return target.isPending ? pending.buffer->m_resolvedEntities[target.id] : target.id;
+    };
+
+    // Structural pass. Deferring merges all the changes of an entity into a single table move.
+    ecs_defer_begin(world);
+
+    for (const PendingCommand &pending : m_pendingCommands)
+    {
+        const CommandBuffer::Command &command = *pending.command;
+        const EntityId entity = resolve(pending);
+
+        switch (command.type)
+        {
+        case ECommandType::Create:
+            break;
+        case ECommandType::Destroy:
+            ecs_delete(world, entity);
+            break;
+        case ECommandType::Add:
+            ecs_add_id(world, entity, command.componentId);
+            break;
+        case ECommandType::Remove:
+            ecs_remove_id(world, entity, command.componentId);
+            break;
+        case ECommandType::Set:
+            if (command.addBeforeSet)
+            {
+                ecs_add_id(world, entity, command.componentId);
+            }
+            break;
+        }
+    }
+
+    ecs_defer_end(world);
+
+    // Values are written after the structural pass, so a set followed by a removal of the same component must be
+    // skipped, or it would add the component back.
+    if (std::ranges::any_of(m_pendingCommands,
+                            [](const PendingCommand &pending) { return pending.command->type == ECommandType::Remove; }))
+    {
+        std::unordered_set<std::pair<EntityId, EntityId>, ComponentKeyHash> removedLater;
+
+        for (PendingCommand &pending : std::views::reverse(m_pendingCommands))
+        {
+            const CommandBuffer::Command &command = *pending.command;
+
+            if (command.type == ECommandType::Remove)
+            {
+                removedLater.emplace(resolve(pending), command.componentId);
+            }
+            else if (command.type == ECommandType::Set)
+            {
+                pending.isRemovedLater = removedLater.contains({resolve(pending), command.componentId});
+            }
+        }
+    }
+
+    // Value pass. Set components were added by the structural pass, or are emplaced here if they cannot be default
+    // constructed.
+    for (const PendingCommand &pending : m_pendingCommands)
+    {
+        const CommandBuffer::Command &command = *pending.command;
+
+        if (command.type != ECommandType::Set || pending.isRemovedLater)
+        {
+            continue;
+        }
+
+        const EntityId entity = resolve(pending);
+
+        if (!ecs_is_alive(world, entity))
+        {
+            continue;
+        }
+
+        bool isNew = false;
+        void *component = ecs_emplace_id(world, entity, command.componentId, &isNew);
+        command.moveToComponent(component, command.data, isNew);
+        ecs_modified_id(world, entity, command.componentId);
+    }
+
+    for (const ThreadCommandBuffer &threadBuffer : m_commandBuffers)
+    {
+        threadBuffer.buffer->Clear();
     }
 }
 
@@ -117,9 +445,63 @@ void Hush::Scene::RemoveSystem(std::string_view name)
     SortSystems();
 }
 
+void Hush::Scene::SetThreadPool(Threading::ThreadPool *threadPool)
+{
+    HUSH_ASSERT(!m_isStaged, "Cannot change the thread pool of a scene in a staged section");
+
+    m_threadPool = threadPool;
+
+    // Stage 0 belongs to the thread that begins the staged sections, the rest to the workers.
+    const std::uint32_t numStages = threadPool != nullptr ? threadPool->GetNumThreads() + 1 : 1;
+    ecs_set_stage_count(static_cast<ecs_world_t *>(m_world), static_cast<std::int32_t>(numStages));
+}
+
+void Hush::Scene::BeginStaged()
+{
+    HUSH_ASSERT(!m_isStaged, "Scene is already in a staged section");
+
+    ecs_readonly_begin(static_cast<ecs_world_t *>(m_world), m_threadPool != nullptr);
+
+    m_stagingThread = std::this_thread::get_id();
+    m_isStaged = true;
+}
+
+void Hush::Scene::EndStaged()
+{
+    HUSH_ASSERT(m_isStaged, "Scene is not in a staged section");
+
+    m_isStaged = false;
+
+    ScopedTimer timer(m_structuralChangeTime);
+    ecs_readonly_end(static_cast<ecs_world_t *>(m_world));
+}
+
+void *Hush::Scene::GetStage() const
+{
+    if (!m_isStaged)
+    {
+        return m_world;
+    }
+
+    if (m_threadPool != nullptr)
+    {
+        if (const std::optional<std::uint32_t> threadIndex = m_threadPool->GetCurrentThreadIndex();
+            threadIndex.has_value())
+        {
+            return ecs_get_stage(static_cast<ecs_world_t *>(m_world), static_cast<std::int32_t>(*threadIndex + 1));
+        }
+    }
+
+    HUSH_ASSERT(std::this_thread::get_id() == m_stagingThread,
+                "Only the workers of the scene thread pool and the thread that began the staged section can modify "
+                "the scene");
+
+    return ecs_get_stage(static_cast<ecs_world_t *>(m_world), 0);
+}
+
 Hush::Entity Hush::Scene::CreateEntity()
 {
-    auto *world = static_cast<ecs_world_t *>(m_world);
+    auto *world = static_cast<ecs_world_t *>(GetStage());
 
     const Entity::EntityId entityId = ecs_new(world);
 
@@ -128,6 +510,8 @@ Hush::Entity Hush::Scene::CreateEntity()
 
 Hush::Entity Hush::Scene::CreateEntityWihName(std::string_view name)
 {
+    HUSH_ASSERT(!m_isStaged, "Named entities cannot be created in a staged section");
+
     auto *world = static_cast<ecs_world_t *>(m_world);
 
     const ecs_entity_desc_t desc = {
@@ -139,18 +523,112 @@ Hush::Entity Hush::Scene::CreateEntityWihName(std::string_view name)
     return Entity{this, entityId};
 }
 
+Hush::Entity Hush::Scene::CreatePrefab()
+{
+    auto *world = static_cast<ecs_world_t *>(GetStage());
+
+    const Entity::EntityId entityId = ecs_new_w_id(world, EcsPrefab);
+
+    return Entity{this, entityId};
+}
+
+Hush::Entity Hush::Scene::CreatePrefabWithName(std::string_view name)
+{
+    Entity prefab = CreateEntityWihName(name);
+
+    ecs_add_id(static_cast<ecs_world_t *>(m_world), prefab.GetId(), EcsPrefab);
+
+    return prefab;
+}
+
+std::span<const Hush::Entity::EntityId> Hush::Scene::Instantiate(const Entity &prefab, std::size_t count)
+{
+    const std::array<EntityId, 1> components = {ecs_pair(EcsIsA, prefab.GetId())};
+
+    return CreateEntitiesRaw(count, components);
+}
+
 void Hush::Scene::DestroyEntity(Entity &&entity)
 {
     auto entityToDestroy = std::move(entity);
-    auto *world = static_cast<ecs_world_t *>(m_world);
+    auto *world = static_cast<ecs_world_t *>(GetStage());
 
     ecs_delete(world, entityToDestroy.GetId());
 }
 
+std::span<const Hush::Entity::EntityId> Hush::Scene::CreateEntitiesRaw(std::size_t count,
+                                                                      std::span<const EntityId> components)
+{
+    // The id array of the bulk descriptor is zero terminated, so one of its slots is reserved.
+    HUSH_ASSERT(components.size() < FLECS_ID_DESC_MAX, "Cannot create entities with {} components, max is {}",
+                components.size(), FLECS_ID_DESC_MAX - 1);
+
+    HUSH_ASSERT(!m_isStaged, "Bulk operations are not available in a staged section");
+
+    if (count == 0)
+    {
+        return {};
+    }
+
+    auto *world = static_cast<ecs_world_t *>(m_world);
+    ScopedTimer timer(m_structuralChangeTime);
+
+    ecs_bulk_desc_t desc = {};
+    desc.count = static_cast<std::int32_t>(count);
+    std::ranges::copy(components, desc.ids);
+
+    // No data is passed, so flecs constructs each component column with a single call to its ctor hook.
+    const ecs_entity_t *entities = ecs_bulk_init(world, &desc);
+
+    return {entities, count};
+}
+
+void Hush::Scene::AddComponentsRaw(std::span<const EntityId> entities, std::span<const EntityId> components)
+{
+    auto *world = static_cast<ecs_world_t *>(m_world);
+    ScopedTimer timer(m_structuralChangeTime);
+
+    // Deferring merges all the operations of an entity into a single table move.
+    ecs_defer_begin(world);
+
+    for (const EntityId entity : entities)
+    {
+        for (const EntityId component : components)
+        {
+            ecs_add_id(world, entity, component);
+        }
+    }
+
+    ecs_defer_end(world);
+}
+
+void Hush::Scene::RemoveComponentsRaw(std::span<const EntityId> entities, std::span<const EntityId> components)
+{
+    auto *world = static_cast<ecs_world_t *>(m_world);
+    ScopedTimer timer(m_structuralChangeTime);
+
+    ecs_defer_begin(world);
+
+    for (const EntityId entity : entities)
+    {
+        for (const EntityId component : components)
+        {
+            ecs_remove_id(world, entity, component);
+        }
+    }
+
+    ecs_defer_end(world);
+}
+
+void *Hush::Scene::GetComponentRaw(EntityId entity, EntityId componentId)
+{
+    return ecs_get_mut_id(static_cast<ecs_world_t *>(GetStage()), entity, componentId);
+}
+
 std::optional<std::uint64_t> Hush::Scene::GetRegisteredComponentId(std::string_view name)
 {
     std::shared_lock lock(m_registeredEntitiesMutex);
-    const auto entityIt = m_registeredEntities.find(name.data());
+    const auto entityIt = m_registeredEntities.find(std::string(name));
 
     if (entityIt != m_registeredEntities.end())
     {
@@ -164,78 +642,51 @@ std::optional<std::uint64_t> Hush::Scene::GetRegisteredComponentId(std::string_v
 void Hush::Scene::RegisterComponentId(std::string_view name, Entity::EntityId id)
 {
     std::unique_lock lock(m_registeredEntitiesMutex);
-    m_registeredEntities.insert_or_assign(name.data(), id);
+    m_registeredEntities.insert_or_assign(std::string(name), id);
 }
 
 Hush::Entity::EntityId Hush::Scene::RegisterComponentRaw(const ComponentTraits::ComponentInfo &desc) const
 {
-    struct ComponentInfo
+    // Owns the name of the component. The info is built once here, so the hooks pass it as is.
+    struct ComponentBinding
     {
-        std::size_t size{};
-        std::size_t alignment{};
         std::string name;
-        ComponentTraits::ComponentOps ops{};
-
-        void *userCtx{};
-        void (*userCtxFree)(void *){};
+        ComponentTraits::ComponentInfo info;
     };
 
-    auto *componentInfo = new ComponentInfo();
-    componentInfo->size = desc.size;
-    componentInfo->alignment = desc.alignment;
-    componentInfo->name = desc.name;
-    componentInfo->ops = desc.ops;
-    componentInfo->userCtx = desc.userCtx;
-    componentInfo->userCtxFree = desc.userCtxFree;
+    auto *binding = new ComponentBinding{.name = std::string(desc.name), .info = desc};
+    binding->info.name = binding->name;
 
     ecs_component_desc_t componentDesc = {};
-    componentDesc.type.alignment = static_cast<ecs_size_t>(componentInfo->alignment);
-    componentDesc.type.size = static_cast<ecs_size_t>(componentInfo->size);
-    componentDesc.type.name = componentInfo->name.data();
-    componentDesc.type.hooks.binding_ctx = componentInfo;
+    componentDesc.type.alignment = static_cast<ecs_size_t>(desc.alignment);
+    componentDesc.type.size = static_cast<ecs_size_t>(desc.size);
+    componentDesc.type.name = binding->name.c_str();
+    componentDesc.type.hooks.binding_ctx = binding;
 
     componentDesc.type.hooks.binding_ctx_free = [](void *ctx) {
-        const auto *info = static_cast<ComponentInfo *>(ctx);
-        if (info->userCtxFree != nullptr)
+        const auto *binding = static_cast<ComponentBinding *>(ctx);
+        if (binding->info.userCtxFree != nullptr)
         {
-            info->userCtxFree(info->userCtx);
+            binding->info.userCtxFree(binding->info.userCtx);
         }
-        delete info;
+        delete binding;
     };
 
+    // Hooks left null make flecs fall back to memcpy (and skip destruction), which is what trivially copyable
+    // components get from ComponentTraits::GetOps.
     if (desc.ops.ctor != nullptr)
     {
         componentDesc.type.hooks.ctor = [](void *ptr, int32_t count, const ecs_type_info_t *type_info) {
-            const auto *info = static_cast<ComponentInfo *>(type_info->hooks.binding_ctx);
-
-            ComponentTraits::ComponentInfo componentDesc = {
-                .size = info->size,
-                .alignment = info->alignment,
-                .name = info->name,
-                .ops = info->ops,
-                .userCtx = info->userCtx,
-                .userCtxFree = info->userCtxFree,
-            };
-
-            info->ops.ctor(ptr, count, componentDesc);
+            const auto &info = static_cast<ComponentBinding *>(type_info->hooks.binding_ctx)->info;
+            info.ops.ctor(ptr, count, info);
         };
     }
 
     if (desc.ops.dtor != nullptr)
     {
         componentDesc.type.hooks.dtor = [](void *ptr, int32_t count, const ecs_type_info_t *type_info) {
-            const auto *info = static_cast<ComponentInfo *>(type_info->hooks.binding_ctx);
-
-            ComponentTraits::ComponentInfo componentDesc = {
-                .size = info->size,
-                .alignment = info->alignment,
-                .name = info->name,
-                .ops = info->ops,
-                .userCtx = info->userCtx,
-                .userCtxFree = info->userCtxFree,
-            };
-
-            info->ops.dtor(ptr, count, componentDesc);
+            const auto &info = static_cast<ComponentBinding *>(type_info->hooks.binding_ctx)->info;
+            info.ops.dtor(ptr, count, info);
         };
     }
 
@@ -243,36 +694,16 @@ Hush::Entity::EntityId Hush::Scene::RegisterComponentRaw(const ComponentTraits::
     {
         componentDesc.type.hooks.copy = [](void *dst, const void *src, int32_t count,
                                            const ecs_type_info_t *type_info) {
-            const auto *info = static_cast<ComponentInfo *>(type_info->hooks.binding_ctx);
-
-            ComponentTraits::ComponentInfo componentDesc = {
-                .size = info->size,
-                .alignment = info->alignment,
-                .name = info->name,
-                .ops = info->ops,
-                .userCtx = info->userCtx,
-                .userCtxFree = info->userCtxFree,
-            };
-
-            info->ops.copy(dst, src, count, componentDesc);
+            const auto &info = static_cast<ComponentBinding *>(type_info->hooks.binding_ctx)->info;
+            info.ops.copy(dst, src, count, info);
         };
     }
 
     if (desc.ops.move != nullptr)
     {
         componentDesc.type.hooks.move = [](void *dst, void *src, int32_t count, const ecs_type_info_t *type_info) {
-            const auto *info = static_cast<ComponentInfo *>(type_info->hooks.binding_ctx);
-
-            ComponentTraits::ComponentInfo componentDesc = {
-                .size = info->size,
-                .alignment = info->alignment,
-                .name = info->name,
-                .ops = info->ops,
-                .userCtx = info->userCtx,
-                .userCtxFree = info->userCtxFree,
-            };
-
-            info->ops.move(dst, src, count, componentDesc);
+            const auto &info = static_cast<ComponentBinding *>(type_info->hooks.binding_ctx)->info;
+            info.ops.move(dst, src, count, info);
         };
     }
 
@@ -280,72 +711,35 @@ Hush::Entity::EntityId Hush::Scene::RegisterComponentRaw(const ComponentTraits::
     {
         componentDesc.type.hooks.copy_ctor = [](void *dst, const void *src, int32_t count,
                                                 const ecs_type_info_t *type_info) {
-            const auto *info = static_cast<ComponentInfo *>(type_info->hooks.binding_ctx);
-
-            ComponentTraits::ComponentInfo componentDesc = {
-                .size = info->size,
-                .alignment = info->alignment,
-                .name = info->name,
-                .ops = info->ops,
-                .userCtx = info->userCtx,
-                .userCtxFree = info->userCtxFree,
-            };
-
-            info->ops.copyCtor(dst, src, count, componentDesc);
+            const auto &info = static_cast<ComponentBinding *>(type_info->hooks.binding_ctx)->info;
+            info.ops.copyCtor(dst, src, count, info);
         };
     }
 
     if (desc.ops.moveCtor != nullptr)
     {
         componentDesc.type.hooks.move_ctor = [](void *dst, void *src, int32_t count, const ecs_type_info_t *type_info) {
-            const auto *info = static_cast<ComponentInfo *>(type_info->hooks.binding_ctx);
-
-            ComponentTraits::ComponentInfo componentDesc = {
-                .size = info->size,
-                .alignment = info->alignment,
-                .name = info->name,
-                .ops = info->ops,
-                .userCtx = info->userCtx,
-                .userCtxFree = info->userCtxFree,
-            };
-
-            info->ops.moveCtor(dst, src, count, componentDesc);
+            const auto &info = static_cast<ComponentBinding *>(type_info->hooks.binding_ctx)->info;
+            info.ops.moveCtor(dst, src, count, info);
         };
     }
 
+    // Flecs calls "ctor_move_dtor" what we call moveDtor (move construct, destroy source), and "move_dtor" what we
+    // call moveAssignDtor (move assign, destroy source).
     if (desc.ops.moveDtor != nullptr)
     {
-        componentDesc.type.hooks.move_dtor = [](void *dst, void *src, int32_t count, const ecs_type_info_t *type_info) {
-            const auto *info = static_cast<ComponentInfo *>(type_info->hooks.binding_ctx);
-
-            ComponentTraits::ComponentInfo componentDesc = {
-                .size = info->size,
-                .alignment = info->alignment,
-                .name = info->name,
-                .ops = info->ops,
-                .userCtx = info->userCtx,
-                .userCtxFree = info->userCtxFree,
-            };
-
-            info->ops.moveDtor(dst, src, count, componentDesc);
+        componentDesc.type.hooks.ctor_move_dtor = [](void *dst, void *src, int32_t count,
+                                                     const ecs_type_info_t *type_info) {
+            const auto &info = static_cast<ComponentBinding *>(type_info->hooks.binding_ctx)->info;
+            info.ops.moveDtor(dst, src, count, info);
         };
     }
 
     if (desc.ops.moveAssignDtor != nullptr)
     {
         componentDesc.type.hooks.move_dtor = [](void *dst, void *src, int32_t count, const ecs_type_info_t *type_info) {
-            const auto *info = static_cast<ComponentInfo *>(type_info->hooks.binding_ctx);
-
-            ComponentTraits::ComponentInfo componentDesc = {
-                .size = info->size,
-                .alignment = info->alignment,
-                .name = info->name,
-                .ops = info->ops,
-                .userCtx = info->userCtx,
-                .userCtxFree = info->userCtxFree,
-            };
-
-            info->ops.moveAssignDtor(dst, src, count, componentDesc);
+            const auto &info = static_cast<ComponentBinding *>(type_info->hooks.binding_ctx)->info;
+            info.ops.moveAssignDtor(dst, src, count, info);
         };
     }
 
@@ -355,6 +749,26 @@ Hush::Entity::EntityId Hush::Scene::RegisterComponentRaw(const ComponentTraits::
     auto *world = static_cast<ecs_world_t *>(GetWorld());
     ecs_entity_t componentId = ecs_component_init(world, &componentDesc);
 
+    if (HasFlag(desc.flags, ComponentTraits::EComponentFlags::Shared))
+    {
+        ecs_add_pair(world, componentId, EcsOnInstantiate, EcsInherit);
+    }
+
+    // Storage traits must be added before any entity has the component.
+    if (HasFlag(desc.flags, ComponentTraits::EComponentFlags::DontFragment))
+    {
+#if FLECS_VERSION_MAJOR > 4 || (FLECS_VERSION_MAJOR == 4 && FLECS_VERSION_MINOR >= 1)
+        ecs_add_id(world, componentId, EcsDontFragment);
+#else
+        // Older flecs versions cannot keep a component out of the archetype, sparse storage is the closest.
+        ecs_add_id(world, componentId, EcsSparse);
+#endif
+    }
+    else if (HasFlag(desc.flags, ComponentTraits::EComponentFlags::Sparse))
+    {
+        ecs_add_id(world, componentId, EcsSparse);
+    }
+
     return componentId;
 }
 
@@ -376,28 +790,138 @@ Hush::RawQuery Hush::Scene::CreateRawQuery(std::span<Entity::EntityId> component
     return RawQuery{this, query};
 }
 
-Hush::Entity::EntityId Hush::Scene::InternalRegisterCppComponent(
-    ComponentTraits::detail::EEntityRegisterStatus registerStatus,
-    std::uint64_t *id,
-    const ComponentTraits::ComponentInfo &desc)
+void *Hush::Scene::FindOrCreateCachedQuery(std::span<const Entity::EntityId> components, RawQuery::ECacheMode cacheMode)
 {
-    // Slow path, the component is zero, which means: 1. It is not registered in this binary instance, or 2. It
-    // has never been registered.
-    if (registerStatus == ComponentTraits::detail::EEntityRegisterStatus::NotRegistered)
+    const std::uint64_t hash = HashQuerySignature(components, cacheMode);
+
+    const auto matches = [&](const CachedQuery &cachedQuery) {
+        return cachedQuery.cacheMode == cacheMode && std::ranges::equal(cachedQuery.terms, components);
+    };
+
+    // Fast path, the query is already in the cache.
     {
-        // First, check if the component is already registered in the scene.
-        if (auto cachedComponentId = GetRegisteredComponentId(desc.name); cachedComponentId.has_value())
+        std::shared_lock lock(m_queryCacheMutex);
+
+        if (const auto bucketIt = m_queryCache.find(hash); bucketIt != m_queryCache.end())
         {
-            // Okay, already registered in the scene by another thread or translation unit.
-            *id = *cachedComponentId;
+            if (const auto it = std::ranges::find_if(bucketIt->second, matches); it != bucketIt->second.end())
+            {
+                m_queryCacheHits.fetch_add(1, std::memory_order_relaxed);
+                return it->query;
+            }
         }
-        else
+    }
+
+    std::unique_lock lock(m_queryCacheMutex);
+
+    // Another thread might have created the query while we were waiting for the lock.
+    std::vector<CachedQuery> &bucket = m_queryCache[hash];
+    if (const auto it = std::ranges::find_if(bucket, matches); it != bucket.end())
+    {
+        m_queryCacheHits.fetch_add(1, std::memory_order_relaxed);
+        return it->query;
+    }
+
+    m_queryCacheMisses.fetch_add(1, std::memory_order_relaxed);
+
+    ecs_query_desc_t queryDesc = {};
+    for (std::uint32_t i = 0; i < components.size(); ++i)
+    {
+        queryDesc.terms[i].id = components[i];
+    }
+
+    queryDesc.cache_kind = static_cast<ecs_query_cache_kind_t>(cacheMode);
+
+    ecs_query_t *query = ecs_query_init(static_cast<ecs_world_t *>(m_world), &queryDesc);
+
+    bucket.push_back(CachedQuery{
+        .terms = std::vector<Entity::EntityId>(components.begin(), components.end()),
+        .cacheMode = cacheMode,
+        .query = query,
+    });
+
+    return query;
+}
+
+Hush::QueryCacheStats Hush::Scene::GetQueryCacheStats() const
+{
+    QueryCacheStats stats{
+        .hits = m_queryCacheHits.load(std::memory_order_relaxed),
+        .misses = m_queryCacheMisses.load(std::memory_order_relaxed),
+    };
+
+    std::shared_lock lock(m_queryCacheMutex);
+
+    for (const auto &[hash, bucket] : m_queryCache)
+    {
+        for (const CachedQuery &cachedQuery : bucket)
         {
-            // We need to register the component.
-            *id = RegisterComponentRaw(desc);
+            const ecs_query_count_t count = ecs_query_count(static_cast<const ecs_query_t *>(cachedQuery.query));
+
+            ++stats.cachedQueries;
+            stats.matchedTables += static_cast<std::size_t>(count.tables);
+            stats.matchedEntities += static_cast<std::size_t>(count.entities);
         }
     }
-    return *id;
+
+    return stats;
+}
+
+std::uint64_t Hush::Scene::HashQuerySignature(std::span<const Entity::EntityId> components,
+                                              RawQuery::ECacheMode cacheMode)
+{
+    // FNV-1a over the component ids and the cache mode.
+    constexpr std::uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+    constexpr std::uint64_t FNV_PRIME = 1099511628211ULL;
+
+    std::uint64_t hash = FNV_OFFSET_BASIS;
+    for (const Entity::EntityId component : components)
+    {
+        hash ^= component;
+        hash *= FNV_PRIME;
+    }
+
+    hash ^= static_cast<std::uint64_t>(cacheMode);
+    hash *= FNV_PRIME;
+
+    return hash;
+}
+
+Hush::Entity::EntityId Hush::Scene::RegisterCppComponentSlow(const std::uint32_t &typeIndex,
+                                                              const ComponentTraits::ComponentInfo &desc)
+{
+    std::lock_guard lock(m_cppComponentsMutex);
+
+    const bool hasSlot = typeIndex < MAX_CPP_COMPONENTS;
+
+    // Another thread might have registered the component while we were waiting for the lock.
+    if (hasSlot && m_cppComponents[typeIndex].typeKey.load(std::memory_order_acquire) == &typeIndex)
+    {
+        return m_cppComponents[typeIndex].id.load(std::memory_order_relaxed);
+    }
+
+    // The component might be registered by another binary, or by bindings, so check the name before registering.
+    EntityId componentId = 0;
+    if (auto cachedComponentId = GetRegisteredComponentId(desc.name); cachedComponentId.has_value())
+    {
+        componentId = *cachedComponentId;
+    }
+    else
+    {
+        componentId = RegisterComponentRaw(desc);
+        RegisterComponentId(desc.name, componentId);
+    }
+
+    // Only fill empty slots. A type of another binary might share the index, and rewriting the slot would race with
+    // the lock-free readers of the type that owns it.
+    if (hasSlot && m_cppComponents[typeIndex].typeKey.load(std::memory_order_relaxed) == nullptr)
+    {
+        CppComponentSlot &slot = m_cppComponents[typeIndex];
+        slot.id.store(componentId, std::memory_order_relaxed);
+        slot.typeKey.store(&typeIndex, std::memory_order_release);
+    }
+
+    return componentId;
 }
 
 void Hush::Scene::AddEngineSystem(ISystem *system)
@@ -424,4 +948,159 @@ void Hush::Scene::SortSystems()
     {
         m_systems[system->Order()].push_back(system.get());
     }
-}
\ No newline at end of file
+}
+
+Hush::SceneStats Hush::Scene::GetStats() const
+{
+    auto *world = static_cast<ecs_world_t *>(m_world);
+
+    SceneStats stats{
+        .queryCache = GetQueryCacheStats(),
+        .structuralChangeTime = std::chrono::nanoseconds(m_structuralChangeTime.load(std::memory_order_relaxed)),
+    };
+
+    std::unordered_map<EntityId, std::string_view> componentNames;
+    std::shared_lock registryLock(m_registeredEntitiesMutex);
+
+    for (const auto &[name, id] : m_registeredEntities)
+    {
+        componentNames.emplace(id, name);
+    }
+
+    const auto getIdName = [world, &componentNames](ecs_id_t id) {
+        if (const auto it = componentNames.find(id); it != componentNames.end())
+        {
+            return std::string(it->second);
+        }
+
+        // Pairs and components that are not registered by name, i.e. (ChildOf, 523).
+        char *idString = ecs_id_str(world, id);
+        std::string name(idString);
+        ecs_os_free(idString);
+
+        return name;
+    };
+
+    std::unordered_map<EntityId, std::size_t> componentIndices;
+
+    // Empty tables are matched too, they are part of the fragmentation.
+    ecs_query_desc_t queryDesc = {};
+    queryDesc.terms[0].id = EcsAny;
+    queryDesc.cache_kind = EcsQueryCacheNone;
+    queryDesc.flags = EcsQueryMatchEmptyTables | EcsQueryMatchPrefab | EcsQueryMatchDisabled;
+    ecs_query_t *query = ecs_query_init(world, &queryDesc);
+
+    ecs_iter_t it = ecs_query_iter(world, query);
+    while (ecs_query_next(&it))
+    {
+        // Tables of the flecs builtin entities are not part of the scene.
+        if (ecs_table_has_flags(it.table, EcsTableHasBuiltins))
+        {
+            continue;
+        }
+
+        TableStats tableStats{
+            .entities = static_cast<std::size_t>(ecs_table_count(it.table)),
+            .capacity = static_cast<std::size_t>(ecs_table_size(it.table)),
+        };
+
+        const ecs_type_t *type = ecs_table_get_type(it.table);
+        for (std::int32_t i = 0; i < type->count; ++i)
+        {
+            const ecs_id_t id = type->array[i];
+            const ecs_type_info_t *typeInfo = ecs_get_type_info(world, id);
+            const std::size_t size = typeInfo != nullptr ? static_cast<std::size_t>(typeInfo->size) : 0;
+
+            if (!tableStats.type.empty())
+            {
+                tableStats.type += ", ";
+            }
+            tableStats.type += getIdName(id);
+            tableStats.bytes += size * tableStats.capacity;
+
+            // Pairs are grouped by relationship, so each parent does not get its own entry.
+            const ecs_id_t componentId = ecs_id_is_pair(id) ? ecs_pair(ecs_pair_first(world, id), EcsWildcard) : id;
+
+            auto [indexIt, isNew] = componentIndices.try_emplace(componentId, stats.componentStats.size());
+            if (isNew)
+            {
+                stats.componentStats.push_back(ComponentStats{.name = getIdName(componentId), .size = size});
+            }
+
+            ComponentStats &componentStats = stats.componentStats[indexIt->second];
+            ++componentStats.tables;
+            componentStats.entities += tableStats.entities;
+            componentStats.bytes += size * tableStats.capacity;
+        }
+
+        ++stats.tables;
+        stats.emptyTables += tableStats.entities == 0 ? 1 : 0;
+        stats.smallTables += tableStats.entities > 0 && tableStats.entities < SMALL_TABLE_SIZE ? 1 : 0;
+        stats.entities += tableStats.entities;
+        stats.bytes += tableStats.bytes;
+        stats.tableStats.push_back(std::move(tableStats));
+    }
+
+    ecs_query_fini(query);
+
+    std::ranges::sort(stats.tableStats, std::ranges::greater{}, &TableStats::entities);
+    std::ranges::sort(stats.componentStats, std::ranges::greater{}, &ComponentStats::bytes);
+
+    {
+        std::shared_lock queryCacheLock(m_queryCacheMutex);
+
+        for (const auto &[hash, bucket] : m_queryCache)
+        {
+            for (const CachedQuery &cachedQuery : bucket)
+            {
+                const ecs_query_count_t count = ecs_query_count(static_cast<const ecs_query_t *>(cachedQuery.query));
+                QueryStats queryStats{
+                    .matchedTables = static_cast<std::size_t>(count.tables),
+                    .matchedEntities = static_cast<std::size_t>(count.entities),
+                };
+
+                for (const EntityId term : cachedQuery.terms)
+                {
+                    if (!queryStats.terms.empty())
+                    {
+                        queryStats.terms += ", ";
+                    }
+                    queryStats.terms += getIdName(term);
+                }
+
+                stats.queries.push_back(std::move(queryStats));
+            }
+        }
+    }
+
+    const ecs_world_info_t *worldInfo = ecs_get_world_info(world);
+    stats.tablesCreated = static_cast<std::uint64_t>(worldInfo->table_create_total);
+    stats.tablesDeleted = static_cast<std::uint64_t>(worldInfo->table_delete_total);
+
+    return stats;
+}
+
+std::vector<Hush::Entity::EntityId> Hush::Scene::QuerySphere(const glm::vec3 &center, float radius) const
+{
+    std::vector<EntityId> result;
+    m_spatialIndex->QuerySphere(center, radius, result);
+
+    return result;
+}
+
+std::vector<Hush::Entity::EntityId> Hush::Scene::QueryAABB(const glm::vec3 &min, const glm::vec3 &max) const
+{
+    std::vector<EntityId> result;
+    m_spatialIndex->QueryAABB(min, max, result);
+
+    return result;
+}
+
+std::vector<Hush::Entity::EntityId> Hush::Scene::QueryRay(const glm::vec3 &origin, const glm::vec3 &direction,
+                                                          float maxDistance) const
+{
+    std::vector<EntityId> result;
+    m_spatialIndex->QueryRay(origin, direction, maxDistance, result);
+
+    return result;
+}
@@ -6,20 +6,137 @@
 
 #pragma once
 
+#include "CommandBuffer.hpp"
 #include "Entity.hpp"
 #include "ISystem.hpp"
 #include "Query.hpp"
 
+#include <glm/vec3.hpp>
+
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
+#include <span>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace Hush
 {
     class HushEngine;
+    class TransformSystem;
+    class SpatialIndexSystem;
+
+    namespace Threading
+    {
+        class ThreadPool;
+    }
+
+    /// Statistics of the scene query cache. See \ref Hush::Scene::GetCachedQuery.
+    struct QueryCacheStats
+    {
+        /// Number of lookups that returned an already cached query.
+        std::uint64_t hits = 0;
+
+        /// Number of lookups that had to create a new query.
+        std::uint64_t misses = 0;
+
+        /// Number of queries currently owned by the cache.
+        std::size_t cachedQueries = 0;
+
+        /// Sum of the tables matched by all cached queries.
+        std::size_t matchedTables = 0;
+
+        /// Sum of the entities matched by all cached queries.
+        std::size_t matchedEntities = 0;
+    };
+
+    /// Statistics of an archetype table. See \ref Hush::Scene::GetStats.
+    struct TableStats
+    {
+        /// Components of the table, separated by commas.
+        std::string type;
+
+        /// Number of entities of the table.
+        std::size_t entities = 0;
+
+        /// Number of entities the table has room for.
+        std::size_t capacity = 0;
+
+        /// Bytes allocated for the component columns of the table.
+        std::size_t bytes = 0;
+    };
+
+    /// Statistics of a component across all the tables of a scene. Pairs are grouped by relationship.
+    struct ComponentStats
+    {
+        std::string name;
+
+        /// Size of the component, 0 for tags.
+        std::size_t size = 0;
+
+        /// Number of tables that have the component.
+        std::size_t tables = 0;
+
+        /// Number of entities that have the component.
+        std::size_t entities = 0;
+
+        /// Bytes allocated for the columns of the component.
+        std::size_t bytes = 0;
+    };
+
+    /// Statistics of a cached query.
+    struct QueryStats
+    {
+        /// Components of the query, separated by commas.
+        std::string terms;
+
+        std::size_t matchedTables = 0;
+        std::size_t matchedEntities = 0;
+    };
+
+    /// Statistics of the archetype storage of a scene. See \ref Hush::Scene::GetStats.
+    struct SceneStats
+    {
+        /// Number of archetype tables, including empty ones.
+        std::size_t tables = 0;
+
+        /// Tables without entities. They are kept around to make moving entities back to them cheap.
+        std::size_t emptyTables = 0;
+
+        /// Tables with a handful of entities. Many of them usually mean that tags are splitting entities into too
+        /// many archetypes.
+        std::size_t smallTables = 0;
+
+        std::size_t entities = 0;
+
+        /// Bytes allocated for component columns.
+        std::size_t bytes = 0;
+
+        /// Tables, sorted by number of entities.
+        std::vector<TableStats> tableStats;
+
+        /// Components, sorted by allocated bytes.
+        std::vector<ComponentStats> componentStats;
+
+        QueryCacheStats queryCache;
+
+        /// Cached queries.
+        std::vector<QueryStats> queries;
+
+        /// Total number of tables created and deleted since the scene was created.
+        std::uint64_t tablesCreated = 0;
+        std::uint64_t tablesDeleted = 0;
+
+        /// Time spent in batched structural changes since the scene was created: flushing command buffers, bulk
+        /// creation, bulk adding and removing components, and merging staged sections.
+        std::chrono::nanoseconds structuralChangeTime{0};
+    };
 
     // TODO: this class is expected to change a lot, it's just a placeholder for now.
     // The API is not ready and I would like to think about implementing it considering scripting in the future and
@@ -28,10 +145,20 @@ namespace Hush
     {
         constexpr static std::uint16_t ORDER_BUCKET_SIZE = ISystem::MAX_ORDER + 1;
 
+        /// Number of slots of the C++ component id table. Types with a greater type index still work, but they go
+        /// through the slow registration path on every lookup.
+        constexpr static std::uint32_t MAX_CPP_COMPONENTS = 1024;
+
         friend class HushEngine;
 
         friend class Entity;
 
+        friend class TransformSystem;
+
+        friend class SpatialIndexSystem;
+
+        friend class SceneSnapshot;
+
         using EntityId = Entity::EntityId;
 
     public:
@@ -62,13 +189,79 @@ namespace Hush
         /// Shutdown is called when the scene is shutting down.
         void Shutdown();
 
+        /// Set how far the current frame is between the last fixed update and the next one. Set by the application
+        /// every frame, before PreRender.
+        /// @param alpha Interpolation alpha, in [0, 1).
+        void SetInterpolationAlpha(float alpha) noexcept
+        {
+            m_interpolationAlpha = alpha;
+        }
+
+        /// Get how far the current frame is between the last fixed update and the next one. Render systems use it to
+        /// blend the previous and the current state of objects simulated in FixedUpdate.
+        /// @return Interpolation alpha, in [0, 1).
+        [[nodiscard]]
+        float GetInterpolationAlpha() const noexcept
+        {
+            return m_interpolationAlpha;
+        }
+
         ///
         /// @tparam S Add a system to the scene
         template <typename S>
             requires std::derived_from<S, ISystem>
         void AddSystem()
         {
-            m_userSystems.push_back(std::make_unique<S>());
+            m_userSystems.push_back(std::make_unique<S>(*this));
+            SortSystems();
+        }
+
+        /// Set the thread pool used by the engine systems of the scene to split their work. Each worker of the
+        /// thread pool gets its own stage, see \ref BeginStaged.
+        /// Must not be called in a staged section.
+        /// @param threadPool Thread pool, or nullptr to run everything in the calling thread.
+        void SetThreadPool(Threading::ThreadPool *threadPool);
+
+        /// Get the thread pool used by the engine systems of the scene.
+        /// @return Thread pool, or nullptr if there is none.
+        [[nodiscard]]
+        Threading::ThreadPool *GetThreadPool() const noexcept
+        {
+            return m_threadPool;
+        }
+
+        /// Get the command buffer of the calling thread.
+        /// Commands recorded in it are applied at the end of the current system bucket, or when calling
+        /// \ref FlushCommandBuffers.
+        /// @return Command buffer of the calling thread.
+        CommandBuffer &GetCommandBuffer();
+
+        /// Apply the commands of all the command buffers of the scene, sorted by their sort key. Commands with the same
+        /// key are applied by thread (the threads outside of the thread pool first, then the workers by index) and
+        /// then in recording order. See \ref CommandBuffer.
+        /// Must not be called while other threads are recording commands.
+        void FlushCommandBuffers();
+
+        /// Begin a staged section. Until \ref EndStaged, the world is read only, and the entity operations (creating,
+        /// destroying, adding, removing and getting components, iterating queries) made from the calling thread or
+        /// from the workers of the scene thread pool go to a stage owned by that thread. Jobs can then modify the
+        /// scene without locks, as long as two threads do not write the same component of the same entity.
+        ///
+        /// Structural changes made in a stage are not visible until the section ends, not even to the thread that
+        /// made them. Writes to existing components are applied in place. Components must be registered before the
+        /// section begins, and named entities and bulk operations are not available in it.
+        ///
+        /// Unlike \ref CommandBuffer, changes are merged in stage order rather than by sort key.
+        void BeginStaged();
+
+        /// End a staged section, merging the stages into the world.
+        void EndStaged();
+
+        /// @return Whether the scene is in a staged section.
+        [[nodiscard]]
+        bool IsStaged() const noexcept
+        {
+            return m_isStaged;
         }
 
         /// Remove a system from the scene by name.
@@ -83,10 +276,99 @@ namespace Hush
         /// @return Entity
         Entity CreateEntityWihName(std::string_view name);
 
+        /// Creates a prefab. Prefabs are templates for other entities, queries do not match them.
+        /// @return Prefab entity. Add the components of its instances to it.
+        Entity CreatePrefab();
+
+        /// Creates a prefab with a name.
+        /// @param name Unique name of the prefab
+        /// @return Prefab entity
+        Entity CreatePrefabWithName(std::string_view name);
+
+        /// Creates many instances of a prefab at once.
+        /// Components flagged as \ref ComponentTraits::EComponentFlags::Shared are not copied: instances read them
+        /// from the prefab until they are overridden with \ref Entity::OverrideComponent or
+        /// \ref CommandBuffer::OverrideComponent. Other components of the prefab are copied to each instance.
+        /// @param prefab Prefab to instantiate.
+        /// @param count Number of instances.
+        /// @return Ids of the new instances. The span is only valid until the next bulk creation in this scene.
+        std::span<const EntityId> Instantiate(const Entity &prefab, std::size_t count);
+
         /// Destroy an entity.
         /// @param entity Entity to destroy
         void DestroyEntity(Entity &&entity);
 
+        /// Creates many entities at once. The entities are allocated directly in the table of their final set of
+        /// components, and the components are default constructed in a single batch per component.
+        /// @tparam Components Components of the new entities.
+        /// @param count Number of entities to create.
+        /// @return Ids of the new entities. The span is only valid until the next bulk creation in this scene.
+        template <typename... Components>
+        std::span<const EntityId> CreateEntities(std::size_t count)
+        {
+            static_assert(sizeof...(Components) < RawQuery::MAX_COMPONENTS, "Too many components");
+            std::array<EntityId, sizeof...(Components)> components = {GetComponentId<Components>()...};
+
+            return CreateEntitiesRaw(count, components);
+        }
+
+        /// Creates many entities at once, and initializes their components with a copy of the given values.
+        /// @tparam Components Components of the new entities.
+        /// @param count Number of entities to create.
+        /// @param values Values to copy to the components of every new entity.
+        /// @return Ids of the new entities. The span is only valid until the next bulk creation in this scene.
+        template <typename... Components>
+            requires(sizeof...(Components) > 0 && (std::is_copy_assignable_v<Components> && ...))
+        std::span<const EntityId> CreateEntities(std::size_t count, const Components &...values)
+        {
+            std::span<const EntityId> entities = CreateEntities<Components...>(count);
+
+            (FillComponent(entities, values), ...);
+
+            return entities;
+        }
+
+        /// Add components to many entities at once. Each entity moves to its new table only once, no matter how many
+        /// components are added.
+        /// @tparam Components Components to add.
+        /// @param entities Entities to add the components to.
+        template <typename... Components>
+        void AddComponents(std::span<const EntityId> entities)
+        {
+            std::array<EntityId, sizeof...(Components)> components = {GetComponentId<Components>()...};
+
+            AddComponentsRaw(entities, components);
+        }
+
+        /// Remove components from many entities at once. Each entity moves to its new table only once, no matter how
+        /// many components are removed.
+        /// @tparam Components Components to remove.
+        /// @param entities Entities to remove the components from.
+        template <typename... Components>
+        void RemoveComponents(std::span<const EntityId> entities)
+        {
+            std::array<EntityId, sizeof...(Components)> components = {GetComponentId<Components>()...};
+
+            RemoveComponentsRaw(entities, components);
+        }
+
+        /// Creates many entities at once with the given component ids.
+        /// @param count Number of entities to create.
+        /// @param components Ids of the components of the new entities. Less than \ref RawQuery::MAX_COMPONENTS, as
+        /// the list passed to flecs is zero terminated.
+        /// @return Ids of the new entities. The span is only valid until the next bulk creation in this scene.
+        std::span<const EntityId> CreateEntitiesRaw(std::size_t count, std::span<const EntityId> components);
+
+        /// Add components to many entities at once.
+        /// @param entities Entities to add the components to.
+        /// @param components Ids of the components to add.
+        void AddComponentsRaw(std::span<const EntityId> entities, std::span<const EntityId> components);
+
+        /// Remove components from many entities at once.
+        /// @param entities Entities to remove the components from.
+        /// @param components Ids of the components to remove.
+        void RemoveComponentsRaw(std::span<const EntityId> entities, std::span<const EntityId> components);
+
         /// Get the component registered id by name
         /// @param name Component name
         /// @return The component id if it exists, std::nullopt otherwise
@@ -100,10 +382,43 @@ namespace Hush
         [[nodiscard]]
         EntityId RegisterComponentRaw(const ComponentTraits::ComponentInfo &desc) const;
 
+        /// Get the id of a C++ component in this scene, registering it if needed.
+        /// Once the component is registered, this is a single load from the scene component id table.
+        /// @tparam T Type of the component.
+        /// @return Id of the component.
+        template <typename T>
+        [[nodiscard]]
+        EntityId GetComponentId()
+        {
+            return GetCppComponentId(ComponentTraits::detail::GetTypeIndex<T>(),
+                                     &ComponentTraits::GetComponentInfo<std::remove_cvref_t<T>>);
+        }
+
+        /// Get the id of a C++ component from its type index, registering it if needed.
+        /// Non-template version of \ref GetComponentId, for code that cannot see the complete scene type.
+        /// @param typeIndex Type index of the component, see \ref ComponentTraits::detail::GetTypeIndex.
+        /// @param getInfo Function returning the description of the component, only called to register it.
+        /// @return Id of the component.
+        [[nodiscard]]
+        EntityId GetCppComponentId(const std::uint32_t &typeIndex, ComponentTraits::ComponentInfo (*getInfo)())
+        {
+            if (typeIndex < MAX_CPP_COMPONENTS) [[likely]]
+            {
+                const CppComponentSlot &slot = m_cppComponents[typeIndex];
+
+                if (slot.typeKey.load(std::memory_order_acquire) == &typeIndex) [[likely]]
+                {
+                    return slot.id.load(std::memory_order_relaxed);
+                }
+            }
+
+            return RegisterCppComponentSlow(typeIndex, getInfo());
+        }
+
         template <typename... Components>
         Query<Components...> CreateQuery(RawQuery::ECacheMode cacheMode = RawQuery::ECacheMode::Default)
         {
-            std::array<Entity::EntityId, sizeof...(Components)> components = {RegisterIfNeededSlow<Components>()...};
+            std::array<Entity::EntityId, sizeof...(Components)> components = {GetComponentId<Components>()...};
 
             auto rawQuery = CreateRawQuery(components, cacheMode);
 
@@ -113,25 +428,158 @@ namespace Hush
         RawQuery CreateRawQuery(std::span<Entity::EntityId> components,
                                 RawQuery::ECacheMode cacheMode = RawQuery::ECacheMode::Default);
 
+        /// Get a query from the scene query cache, creating it the first time it is requested.
+        /// Unlike \ref CreateQuery, the query is owned by the scene and is only compiled and matched once, so this is
+        /// the preferred way to get queries from systems that run every frame.
+        /// @tparam Components Components to query. Order matters, the same components in a different order is a
+        /// different query.
+        /// @param cacheMode Cache mode of the query.
+        /// @return Copyable handle to the cached query.
+        template <typename... Components>
+        QueryHandle<Components...> GetCachedQuery(RawQuery::ECacheMode cacheMode = RawQuery::ECacheMode::Default)
+        {
+            std::array<Entity::EntityId, sizeof...(Components)> components = {GetComponentId<Components>()...};
+
+            return QueryHandle<Components...>(this, FindOrCreateCachedQuery(components, cacheMode));
+        }
+
+        /// Get a raw query from the scene query cache, creating it the first time it is requested.
+        /// @param components Ids of the components of the query.
+        /// @param cacheMode Cache mode of the query.
+        /// @return Opaque pointer to the cached query. It is owned by the scene.
+        void *FindOrCreateCachedQuery(std::span<const Entity::EntityId> components,
+                                      RawQuery::ECacheMode cacheMode = RawQuery::ECacheMode::Default);
+
+        /// Get the statistics of the query cache.
+        /// @return Query cache statistics.
+        [[nodiscard]]
+        QueryCacheStats GetQueryCacheStats() const;
+
+        /// Get the statistics of the archetype storage of the scene. It walks every table, so it is meant for
+        /// debugging tools rather than for every frame.
+        /// @return Scene statistics.
+        [[nodiscard]]
+        SceneStats GetStats() const;
+
+        /// Find the entities whose \ref SpatialBounds intersect a sphere. The index is updated in PreRender.
+        /// @param center Center of the sphere.
+        /// @param radius Radius of the sphere.
+        /// @return Ids of the entities.
+        [[nodiscard]]
+        std::vector<EntityId> QuerySphere(const glm::vec3 &center, float radius) const;
+
+        /// Find the entities whose \ref SpatialBounds intersect a box. The index is updated in PreRender.
+        /// @param min Min corner of the box.
+        /// @param max Max corner of the box.
+        /// @return Ids of the entities.
+        [[nodiscard]]
+        std::vector<EntityId> QueryAABB(const glm::vec3 &min, const glm::vec3 &max) const;
+
+        /// Find the entities whose \ref SpatialBounds are hit by a ray. The index is updated in PreRender.
+        /// @param origin Origin of the ray.
+        /// @param direction Direction of the ray.
+        /// @param maxDistance Length of the ray.
+        /// @return Ids of the entities, sorted from the nearest hit to the farthest.
+        [[nodiscard]]
+        std::vector<EntityId> QueryRay(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance) const;
+
+        /// Get the spatial index of the scene, for batched queries or to update it outside of PreRender.
+        /// @return Spatial index.
+        [[nodiscard]]
+        SpatialIndexSystem &GetSpatialIndex() noexcept
+        {
+            return *m_spatialIndex;
+        }
+
     private:
         friend class Entity;
         friend class RawQuery;
         friend class impl::QueryImpl;
 
-        template <typename T>
+        /// Check if a query of this scene is being iterated. Structural changes that cannot be deferred are not
+        /// allowed meanwhile.
+        /// @return True if some query iterator has not finished.
         [[nodiscard]]
-        EntityId RegisterIfNeededSlow()
+        bool IsIterating() const noexcept
+        {
+            return m_activeIterators.load(std::memory_order_relaxed) > 0;
+        }
+
+        /// Slot of the C++ component id table.
+        struct CppComponentSlot
+        {
+            /// Address of the type index of the component type that filled this slot, nullptr if empty. It is
+            /// published after the id, so readers that see the key also see the id. Once set it never changes: types
+            /// of other binaries sharing the same index go through the slow path instead of taking the slot over.
+            std::atomic<const std::uint32_t *> typeKey = nullptr;
+
+            /// Id of the component. Atomic, as a reader holding a stale key might load it while it is being written.
+            std::atomic<EntityId> id = 0;
+        };
+
+        /// Command to apply, with the command buffer that recorded it.
+        struct PendingCommand
+        {
+            CommandBuffer *buffer;
+            const CommandBuffer::Command *command;
+
+            /// Set command followed by a removal of the same component, its value must not be written.
+            bool isRemovedLater = false;
+        };
+
+        /// Command buffer of a thread.
+        struct ThreadCommandBuffer
         {
-            // First, get the entity id, and check if the component is registered.
-            auto [status, componentId] = ComponentTraits::detail::GetEntityId<T>(this);
-            const ComponentTraits::ComponentInfo info = ComponentTraits::GetComponentInfo<T>();
+            std::thread::id threadId;
+
+            /// Order of the buffer when flushing, 0 for threads outside of the thread pool, and the worker index plus
+            /// one for the workers.
+            std::uint32_t threadOrder;
+
+            std::unique_ptr<CommandBuffer> buffer;
+        };
 
-            return InternalRegisterCppComponent(status, componentId, info);
+        /// Copy a value to a component of entities created by the same bulk creation.
+        /// @tparam T Type of the component.
+        /// @param entities Entities created by the same bulk creation.
+        /// @param value Value to copy.
+        template <typename T>
+        void FillComponent(std::span<const EntityId> entities, const T &value)
+        {
+            if (entities.empty())
+            {
+                return;
+            }
+
+            if constexpr (ComponentTraits::SparseComponent<T>)
+            {
+                // Sparse components have no column, their values are spread over the pages of the sparse set.
+                const EntityId componentId = GetComponentId<T>();
+                for (const EntityId entity : entities)
+                {
+                    *static_cast<T *>(GetComponentRaw(entity, componentId)) = value;
+                }
+            }
+            else
+            {
+                // Entities created together are stored in consecutive rows of the same table, so their components
+                // are contiguous in the column.
+                auto *column = static_cast<T *>(GetComponentRaw(entities.front(), GetComponentId<T>()));
+                std::fill_n(column, entities.size(), value);
+            }
         }
 
-        Entity::EntityId InternalRegisterCppComponent(ComponentTraits::detail::EEntityRegisterStatus registerStatus,
-                                                      std::uint64_t *id,
-                                                      const ComponentTraits::ComponentInfo &desc);
+        /// Get a component of an entity.
+        /// @param entity Id of the entity.
+        /// @param componentId Id of the component.
+        /// @return Pointer to the component, or nullptr if the entity does not have it.
+        void *GetComponentRaw(EntityId entity, EntityId componentId);
+
+        /// Register a C++ component in the scene and fill its slot in the component id table.
+        /// @param typeIndex Type index of the component. See \ref ComponentTraits::detail::GetTypeIndex.
+        /// @param desc Component description.
+        /// @return Id of the component.
+        EntityId RegisterCppComponentSlow(const std::uint32_t &typeIndex, const ComponentTraits::ComponentInfo &desc);
 
         [[nodiscard]]
         void *GetWorld() const
@@ -139,6 +587,12 @@ namespace Hush
             return m_world;
         }
 
+        /// Get the world to use for entity operations of the calling thread: its stage in a staged section, or the
+        /// world otherwise.
+        /// @return World or stage.
+        [[nodiscard]]
+        void *GetStage() const;
+
         /// Add an engine system to the scene
         /// @param system System to add
         void AddEngineSystem(ISystem *system);
@@ -146,6 +600,22 @@ namespace Hush
         /// Sort the systems based on their order and store them in the buckets
         void SortSystems();
 
+        /// Entry of the query cache.
+        struct CachedQuery
+        {
+            /// Component ids of the query, in the order they were requested.
+            std::vector<Entity::EntityId> terms;
+            RawQuery::ECacheMode cacheMode;
+            void *query;
+        };
+
+        /// Hash a query signature.
+        /// @param components Ids of the components of the query.
+        /// @param cacheMode Cache mode of the query.
+        /// @return Hash of the signature.
+        static std::uint64_t HashQuerySignature(std::span<const Entity::EntityId> components,
+                                                RawQuery::ECacheMode cacheMode);
+
         /// Ordered array of systems
         /// This is not the most efficient way to store the systems btw.
         std::array<std::vector<ISystem *>, ORDER_BUCKET_SIZE> m_systems;
@@ -154,7 +624,25 @@ namespace Hush
         std::unordered_map<std::string, Entity::EntityId> m_registeredEntities;
 
         /// Mutex to protect the registered entities
-        std::shared_mutex m_registeredEntitiesMutex;
+        mutable std::shared_mutex m_registeredEntitiesMutex;
+
+        /// C++ component ids, indexed by type index.
+        std::array<CppComponentSlot, MAX_CPP_COMPONENTS> m_cppComponents;
+
+        /// Mutex to serialize the registration of C++ components
+        std::mutex m_cppComponentsMutex;
+
+        /// Query cache, keyed by the hash of the query signature. Collisions are resolved by comparing the terms.
+        std::unordered_map<std::uint64_t, std::vector<CachedQuery>> m_queryCache;
+
+        /// Mutex to protect the query cache
+        mutable std::shared_mutex m_queryCacheMutex;
+
+        /// Number of query cache hits
+        std::atomic<std::uint64_t> m_queryCacheHits = 0;
+
+        /// Number of query cache misses
+        std::atomic<std::uint64_t> m_queryCacheMisses = 0;
 
         /// Special vector to store the systems that come from the engine.
         std::vector<ISystem *> m_engineSystems;
@@ -162,8 +650,50 @@ namespace Hush
         /// User systems
         std::vector<std::unique_ptr<ISystem>> m_userSystems;
 
+        /// Command buffers of the threads that recorded commands in this scene, sorted by thread order
+        std::vector<ThreadCommandBuffer> m_commandBuffers;
+
+        /// Mutex to protect the command buffers
+        std::mutex m_commandBuffersMutex;
+
+        /// Scratch storage to sort the commands when flushing the command buffers
+        std::vector<PendingCommand> m_pendingCommands;
+
+        /// Propagates the transform hierarchy, see \ref TransformSystem
+        std::unique_ptr<TransformSystem> m_transformSystem;
+
+        /// Keeps the bounds of the entities in a grid, see \ref SpatialIndexSystem
+        std::unique_ptr<SpatialIndexSystem> m_spatialIndex;
+
+        Threading::ThreadPool *m_threadPool = nullptr;
+
+        /// Time spent in batched structural changes in nanoseconds, see \ref SceneStats. Bulk operations can run in
+        /// any thread.
+        std::atomic<std::chrono::nanoseconds::rep> m_structuralChangeTime = 0;
+
+        /// See \ref SetInterpolationAlpha
+        float m_interpolationAlpha = 0.0f;
+
+        /// Whether the scene is in a staged section, see \ref BeginStaged
+        bool m_isStaged = false;
+
+        /// Number of query iterators that have not finished, see \ref IsIterating
+        std::atomic<std::uint32_t> m_activeIterators = 0;
+
+        /// Thread that began the staged section, it uses the first stage
+        std::thread::id m_stagingThread;
+
+        /// Unique id of the scene, used by per-thread caches that must not confuse scenes created at the same address
+        std::uint64_t m_sceneId;
+
         HushEngine *m_engine;
 
         void *m_world;
     };
+
+    template <typename T>
+    CommandBuffer::EntityId CommandBuffer::GetComponentId() const
+    {
+        return m_scene->GetComponentId<T>();
+    }
 } // namespace Hush
\ No newline at end of file
@@ -0,0 +1,102 @@
+/*! \file SceneGroup.cpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Group of independent scenes simulated concurrently
+*/
+
+#include "SceneGroup.hpp"
+#include "Scene.hpp"
+
+#include "Assertions.hpp"
+
+#include <ThreadPool.hpp>
+
+#include <algorithm>
+
+Hush::SceneGroup::SceneGroup(HushEngine *engine, Threading::ThreadPool *threadPool) noexcept
+    : m_engine(engine),
+      m_threadPool(threadPool)
+{
+}
+
+Hush::SceneGroup::~SceneGroup() = default;
+
+Hush::Scene &Hush::SceneGroup::CreateScene()
+{
+    return *m_scenes.emplace_back(std::make_unique<Scene>(m_engine));
+}
+
+void Hush::SceneGroup::DestroyScene(Scene &scene)
+{
+    const auto it = std::ranges::find_if(m_scenes, [&scene](const auto &owned) { return owned.get() == &scene; });
+    HUSH_ASSERT(it != m_scenes.end(), "Scene does not belong to this group");
+
+    m_scenes.erase(it);
+}
+
+Hush::Scene &Hush::SceneGroup::GetScene(std::size_t index) const noexcept
+{
+    HUSH_ASSERT(index < m_scenes.size(), "Scene index {} out of range", index);
+    return *m_scenes[index];
+}
+
+void Hush::SceneGroup::Init()
+{
+    RunPhase([](Scene &scene, float) { scene.Init(); }, 0.0f);
+}
+
+void Hush::SceneGroup::Update(float delta)
+{
+    RunPhase([](Scene &scene, float delta) { scene.Update(delta); }, delta);
+}
+
+void Hush::SceneGroup::FixedUpdate(float delta)
+{
+    RunPhase([](Scene &scene, float delta) { scene.FixedUpdate(delta); }, delta);
+}
+
+void Hush::SceneGroup::PreRender()
+{
+    RunPhase([](Scene &scene, float) { scene.PreRender(); }, 0.0f);
+}
+
+void Hush::SceneGroup::Render()
+{
+    RunPhase([](Scene &scene, float) { scene.Render(); }, 0.0f);
+}
+
+void Hush::SceneGroup::PostRender()
+{
+    RunPhase([](Scene &scene, float) { scene.PostRender(); }, 0.0f);
+}
+
+void Hush::SceneGroup::Shutdown()
+{
+    RunPhase([](Scene &scene, float) { scene.Shutdown(); }, 0.0f);
+}
+
+void Hush::SceneGroup::RunPhase(PhaseFunction phase, float delta)
+{
+    m_nextScene.store(0, std::memory_order_relaxed);
+
+    // Every participant picks scenes until there are none left.
+    const auto runScenes = [this, phase, delta]() {
+        for (std::size_t index = m_nextScene.fetch_add(1, std::memory_order_relaxed); index < m_scenes.size();
+             index = m_nextScene.fetch_add(1, std::memory_order_relaxed))
+        {
+            phase(*m_scenes[index], delta);
+        }
+    };
+
+    if (m_threadPool == nullptr || m_scenes.size() < 2)
+    {
+        runScenes();
+        return;
+    }
+
+    // One participant per scene at most, more would only idle. Scenes are picked dynamically, so the participants are
+    // the elements of the parallel loop, not the scenes.
+    const std::size_t numParticipants = std::min<std::size_t>(m_threadPool->GetNumThreads() + 1, m_scenes.size());
+
+    m_threadPool->ParallelFor(numParticipants, 1, [&runScenes](std::size_t, std::size_t) { runScenes(); });
+}
@@ -0,0 +1,102 @@
+/*! \file SceneGroup.hpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Group of independent scenes simulated concurrently
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Hush
+{
+    class HushEngine;
+    class Scene;
+
+    namespace Threading
+    {
+        class ThreadPool;
+    }
+
+    /// Owns many independent scenes (i.e. the match instances of a server) and runs each phase of all of them
+    /// concurrently in a thread pool. Scenes are handed to the workers one at a time, so small and big scenes balance
+    /// out.
+    ///
+    /// Scenes share nothing but the thread pool: each one has its own world and component ids. The systems of a scene
+    /// run in the thread that picked the scene. Scenes may share the group's thread pool (see
+    /// \ref Hush::Scene::SetThreadPool): parallel loops started from a worker run inline, see
+    /// \ref Hush::Threading::ThreadPool::ParallelFor.
+    class SceneGroup
+    {
+    public:
+        /// Constructor.
+        /// @param engine Engine passed to the scenes of the group.
+        /// @param threadPool Thread pool to run the scenes in, or nullptr to run them one after the other.
+        SceneGroup(HushEngine *engine, Threading::ThreadPool *threadPool) noexcept;
+
+        SceneGroup(const SceneGroup &) = delete;
+        SceneGroup &operator=(const SceneGroup &) = delete;
+
+        ~SceneGroup();
+
+        /// Create a scene in the group.
+        /// @return New scene. It lives until it is destroyed or the group is destroyed.
+        Scene &CreateScene();
+
+        /// Destroy a scene of the group. Must not be called while the group is running a phase.
+        /// @param scene Scene to destroy.
+        void DestroyScene(Scene &scene);
+
+        /// @return Number of scenes of the group.
+        [[nodiscard]]
+        std::size_t GetSceneCount() const noexcept
+        {
+            return m_scenes.size();
+        }
+
+        /// Get a scene of the group.
+        /// @param index Index of the scene, in creation order. Destroying a scene shifts the ones after it.
+        /// @return Scene.
+        [[nodiscard]]
+        Scene &GetScene(std::size_t index) const noexcept;
+
+        /// Call \ref Hush::Scene::Init on every scene.
+        void Init();
+
+        /// Call \ref Hush::Scene::Update on every scene.
+        void Update(float delta);
+
+        /// Call \ref Hush::Scene::FixedUpdate on every scene.
+        void FixedUpdate(float delta);
+
+        /// Call \ref Hush::Scene::PreRender on every scene.
+        void PreRender();
+
+        /// Call \ref Hush::Scene::Render on every scene.
+        void Render();
+
+        /// Call \ref Hush::Scene::PostRender on every scene.
+        void PostRender();
+
+        /// Call \ref Hush::Scene::Shutdown on every scene.
+        void Shutdown();
+
+    private:
+        using PhaseFunction = void (*)(Scene &scene, float delta);
+
+        /// Run a phase on every scene, and wait until all of them are done.
+        /// @param phase Function that runs the phase on a scene.
+        /// @param delta Delta passed to the phase.
+        void RunPhase(PhaseFunction phase, float delta);
+
+        HushEngine *m_engine;
+        Threading::ThreadPool *m_threadPool;
+        std::vector<std::unique_ptr<Scene>> m_scenes;
+
+        /// Index of the next scene to pick in the current phase.
+        std::atomic<std::size_t> m_nextScene = 0;
+    };
+} // namespace Hush
@@ -0,0 +1,575 @@
+/*! \file SceneSnapshot.cpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Binary scene snapshots
+*/
+
+#include "SceneSnapshot.hpp"
+#include "Scene.hpp"
+
+#include <Logger.hpp>
+#include <MappedFile.hpp>
+
+#define FLECS_NO_CPP
+#include <flecs.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+    using EntityId = Hush::Entity::EntityId;
+
+    constexpr std::array<char, 4> SNAPSHOT_MAGIC = {'H', 'S', 'C', 'N'};
+    constexpr std::uint32_t SNAPSHOT_VERSION = 1;
+
+    /// Alignment of the columns in the file. Mappings start at a page boundary, so the columns are aligned in memory.
+    constexpr std::uint64_t COLUMN_ALIGNMENT = 64;
+
+    constexpr std::uint32_t NO_PARENT = std::numeric_limits<std::uint32_t>::max();
+
+    /// Maximum number of ids of a bulk creation.
+    constexpr std::size_t MAX_TABLE_IDS = 32;
+
+    // File layout: header, components, tables, columns, component names, and the column data.
+
+    struct SnapshotHeader
+    {
+        std::array<char, 4> magic;
+        std::uint32_t version;
+        std::uint32_t numComponents;
+        std::uint32_t numTables;
+        std::uint32_t numColumns;
+        std::uint32_t namesSize;
+        std::uint64_t numEntities;
+    };
+
+    struct SnapshotComponent
+    {
+        std::uint32_t nameOffset;
+        std::uint32_t nameSize;
+        std::uint32_t size;
+        std::uint32_t alignment;
+    };
+
+    /// Tables are sorted by depth in the ChildOf hierarchy, so parents are always loaded before their children.
+    struct SnapshotTable
+    {
+        std::uint32_t numEntities;
+        std::uint32_t numColumns;
+        std::uint32_t firstColumn;
+        std::uint32_t parentTable;
+        std::uint32_t parentRow;
+        std::uint32_t reserved;
+    };
+
+    /// Column of a table. Tags have no data, their offset is 0.
+    struct SnapshotColumn
+    {
+        std::uint32_t component;
+        std::uint32_t reserved;
+        std::uint64_t offset;
+    };
+
+    static_assert(sizeof(SnapshotHeader) % 8 == 0 && sizeof(SnapshotComponent) % 8 == 0 &&
+                  sizeof(SnapshotTable) % 8 == 0 && sizeof(SnapshotColumn) % 8 == 0);
+
+    /// Table of the scene that is saved.
+    struct TableLayout
+    {
+        ecs_table_t *table;
+        std::uint32_t numEntities;
+
+        /// Index of the component in the snapshot registry, and id of the component in the scene.
+        std::vector<std::pair<std::uint32_t, EntityId>> columns;
+
+        EntityId parent = 0;
+        std::uint32_t parentTable = NO_PARENT;
+        std::uint32_t parentRow = 0;
+    };
+
+    constexpr std::uint64_t AlignUp(std::uint64_t value, std::uint64_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    /// Check if the values of a component can be saved as raw bytes.
+    bool IsPlainData(const ecs_type_info_t &typeInfo)
+    {
+        return typeInfo.hooks.copy == nullptr && typeInfo.hooks.move == nullptr && typeInfo.hooks.dtor == nullptr &&
+               (typeInfo.hooks.flags & ECS_TYPE_HOOK_COPY_ILLEGAL) == 0;
+    }
+
+    template <typename T>
+    void WriteArray(std::ofstream &file, std::span<const T> values)
+    {
+        file.write(reinterpret_cast<const char *>(values.data()), static_cast<std::streamsize>(values.size_bytes()));
+    }
+
+    void WritePadding(std::ofstream &file, std::uint64_t &position, std::uint64_t target)
+    {
+        static constexpr std::array<char, COLUMN_ALIGNMENT> ZEROES{};
+
+        file.write(ZEROES.data(), static_cast<std::streamsize>(target - position));
+        position = target;
+    }
+
+    /// Get a span of records of the file, checking that it is in bounds.
+    template <typename T>
+    std::optional<std::span<const T>> GetRecords(std::span<const std::byte> data, std::uint64_t offset,
+                                                 std::uint64_t count)
+    {
+        if (offset > data.size() || count > (data.size() - offset) / sizeof(T))
+        {
+            return std::nullopt;
+        }
+
+        return std::span<const T>(reinterpret_cast<const T *>(data.data() + offset), count);
+    }
+} // namespace
+
+Hush::Result<void, Hush::SceneSnapshot::EError> Hush::SceneSnapshot::Save(Scene &scene,
+                                                                       const std::filesystem::path &path)
+{
+    auto *world = static_cast<ecs_world_t *>(scene.GetWorld());
+
+    // Only components registered by name can be found again when loading.
+    std::shared_lock lock(scene.m_registeredEntitiesMutex);
+    std::unordered_map<EntityId, std::string_view> componentNames;
+
+    for (const auto &[name, id] : scene.m_registeredEntities)
+    {
+        componentNames.emplace(id, name);
+    }
+
+    std::vector<SnapshotComponent> components;
+    std::unordered_map<EntityId, std::uint32_t> componentIndices;
+    std::unordered_set<EntityId> skippedComponents;
+    std::string names;
+    std::vector<TableLayout> tables;
+
+    ecs_query_desc_t queryDesc = {};
+    queryDesc.terms[0].id = EcsAny;
+    queryDesc.cache_kind = EcsQueryCacheNone;
+    ecs_query_t *query = ecs_query_init(world, &queryDesc);
+
+    ecs_iter_t it = ecs_query_iter(world, query);
+    while (ecs_query_next(&it))
+    {
+        TableLayout layout{.table = it.table, .numEntities = static_cast<std::uint32_t>(it.count)};
+        const ecs_type_t *type = ecs_table_get_type(it.table);
+
+        for (std::int32_t i = 0; i < type->count; ++i)
+        {
+            const ecs_id_t id = type->array[i];
+
+            if (ecs_id_is_pair(id))
+            {
+                if (ECS_PAIR_FIRST(id) == static_cast<std::uint32_t>(EcsChildOf))
+                {
+                    layout.parent = ecs_pair_second(world, id);
+                }
+                continue;
+            }
+
+            const auto nameIt = componentNames.find(id);
+            if (nameIt == componentNames.end())
+            {
+                continue;
+            }
+
+            const ecs_type_info_t *typeInfo = ecs_get_type_info(world, id);
+            if (ecs_has_id(world, id, EcsSparse))
+            {
+                if (skippedComponents.insert(id).second)
+                {
+                    LogFormat(ELogLevel::Warn, "Component {} has sparse storage, it is not saved in snapshots",
+                              nameIt->second);
+                }
+                continue;
+            }
+
+            if (typeInfo != nullptr && !IsPlainData(*typeInfo))
+            {
+                if (skippedComponents.insert(id).second)
+                {
+                    LogFormat(ELogLevel::Warn, "Component {} is not trivially copyable, it is not saved in snapshots",
+                              nameIt->second);
+                }
+                continue;
+            }
+
+            auto [indexIt, isNew] = componentIndices.try_emplace(id, static_cast<std::uint32_t>(components.size()));
+            if (isNew)
+            {
+                components.push_back(SnapshotComponent{
+                    .nameOffset = static_cast<std::uint32_t>(names.size()),
+                    .nameSize = static_cast<std::uint32_t>(nameIt->second.size()),
+                    .size = typeInfo != nullptr ? static_cast<std::uint32_t>(typeInfo->size) : 0,
+                    .alignment = typeInfo != nullptr ? static_cast<std::uint32_t>(typeInfo->alignment) : 0,
+                });
+                names += nameIt->second;
+            }
+
+            layout.columns.emplace_back(indexIt->second, id);
+        }
+
+        if (layout.columns.empty())
+        {
+            continue;
+        }
+
+        if (layout.columns.size() >= MAX_TABLE_IDS)
+        {
+            LogFormat(ELogLevel::Warn, "Table with {} components cannot be saved in snapshots, max is {}",
+                      layout.columns.size(), MAX_TABLE_IDS - 1);
+            continue;
+        }
+
+        tables.push_back(std::move(layout));
+    }
+
+    ecs_query_fini(query);
+
+    // Locate the parents. Entities whose parent is not saved become roots.
+    std::unordered_map<const ecs_table_t *, std::uint32_t> tableIndices;
+    for (std::size_t i = 0; i < tables.size(); ++i)
+    {
+        tableIndices.emplace(tables[i].table, static_cast<std::uint32_t>(i));
+    }
+
+    for (TableLayout &layout : tables)
+    {
+        if (layout.parent == 0)
+        {
+            continue;
+        }
+
+        const ecs_record_t *record = ecs_record_find(world, layout.parent);
+        const auto tableIt = record != nullptr ? tableIndices.find(record->table) : tableIndices.end();
+
+        if (tableIt != tableIndices.end())
+        {
+            layout.parentTable = tableIt->second;
+            layout.parentRow = static_cast<std::uint32_t>(ECS_RECORD_TO_ROW(record->row));
+        }
+    }
+
+    // Sort the tables by depth, so parents are created before their children.
+    std::vector<std::uint32_t> depths(tables.size(), NO_PARENT);
+    const auto getDepth = [&tables, &depths](auto &self, std::uint32_t index) -> std::uint32_t {
+        if (depths[index] == NO_PARENT)
+        {
+            const std::uint32_t parentTable = tables[index].parentTable;
+            depths[index] = parentTable == NO_PARENT ? 0 : self(self, parentTable) + 1;
+        }
+        return depths[index];
+    };
+
+    std::vector<std::uint32_t> order(tables.size());
+    std::iota(order.begin(), order.end(), 0);
+    for (std::uint32_t index : order)
+    {
+        (void)getDepth(getDepth, index);
+    }
+    std::ranges::stable_sort(order, {}, [&depths](std::uint32_t index) { return depths[index]; });
+
+    std::vector<std::uint32_t> sortedIndices(tables.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+        sortedIndices[order[i]] = static_cast<std::uint32_t>(i);
+    }
+
+    // Lay out the file.
+    std::vector<SnapshotTable> fileTables;
+    std::vector<SnapshotColumn> fileColumns;
+    fileTables.reserve(tables.size());
+
+    std::size_t numColumns = 0;
+    for (const TableLayout &layout : tables)
+    {
+        numColumns += layout.columns.size();
+    }
+
+    SnapshotHeader header{
+        .magic = SNAPSHOT_MAGIC,
+        .version = SNAPSHOT_VERSION,
+        .numComponents = static_cast<std::uint32_t>(components.size()),
+        .numTables = static_cast<std::uint32_t>(tables.size()),
+        .numColumns = static_cast<std::uint32_t>(numColumns),
+        .namesSize = static_cast<std::uint32_t>(names.size()),
+        .numEntities = 0,
+    };
+
+    const std::uint64_t metadataSize = sizeof(SnapshotHeader) + components.size() * sizeof(SnapshotComponent) +
+                                       tables.size() * sizeof(SnapshotTable) +
+                                       numColumns * sizeof(SnapshotColumn) + names.size();
+    std::uint64_t dataOffset = AlignUp(metadataSize, COLUMN_ALIGNMENT);
+
+    for (std::uint32_t index : order)
+    {
+        const TableLayout &layout = tables[index];
+
+        fileTables.push_back(SnapshotTable{
+            .numEntities = layout.numEntities,
+            .numColumns = static_cast<std::uint32_t>(layout.columns.size()),
+            .firstColumn = static_cast<std::uint32_t>(fileColumns.size()),
+            .parentTable = layout.parentTable == NO_PARENT ? NO_PARENT : sortedIndices[layout.parentTable],
+            .parentRow = layout.parentRow,
+            .reserved = 0,
+        });
+        header.numEntities += layout.numEntities;
+
+        for (const auto &[componentIndex, componentId] : layout.columns)
+        {
+            const std::uint64_t columnSize = std::uint64_t{components[componentIndex].size} * layout.numEntities;
+
+            fileColumns.push_back(SnapshotColumn{
+                .component = componentIndex,
+                .reserved = 0,
+                .offset = columnSize > 0 ? dataOffset : 0,
+            });
+            dataOffset = AlignUp(dataOffset + columnSize, COLUMN_ALIGNMENT);
+        }
+    }
+
+    // Write it.
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        return EError::CannotOpenFile;
+    }
+
+    WriteArray(file, std::span<const SnapshotHeader>(&header, 1));
+    WriteArray(file, std::span<const SnapshotComponent>(components));
+    WriteArray(file, std::span<const SnapshotTable>(fileTables));
+    WriteArray(file, std::span<const SnapshotColumn>(fileColumns));
+    WriteArray(file, std::span<const char>(names));
+
+    std::uint64_t position = metadataSize;
+    std::size_t columnIndex = 0;
+
+    for (std::uint32_t index : order)
+    {
+        const TableLayout &layout = tables[index];
+
+        for (const auto &[componentIndex, componentId] : layout.columns)
+        {
+            const SnapshotColumn &column = fileColumns[columnIndex++];
+
+            if (column.offset == 0)
+            {
+                continue;
+            }
+
+            WritePadding(file, position, column.offset);
+
+            const auto *columnData = static_cast<const char *>(ecs_table_get_id(world, layout.table, componentId, 0));
+            const std::uint64_t columnSize = std::uint64_t{components[componentIndex].size} * layout.numEntities;
+
+            file.write(columnData, static_cast<std::streamsize>(columnSize));
+            position += columnSize;
+        }
+    }
+
+    if (!file)
+    {
+        return EError::CannotWriteFile;
+    }
+
+    return Success();
+}
+
+Hush::Result<void, Hush::SceneSnapshot::EError> Hush::SceneSnapshot::Load(Scene &scene,
+                                                                       const std::filesystem::path &path)
+{
+    auto mappedFile = MappedFile::Open(path);
+    if (mappedFile.has_error())
+    {
+        return EError::CannotOpenFile;
+    }
+
+    const std::span<const std::byte> data = mappedFile.value().GetData();
+
+    const auto headers = GetRecords<SnapshotHeader>(data, 0, 1);
+    if (!headers.has_value())
+    {
+        return EError::InvalidFormat;
+    }
+
+    const SnapshotHeader &header = headers->front();
+    if (header.magic != SNAPSHOT_MAGIC)
+    {
+        return EError::InvalidFormat;
+    }
+
+    if (header.version != SNAPSHOT_VERSION)
+    {
+        return EError::UnsupportedVersion;
+    }
+
+    std::uint64_t offset = sizeof(SnapshotHeader);
+    const auto components = GetRecords<SnapshotComponent>(data, offset, header.numComponents);
+    offset += std::uint64_t{header.numComponents} * sizeof(SnapshotComponent);
+    const auto tables = GetRecords<SnapshotTable>(data, offset, header.numTables);
+    offset += std::uint64_t{header.numTables} * sizeof(SnapshotTable);
+    const auto columns = GetRecords<SnapshotColumn>(data, offset, header.numColumns);
+    offset += std::uint64_t{header.numColumns} * sizeof(SnapshotColumn);
+    const auto names = GetRecords<char>(data, offset, header.namesSize);
+
+    if (!components.has_value() || !tables.has_value() || !columns.has_value() || !names.has_value())
+    {
+        return EError::InvalidFormat;
+    }
+
+    auto *world = static_cast<ecs_world_t *>(scene.GetWorld());
+
+    // Resolve the registry.
+    std::vector<EntityId> componentIds;
+    componentIds.reserve(components->size());
+
+    for (const SnapshotComponent &component : *components)
+    {
+        if (component.nameOffset > names->size() || component.nameSize > names->size() - component.nameOffset)
+        {
+            return EError::InvalidFormat;
+        }
+
+        const std::string_view name(names->data() + component.nameOffset, component.nameSize);
+
+        // Tags are saved without size nor alignment. Columns in the file are only aligned to COLUMN_ALIGNMENT, so the
+        // mapped data of components with a bigger alignment could not be used either.
+        const bool isTag = component.size == 0 && component.alignment == 0;
+        if (!isTag && (!std::has_single_bit(component.alignment) || component.alignment > COLUMN_ALIGNMENT))
+        {
+            LogFormat(ELogLevel::Error, "Component {} has an invalid alignment of {} in the snapshot", name,
+                      component.alignment);
+            return EError::InvalidFormat;
+        }
+
+        if (std::optional<EntityId> componentId = scene.GetRegisteredComponentId(name); componentId.has_value())
+        {
+            const ecs_type_info_t *typeInfo = ecs_get_type_info(world, *componentId);
+            const std::uint32_t size = typeInfo != nullptr ? static_cast<std::uint32_t>(typeInfo->size) : 0;
+
+            if (size != component.size)
+            {
+                LogFormat(ELogLevel::Error, "Component {} has size {} in the snapshot, but {} in the scene", name,
+                          component.size, size);
+                return EError::ComponentMismatch;
+            }
+
+            componentIds.push_back(*componentId);
+            continue;
+        }
+
+        const ComponentTraits::ComponentInfo info{
+            .size = component.size,
+            .alignment = component.alignment,
+            .name = name,
+            .ops = {},
+            .opsFlags = ComponentTraits::EComponentOpsFlags::None,
+            .userCtx = nullptr,
+            .userCtxFree = nullptr,
+        };
+
+        const EntityId componentId = scene.RegisterComponentRaw(info);
+        scene.RegisterComponentId(name, componentId);
+        componentIds.push_back(componentId);
+    }
+
+    // Only the ids of the parent tables are kept.
+    std::vector<bool> isParent(tables->size(), false);
+    for (std::size_t i = 0; i < tables->size(); ++i)
+    {
+        const std::uint32_t parentTable = (*tables)[i].parentTable;
+
+        if (parentTable != NO_PARENT)
+        {
+            if (parentTable >= i || (*tables)[i].parentRow >= (*tables)[parentTable].numEntities)
+            {
+                return EError::InvalidFormat;
+            }
+
+            isParent[parentTable] = true;
+        }
+    }
+
+    std::vector<std::vector<EntityId>> parentEntities(tables->size());
+
+    for (std::size_t i = 0; i < tables->size(); ++i)
+    {
+        const SnapshotTable &table = (*tables)[i];
+
+        if (table.numEntities == 0)
+        {
+            continue;
+        }
+
+        if (table.numColumns >= MAX_TABLE_IDS || table.firstColumn > columns->size() ||
+            table.numColumns > columns->size() - table.firstColumn)
+        {
+            return EError::InvalidFormat;
+        }
+
+        ecs_bulk_desc_t desc = {};
+        desc.count = static_cast<std::int32_t>(table.numEntities);
+        std::array<void *, MAX_TABLE_IDS> columnData{};
+
+        for (std::uint32_t c = 0; c < table.numColumns; ++c)
+        {
+            const SnapshotColumn &column = (*columns)[table.firstColumn + c];
+
+            if (column.component >= components->size())
+            {
+                return EError::InvalidFormat;
+            }
+
+            desc.ids[c] = componentIds[column.component];
+
+            const SnapshotComponent &component = (*components)[column.component];
+            if (component.size == 0)
+            {
+                continue;
+            }
+
+            const auto columnBytes = GetRecords<std::byte>(data, column.offset,
+                                                           std::uint64_t{component.size} * table.numEntities);
+            if (!columnBytes.has_value() || column.offset % COLUMN_ALIGNMENT != 0)
+            {
+                return EError::InvalidFormat;
+            }
+
+            // Flecs only reads from the column, with the copy hook of the component or memcpy.
+            columnData[c] = const_cast<std::byte *>(columnBytes->data());
+        }
+
+        if (table.parentTable != NO_PARENT)
+        {
+            desc.ids[table.numColumns] = ecs_pair(EcsChildOf, parentEntities[table.parentTable][table.parentRow]);
+        }
+
+        desc.data = columnData.data();
+
+        const ecs_entity_t *entities = ecs_bulk_init(world, &desc);
+
+        if (isParent[i])
+        {
+            parentEntities[i].assign(entities, entities + table.numEntities);
+        }
+    }
+
+    return Success();
+}
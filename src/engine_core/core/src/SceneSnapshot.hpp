@@ -0,0 +1,60 @@
+/*! \file SceneSnapshot.hpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Binary scene snapshots
+*/
+
+#pragma once
+
+#include <Result.hpp>
+
+#include <filesystem>
+
+namespace Hush
+{
+    class Scene;
+
+    /// Saves and loads the entities of a scene in a binary format that can be loaded without parsing.
+    ///
+    /// The file stores a registry of the saved components, keyed by their type name (see
+    /// \ref ComponentTraits::GetTypeName), followed by the archetype tables. Each table stores its components as
+    /// contiguous columns, aligned so they can be used in place once the file is mapped in memory. Loading maps the
+    /// file and creates every table with a single bulk operation that copies whole columns.
+    ///
+    /// Limitations:
+    /// - Only trivially copyable components and tags are saved. Other components, and components with sparse storage
+    ///   (see \ref ComponentTraits::EComponentFlags), are skipped with a warning.
+    /// - ChildOf is the only saved relationship. Entity ids stored inside components are not remapped.
+    /// - Entity names and prefabs are not saved.
+    /// - Files use the byte order and type layouts of the platform that wrote them.
+    class SceneSnapshot
+    {
+    public:
+        /// Snapshot error
+        enum class EError
+        {
+            CannotOpenFile,
+            CannotWriteFile,
+            InvalidFormat,
+            UnsupportedVersion,
+            ComponentMismatch,
+        };
+
+        /// Save the entities of a scene to a file.
+        /// @param scene Scene to save.
+        /// @param path Path of the file. It is overwritten if it exists.
+        /// @return Error, if any.
+        [[nodiscard]]
+        static Result<void, EError> Save(Scene &scene, const std::filesystem::path &path);
+
+        /// Load the entities of a snapshot into a scene. Existing entities of the scene are kept.
+        /// Components that are not registered in the scene are registered with the size and alignment stored in the
+        /// file, without hooks. Use the component (i.e. \ref Hush::Scene::GetComponentId) before loading to keep
+        /// its C++ hooks.
+        /// @param scene Scene to load the entities into.
+        /// @param path Path of the file.
+        /// @return Error, if any.
+        [[nodiscard]]
+        static Result<void, EError> Load(Scene &scene, const std::filesystem::path &path);
+    };
+} // namespace Hush
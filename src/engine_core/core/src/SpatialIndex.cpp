@@ -0,0 +1,551 @@
+/*! \file SpatialIndex.cpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Spatial index of the entities of a scene
+*/
+
+#include "SpatialIndex.hpp"
+#include "Assertions.hpp"
+#include "FrameAllocator.hpp"
+#include "Scene.hpp"
+#include "Transform.hpp"
+
+#include <ThreadPool.hpp>
+
+#define FLECS_NO_CPP
+#include <flecs.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace
+{
+    /// Cell coordinates are packed in 21 bits per axis.
+    constexpr std::int32_t CELL_COORD_BIAS = 1 << 20;
+    constexpr std::uint64_t CELL_COORD_MASK = (1ULL << 21) - 1;
+
+    std::uint64_t PackCell(std::int32_t x, std::int32_t y, std::int32_t z)
+    {
+        return (static_cast<std::uint64_t>(x + CELL_COORD_BIAS) & CELL_COORD_MASK) |
+               ((static_cast<std::uint64_t>(y + CELL_COORD_BIAS) & CELL_COORD_MASK) << 21) |
+               ((static_cast<std::uint64_t>(z + CELL_COORD_BIAS) & CELL_COORD_MASK) << 42);
+    }
+
+    bool Overlaps(const glm::vec3 &minA, const glm::vec3 &maxA, const glm::vec3 &minB, const glm::vec3 &maxB)
+    {
+        return minA.x <= maxB.x && maxA.x >= minB.x && minA.y <= maxB.y && maxA.y >= minB.y && minA.z <= maxB.z &&
+               maxA.z >= minB.z;
+    }
+
+    /// Intersect a ray with a box.
+    /// @return Distance to the hit, or a negative value if the ray misses the box.
+    float IntersectRay(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance, const glm::vec3 &min,
+                       const glm::vec3 &max)
+    {
+        float tMin = 0.0f;
+        float tMax = maxDistance;
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            if (std::abs(direction[axis]) < std::numeric_limits<float>::epsilon())
+            {
+                if (origin[axis] < min[axis] || origin[axis] > max[axis])
+                {
+                    return -1.0f;
+                }
+                continue;
+            }
+
+            const float inverseDirection = 1.0f / direction[axis];
+            float t1 = (min[axis] - origin[axis]) * inverseDirection;
+            float t2 = (max[axis] - origin[axis]) * inverseDirection;
+
+            if (t1 > t2)
+            {
+                std::swap(t1, t2);
+            }
+
+            tMin = std::max(tMin, t1);
+            tMax = std::min(tMax, t2);
+
+            if (tMin > tMax)
+            {
+                return -1.0f;
+            }
+        }
+
+        return tMin;
+    }
+} // namespace
+
+Hush::SpatialIndexSystem::SpatialIndexSystem(Scene &scene, float cellSize)
+    : ISystem(scene),
+      m_cellSize(cellSize),
+      m_inverseCellSize(1.0f / cellSize)
+{
+    HUSH_ASSERT(cellSize > 0.0f, "Cell size must be positive");
+
+    // Runs after the transform system, in the same bucket phase.
+    SetOrder(1);
+
+    auto *world = static_cast<ecs_world_t *>(scene.GetWorld());
+    const Entity::EntityId worldTransformId = scene.GetComponentId<WorldTransform>();
+    const Entity::EntityId boundsId = scene.GetComponentId<SpatialBounds>();
+
+    ecs_query_desc_t desc = {};
+    desc.terms[0].id = worldTransformId;
+    desc.terms[0].inout = EcsIn;
+    desc.terms[1].id = boundsId;
+    desc.terms[1].inout = EcsInOut;
+    desc.cache_kind = EcsQueryCacheAuto;
+
+    m_query = ecs_query_init(world, &desc);
+
+    // Entities that lose either component, or are destroyed, leave the index.
+    const std::array<Entity::EntityId, 2> observedIds = {worldTransformId, boundsId};
+    for (std::size_t i = 0; i < observedIds.size(); ++i)
+    {
+        ecs_observer_desc_t observerDesc = {};
+        observerDesc.query.terms[0].id = observedIds[i];
+        observerDesc.events[0] = EcsOnRemove;
+        observerDesc.callback = [](ecs_iter_t *it) { OnRemoveObserver(it); };
+        observerDesc.ctx = this;
+
+        m_observers[i] = ecs_observer_init(world, &observerDesc);
+    }
+}
+
+Hush::SpatialIndexSystem::~SpatialIndexSystem()
+{
+    auto *world = static_cast<ecs_world_t *>(GetScene().GetWorld());
+
+    for (const Entity::EntityId observer : m_observers)
+    {
+        ecs_delete(world, observer);
+    }
+
+    ecs_query_fini(static_cast<ecs_query_t *>(m_query));
+}
+
+void Hush::SpatialIndexSystem::Update()
+{
+    auto *world = static_cast<ecs_world_t *>(GetScene().GetWorld());
+    const std::uint64_t frame = GetScene().m_transformSystem->GetFrame();
+
+    ecs_iter_t it = ecs_query_iter(world, static_cast<ecs_query_t *>(m_query));
+    while (ecs_query_next(&it))
+    {
+        // Tables with no new entities and no writes to their transforms or bounds since the last update are skipped
+        // whole. Skipping also keeps them from being flagged as written by this query.
+        if (!ecs_iter_changed(&it))
+        {
+            ecs_iter_skip(&it);
+            continue;
+        }
+
+        const auto *worlds = ecs_field(&it, WorldTransform, 0);
+        auto *bounds = ecs_field(&it, SpatialBounds, 1);
+        bool hasWrittenBounds = false;
+
+        for (std::int32_t i = 0; i < it.count; ++i)
+        {
+            if (!bounds[i].isDirty && worlds[i].updatedFrame != frame)
+            {
+                continue;
+            }
+
+            if (bounds[i].isDirty)
+            {
+                bounds[i].isDirty = false;
+                hasWrittenBounds = true;
+            }
+
+            // World space box that contains the transformed local box.
+            const glm::mat4 &matrix = worlds[i].matrix;
+            const glm::vec3 &localCenter = bounds[i].center;
+            const glm::vec3 &localExtents = bounds[i].extents;
+            glm::vec3 center;
+            glm::vec3 extents;
+
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                center[axis] = matrix[0][axis] * localCenter.x + matrix[1][axis] * localCenter.y +
+                               matrix[2][axis] * localCenter.z + matrix[3][axis];
+                extents[axis] = std::abs(matrix[0][axis]) * localExtents.x +
+                                std::abs(matrix[1][axis]) * localExtents.y + std::abs(matrix[2][axis]) * localExtents.z;
+            }
+
+            auto [slotIt, isNew] = m_slots.try_emplace(it.entities[i], 0);
+
+            if (isNew)
+            {
+                std::uint32_t slot;
+                if (m_freeEntries.empty())
+                {
+                    slot = static_cast<std::uint32_t>(m_entries.size());
+                    m_entries.emplace_back();
+                }
+                else
+                {
+                    slot = m_freeEntries.back();
+                    m_freeEntries.pop_back();
+                }
+
+                m_entries[slot] = Entry{.entity = it.entities[i], .min = center - extents, .max = center + extents};
+                slotIt->second = slot;
+                Insert(slot);
+                continue;
+            }
+
+            Entry &entry = m_entries[slotIt->second];
+            entry.min = center - extents;
+            entry.max = center + extents;
+
+            // Most moves stay in the same cells.
+            if (GetCell(entry.min) == entry.minCell && GetCell(entry.max) == entry.maxCell)
+            {
+                continue;
+            }
+
+            Remove(slotIt->second);
+            Insert(slotIt->second);
+        }
+
+        // Only the bounds are written here, and only their dirty flag.
+        if (!hasWrittenBounds)
+        {
+            ecs_iter_skip(&it);
+        }
+    }
+}
+
+void Hush::SpatialIndexSystem::QuerySphere(const glm::vec3 &center, float radius, std::vector<EntityId> &result) const
+{
+    const glm::vec3 extents(radius);
+    const float radiusSquared = radius * radius;
+
+    ForEachCandidate(GetCell(center - extents), GetCell(center + extents), [&](const Entry &entry) {
+        float distanceSquared = 0.0f;
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            const float closest = std::clamp(center[axis], entry.min[axis], entry.max[axis]);
+            distanceSquared += (closest - center[axis]) * (closest - center[axis]);
+        }
+
+        if (distanceSquared <= radiusSquared)
+        {
+            result.push_back(entry.entity);
+        }
+    });
+}
+
+void Hush::SpatialIndexSystem::QueryAABB(const glm::vec3 &min, const glm::vec3 &max,
+                                         std::vector<EntityId> &result) const
+{
+    ForEachCandidate(GetCell(min), GetCell(max), [&](const Entry &entry) {
+        if (Overlaps(entry.min, entry.max, min, max))
+        {
+            result.push_back(entry.entity);
+        }
+    });
+}
+
+void Hush::SpatialIndexSystem::QueryRay(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance,
+                                        std::vector<EntityId> &result) const
+{
+    HUSH_ASSERT(std::isfinite(maxDistance), "Rays must have a finite length");
+
+    const float length = std::sqrt(glm::dot(direction, direction));
+    if (length == 0.0f)
+    {
+        return;
+    }
+
+    const glm::vec3 rayDirection = direction / length;
+
+    // Distance and entry of each hit. Entries spanning several cells are hit more than once.
+    std::pmr::vector<std::pair<float, std::uint32_t>> hits(GetFrameResource());
+
+    const auto testEntry = [&](std::uint32_t slot) {
+        const Entry &entry = m_entries[slot];
+        const float distance = IntersectRay(origin, rayDirection, maxDistance, entry.min, entry.max);
+
+        if (distance >= 0.0f)
+        {
+            hits.emplace_back(distance, slot);
+        }
+    };
+
+    // Walk the cells crossed by the ray, in order.
+    const CellCoord originCell = GetCell(origin);
+    const CellCoord lastCell = GetCell(origin + rayDirection * maxDistance);
+    std::array<std::int32_t, 3> cell = {originCell.x, originCell.y, originCell.z};
+    std::array<std::int32_t, 3> step{};
+    std::array<float, 3> tMax{};
+    std::array<float, 3> tDelta{};
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        if (rayDirection[axis] > 0.0f)
+        {
+            step[axis] = 1;
+            tMax[axis] = (static_cast<float>(cell[axis] + 1) * m_cellSize - origin[axis]) / rayDirection[axis];
+            tDelta[axis] = m_cellSize / rayDirection[axis];
+        }
+        else if (rayDirection[axis] < 0.0f)
+        {
+            step[axis] = -1;
+            tMax[axis] = (static_cast<float>(cell[axis]) * m_cellSize - origin[axis]) / rayDirection[axis];
+            tDelta[axis] = -m_cellSize / rayDirection[axis];
+        }
+        else
+        {
+            tMax[axis] = std::numeric_limits<float>::infinity();
+            tDelta[axis] = std::numeric_limits<float>::infinity();
+        }
+    }
+
+    while (true)
+    {
+        if (const auto cellIt = m_cells.find(PackCell(cell[0], cell[1], cell[2])); cellIt != m_cells.end())
+        {
+            std::ranges::for_each(cellIt->second.entries, testEntry);
+        }
+
+        if (CellCoord{cell[0], cell[1], cell[2]} == lastCell)
+        {
+            break;
+        }
+
+        const auto axis = static_cast<std::size_t>(std::ranges::min_element(tMax) - tMax.begin());
+        if (tMax[axis] > maxDistance)
+        {
+            break;
+        }
+
+        cell[axis] += step[axis];
+        tMax[axis] += tDelta[axis];
+    }
+
+    std::ranges::for_each(m_largeEntries, testEntry);
+
+    // Keep the nearest hit of each entry, then sort by distance.
+    std::ranges::sort(hits, [](const auto &a, const auto &b) {
+        return a.second != b.second ? a.second < b.second : a.first < b.first;
+    });
+    const auto duplicates = std::ranges::unique(hits, {}, &std::pair<float, std::uint32_t>::second);
+    hits.erase(duplicates.begin(), duplicates.end());
+    std::ranges::sort(hits, {}, &std::pair<float, std::uint32_t>::first);
+
+    for (const auto &[distance, slot] : hits)
+    {
+        result.push_back(m_entries[slot].entity);
+    }
+}
+
+void Hush::SpatialIndexSystem::QueryBatch(std::span<const SpatialQuery> queries,
+                                          std::span<std::vector<EntityId>> results) const
+{
+    HUSH_ASSERT(results.size() >= queries.size(), "Batch has {} queries but only {} results", queries.size(),
+                results.size());
+
+    const auto runRange = [this, queries, results](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i)
+        {
+            results[i].clear();
+            RunQuery(queries[i], results[i]);
+        }
+    };
+
+    Threading::ThreadPool *threadPool = GetScene().GetThreadPool();
+
+    if (threadPool == nullptr)
+    {
+        runRange(0, queries.size());
+        return;
+    }
+
+    threadPool->ParallelFor(queries.size(), PARALLEL_THRESHOLD, runRange);
+}
+
+void Hush::SpatialIndexSystem::OnRemoveObserver(void *iterator)
+{
+    const auto *it = static_cast<ecs_iter_t *>(iterator);
+    auto *system = static_cast<SpatialIndexSystem *>(it->ctx);
+
+    for (std::int32_t i = 0; i < it->count; ++i)
+    {
+        system->RemoveEntity(it->entities[i]);
+    }
+}
+
+void Hush::SpatialIndexSystem::RunQuery(const SpatialQuery &query, std::vector<EntityId> &result) const
+{
+    switch (query.type)
+    {
+    case SpatialQuery::EType::Sphere:
+        QuerySphere(query.first, query.range, result);
+        break;
+    case SpatialQuery::EType::AABB:
+        QueryAABB(query.first, query.second, result);
+        break;
+    case SpatialQuery::EType::Ray:
+        QueryRay(query.first, query.second, query.range, result);
+        break;
+    }
+}
+
+template <typename Fn>
+void Hush::SpatialIndexSystem::ForEachCandidate(const CellCoord &minCell, const CellCoord &maxCell,
+                                                Fn &&function) const
+{
+    // Entries spanning several cells are only reported from the first cell they share with the query.
+    const auto visitCell = [&](const Cell &cell) {
+        for (const std::uint32_t slot : cell.entries)
+        {
+            const Entry &entry = m_entries[slot];
+            const CellCoord firstShared = {std::max(entry.minCell.x, minCell.x), std::max(entry.minCell.y, minCell.y),
+                                           std::max(entry.minCell.z, minCell.z)};
+
+            if (firstShared == cell.coord)
+            {
+                function(entry);
+            }
+        }
+    };
+
+    const std::uint64_t numQueryCells = static_cast<std::uint64_t>(maxCell.x - minCell.x + 1) *
+                                        static_cast<std::uint64_t>(maxCell.y - minCell.y + 1) *
+                                        static_cast<std::uint64_t>(maxCell.z - minCell.z + 1);
+
+    // Big queries are cheaper to answer by walking the cells in use.
+    if (numQueryCells > m_cells.size())
+    {
+        for (const auto &[key, cell] : m_cells)
+        {
+            const CellCoord &coord = cell.coord;
+
+            if (coord.x >= minCell.x && coord.x <= maxCell.x && coord.y >= minCell.y && coord.y <= maxCell.y &&
+                coord.z >= minCell.z && coord.z <= maxCell.z)
+            {
+                visitCell(cell);
+            }
+        }
+    }
+    else
+    {
+        for (std::int32_t z = minCell.z; z <= maxCell.z; ++z)
+        {
+            for (std::int32_t y = minCell.y; y <= maxCell.y; ++y)
+            {
+                for (std::int32_t x = minCell.x; x <= maxCell.x; ++x)
+                {
+                    if (const auto cellIt = m_cells.find(PackCell(x, y, z)); cellIt != m_cells.end())
+                    {
+                        visitCell(cellIt->second);
+                    }
+                }
+            }
+        }
+    }
+
+    for (const std::uint32_t slot : m_largeEntries)
+    {
+        function(m_entries[slot]);
+    }
+}
+
+Hush::SpatialIndexSystem::CellCoord Hush::SpatialIndexSystem::GetCell(const glm::vec3 &position) const noexcept
+{
+    constexpr auto limit = static_cast<float>(CELL_COORD_BIAS - 1);
+
+    const auto toCell = [this, limit](float value) {
+        return static_cast<std::int32_t>(std::clamp(std::floor(value * m_inverseCellSize), -limit, limit));
+    };
+
+    return CellCoord{toCell(position.x), toCell(position.y), toCell(position.z)};
+}
+
+void Hush::SpatialIndexSystem::Insert(std::uint32_t slot)
+{
+    Entry &entry = m_entries[slot];
+    entry.minCell = GetCell(entry.min);
+    entry.maxCell = GetCell(entry.max);
+
+    const std::uint64_t numCells = static_cast<std::uint64_t>(entry.maxCell.x - entry.minCell.x + 1) *
+                                   static_cast<std::uint64_t>(entry.maxCell.y - entry.minCell.y + 1) *
+                                   static_cast<std::uint64_t>(entry.maxCell.z - entry.minCell.z + 1);
+
+    entry.isLarge = numCells > MAX_CELLS_PER_ENTITY;
+
+    if (entry.isLarge)
+    {
+        m_largeEntries.push_back(slot);
+        return;
+    }
+
+    for (std::int32_t z = entry.minCell.z; z <= entry.maxCell.z; ++z)
+    {
+        for (std::int32_t y = entry.minCell.y; y <= entry.maxCell.y; ++y)
+        {
+            for (std::int32_t x = entry.minCell.x; x <= entry.maxCell.x; ++x)
+            {
+                Cell &cell = m_cells[PackCell(x, y, z)];
+                cell.coord = CellCoord{x, y, z};
+                cell.entries.push_back(slot);
+            }
+        }
+    }
+}
+
+void Hush::SpatialIndexSystem::Remove(std::uint32_t slot)
+{
+    const auto removeFrom = [slot](std::vector<std::uint32_t> &entries) {
+        const auto it = std::ranges::find(entries, slot);
+        HUSH_ASSERT(it != entries.end(), "Entry is not in the index");
+
+        *it = entries.back();
+        entries.pop_back();
+    };
+
+    const Entry &entry = m_entries[slot];
+
+    if (entry.isLarge)
+    {
+        removeFrom(m_largeEntries);
+        return;
+    }
+
+    for (std::int32_t z = entry.minCell.z; z <= entry.maxCell.z; ++z)
+    {
+        for (std::int32_t y = entry.minCell.y; y <= entry.maxCell.y; ++y)
+        {
+            for (std::int32_t x = entry.minCell.x; x <= entry.maxCell.x; ++x)
+            {
+                const auto cellIt = m_cells.find(PackCell(x, y, z));
+                removeFrom(cellIt->second.entries);
+
+                if (cellIt->second.entries.empty())
+                {
+                    m_cells.erase(cellIt);
+                }
+            }
+        }
+    }
+}
+
+void Hush::SpatialIndexSystem::RemoveEntity(EntityId entity)
+{
+    const auto slotIt = m_slots.find(entity);
+    if (slotIt == m_slots.end())
+    {
+        return;
+    }
+
+    Remove(slotIt->second);
+    m_freeEntries.push_back(slotIt->second);
+    m_slots.erase(slotIt);
+}
@@ -0,0 +1,238 @@
+/*! \file SpatialIndex.hpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Spatial index of the entities of a scene
+*/
+
+#pragma once
+
+#include "Entity.hpp"
+#include "ISystem.hpp"
+
+#include <glm/vec3.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Hush
+{
+    /// Axis aligned bounds of an entity, relative to its \ref Hush::WorldTransform. Entities with both components
+    /// are kept in the spatial index of their scene, see \ref Hush::SpatialIndexSystem.
+    struct SpatialBounds
+    {
+        glm::vec3 center{0.0f};
+        glm::vec3 extents{0.5f};
+
+        /// Set it after changing the bounds, so the index picks the change up. Moving the entity does not need it.
+        bool isDirty = true;
+    };
+
+    /// Query of a batch, see \ref Hush::SpatialIndexSystem::QueryBatch.
+    struct SpatialQuery
+    {
+        enum class EType
+        {
+            Sphere,
+            AABB,
+            Ray,
+        };
+
+        EType type;
+
+        /// Center of the sphere, min corner of the box, or origin of the ray.
+        glm::vec3 first;
+
+        /// Max corner of the box, or direction of the ray. Unused for spheres.
+        glm::vec3 second;
+
+        /// Radius of the sphere, or max distance of the ray. Unused for boxes.
+        float range;
+
+        static SpatialQuery Sphere(const glm::vec3 &center, float radius)
+        {
+            return SpatialQuery{.type = EType::Sphere, .first = center, .second = glm::vec3(0.0f), .range = radius};
+        }
+
+        static SpatialQuery AABB(const glm::vec3 &min, const glm::vec3 &max)
+        {
+            return SpatialQuery{.type = EType::AABB, .first = min, .second = max, .range = 0.0f};
+        }
+
+        static SpatialQuery Ray(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance)
+        {
+            return SpatialQuery{.type = EType::Ray, .first = origin, .second = direction, .range = maxDistance};
+        }
+    };
+
+    /// Hashed grid of the world bounds of the entities with a \ref Hush::SpatialBounds and a
+    /// \ref Hush::WorldTransform.
+    ///
+    /// The index is updated in PreRender, after the transforms are propagated. Tables whose world transforms and
+    /// bounds were not written since the last update are skipped, so a static scene costs one check per table. In the
+    /// other tables, only the entities whose world transform was updated that frame, or whose bounds are dirty, are
+    /// moved in the grid. Queries made during Update see the positions of the previous frame.
+    ///
+    /// Queries only read the index, so any number of them can run concurrently, as long as the index is not being
+    /// updated.
+    class SpatialIndexSystem final : public ISystem
+    {
+        using EntityId = Entity::EntityId;
+
+    public:
+        /// Default size of the cells of the grid.
+        static constexpr float DEFAULT_CELL_SIZE = 8.0f;
+
+        /// Entities that overlap more cells than this are not put in the grid, every query checks them instead.
+        static constexpr std::size_t MAX_CELLS_PER_ENTITY = 64;
+
+        /// Minimum number of queries of a job, smaller batches run in the calling thread.
+        static constexpr std::size_t PARALLEL_THRESHOLD = 64;
+
+        explicit SpatialIndexSystem(Scene &scene, float cellSize = DEFAULT_CELL_SIZE);
+
+        SpatialIndexSystem(const SpatialIndexSystem &) = delete;
+        SpatialIndexSystem &operator=(const SpatialIndexSystem &) = delete;
+
+        ~SpatialIndexSystem() override;
+
+        void Init() override
+        {
+        }
+
+        void OnShutdown() override
+        {
+        }
+
+        void OnUpdate(float) override
+        {
+        }
+
+        void OnFixedUpdate(float) override
+        {
+        }
+
+        void OnRender() override
+        {
+        }
+
+        void OnPreRender() override
+        {
+            Update();
+        }
+
+        void OnPostRender() override
+        {
+        }
+
+        [[nodiscard]]
+        std::string_view GetName() const override
+        {
+            return "SpatialIndexSystem";
+        }
+
+        /// Move the changed entities in the grid.
+        void Update();
+
+        /// Find the entities whose bounds intersect a sphere.
+        /// @param center Center of the sphere.
+        /// @param radius Radius of the sphere.
+        /// @param result Vector the ids are appended to.
+        void QuerySphere(const glm::vec3 &center, float radius, std::vector<EntityId> &result) const;
+
+        /// Find the entities whose bounds intersect a box.
+        /// @param min Min corner of the box.
+        /// @param max Max corner of the box.
+        /// @param result Vector the ids are appended to.
+        void QueryAABB(const glm::vec3 &min, const glm::vec3 &max, std::vector<EntityId> &result) const;
+
+        /// Find the entities whose bounds are hit by a ray.
+        /// @param origin Origin of the ray.
+        /// @param direction Direction of the ray, it does not need to be normalized.
+        /// @param maxDistance Length of the ray. Must be finite.
+        /// @param result Vector the ids are appended to, sorted from the nearest hit to the farthest.
+        void QueryRay(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance,
+                      std::vector<EntityId> &result) const;
+
+        /// Run many queries, splitting them across the thread pool of the scene.
+        /// It can be called from a job of that pool, the queries then run in the calling worker.
+        /// @param queries Queries to run.
+        /// @param results Result of each query. Each vector is cleared before its query runs.
+        void QueryBatch(std::span<const SpatialQuery> queries, std::span<std::vector<EntityId>> results) const;
+
+        /// @return Number of entities in the index.
+        [[nodiscard]]
+        std::size_t GetEntityCount() const noexcept
+        {
+            return m_slots.size();
+        }
+
+    private:
+        struct CellCoord
+        {
+            std::int32_t x;
+            std::int32_t y;
+            std::int32_t z;
+
+            bool operator==(const CellCoord &) const = default;
+        };
+
+        struct Cell
+        {
+            CellCoord coord;
+            std::vector<std::uint32_t> entries;
+        };
+
+        struct Entry
+        {
+            EntityId entity;
+            glm::vec3 min;
+            glm::vec3 max;
+            CellCoord minCell;
+            CellCoord maxCell;
+
+            /// Whether the entry is in the large entry list instead of in the grid.
+            bool isLarge;
+        };
+
+        /// Called by flecs when an entity loses its bounds or its world transform.
+        static void OnRemoveObserver(void *iterator);
+
+        void RunQuery(const SpatialQuery &query, std::vector<EntityId> &result) const;
+
+        /// Call a function for each entry that overlaps a range of cells, once per entry.
+        template <typename Fn>
+        void ForEachCandidate(const CellCoord &minCell, const CellCoord &maxCell, Fn &&function) const;
+
+        [[nodiscard]]
+        CellCoord GetCell(const glm::vec3 &position) const noexcept;
+
+        void Insert(std::uint32_t slot);
+        void Remove(std::uint32_t slot);
+        void RemoveEntity(EntityId entity);
+
+        float m_cellSize;
+        float m_inverseCellSize;
+
+        void *m_query = nullptr;
+
+        /// Observers of the removal of the world transform and the bounds.
+        std::array<EntityId, 2> m_observers{};
+
+        std::vector<Entry> m_entries;
+        std::vector<std::uint32_t> m_freeEntries;
+
+        /// Entry of each entity in the index.
+        std::unordered_map<EntityId, std::uint32_t> m_slots;
+
+        /// Cells of the grid, by packed coordinate.
+        std::unordered_map<std::uint64_t, Cell> m_cells;
+
+        /// Entries too big for the grid.
+        std::vector<std::uint32_t> m_largeEntries;
+    };
+} // namespace Hush
@@ -0,0 +1,145 @@
+/*! \file Transform.cpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Hierarchical transform components and their propagation
+*/
+
+#include "Transform.hpp"
+#include "Scene.hpp"
+
+#include <ThreadPool.hpp>
+
+#define FLECS_NO_CPP
+#include <flecs.h>
+
+#include <algorithm>
+#include <limits>
+
+Hush::TransformSystem::TransformSystem(Scene &scene)
+    : ISystem(scene)
+{
+    SetOrder(0);
+
+    const Entity::EntityId localTransformId = scene.GetComponentId<LocalTransform>();
+    const Entity::EntityId worldTransformId = scene.GetComponentId<WorldTransform>();
+
+    ecs_query_desc_t desc = {};
+    // Only the dirty flag of the local transforms is written. Reading them as In keeps those writes from flagging the
+    // tables as changed, so only changes made outside the system are seen by change detection.
+    desc.terms[0].id = localTransformId;
+    desc.terms[0].inout = EcsIn;
+    desc.terms[1].id = worldTransformId;
+    desc.terms[1].inout = EcsOut;
+    // World transform of the parent. Cascade groups the tables by depth, so parents are always visited first.
+    desc.terms[2].id = worldTransformId;
+    desc.terms[2].src.id = EcsCascade | EcsUp;
+    desc.terms[2].trav = EcsChildOf;
+    desc.terms[2].oper = EcsOptional;
+    desc.terms[2].inout = EcsIn;
+    desc.cache_kind = EcsQueryCacheAuto;
+
+    m_query = ecs_query_init(static_cast<ecs_world_t *>(scene.GetWorld()), &desc);
+}
+
+Hush::TransformSystem::~TransformSystem()
+{
+    ecs_query_fini(static_cast<ecs_query_t *>(m_query));
+}
+
+void Hush::TransformSystem::Propagate()
+{
+    ++m_frame;
+    m_batches.clear();
+    m_levelOffsets.clear();
+    m_updatedTables.clear();
+
+    // Collect the batches. Component pointers stay valid, structural changes are deferred to the end of the bucket.
+    auto *world = static_cast<ecs_world_t *>(GetScene().GetWorld());
+    ecs_iter_t it = ecs_query_iter(world, static_cast<ecs_query_t *>(m_query));
+    std::uint64_t currentDepth = std::numeric_limits<std::uint64_t>::max();
+
+    while (ecs_query_next(&it))
+    {
+        // Tables without new entities or written local transforms, whose parent is not visited this frame either,
+        // cannot have dirty transforms. Skipping them also keeps their world transforms from being flagged as
+        // written, so a static hierarchy costs one check per table here and in the systems reading them.
+        const bool isChanged = ecs_iter_changed(&it);
+        const bool isParentUpdated =
+            ecs_field_is_set(&it, 2) && m_updatedTables.contains(ecs_get_table(world, it.sources[2]));
+
+        if (!isChanged && !isParentUpdated)
+        {
+            ecs_iter_skip(&it);
+            continue;
+        }
+
+        m_updatedTables.insert(it.table);
+
+        if (it.group_id != currentDepth)
+        {
+            currentDepth = it.group_id;
+            m_levelOffsets.push_back(m_batches.size());
+        }
+
+        auto *locals = ecs_field(&it, LocalTransform, 0);
+        auto *worlds = ecs_field(&it, WorldTransform, 1);
+        const WorldTransform *parent = ecs_field_is_set(&it, 2) ? ecs_field(&it, WorldTransform, 2) : nullptr;
+        const auto count = static_cast<std::size_t>(it.count);
+
+        for (std::size_t offset = 0; offset < count; offset += BATCH_SIZE)
+        {
+            m_batches.push_back(TransformBatch{
+                .locals = locals + offset,
+                .worlds = worlds + offset,
+                .parent = parent,
+                .count = std::min(BATCH_SIZE, count - offset),
+            });
+        }
+    }
+
+    m_levelOffsets.push_back(m_batches.size());
+
+    Threading::ThreadPool *threadPool = GetScene().GetThreadPool();
+
+    for (std::size_t level = 0; level + 1 < m_levelOffsets.size(); ++level)
+    {
+        const std::span<const TransformBatch> batches(m_batches.data() + m_levelOffsets[level],
+                                                      m_levelOffsets[level + 1] - m_levelOffsets[level]);
+
+        if (threadPool == nullptr)
+        {
+            UpdateBatches(batches, m_frame);
+            continue;
+        }
+
+        // Batches are full except the last one of each table, so the batch count is a good estimate of the work.
+        // ParallelFor waits for every chunk, so a level is done before moving to the next one.
+        threadPool->ParallelFor(batches.size(), PARALLEL_THRESHOLD / BATCH_SIZE,
+                                [&batches, frame = m_frame](std::size_t first, std::size_t last) {
+                                    UpdateBatches(batches.subspan(first, last - first), frame);
+                                });
+    }
+}
+
+void Hush::TransformSystem::UpdateBatches(std::span<const TransformBatch> batches, std::uint64_t frame)
+{
+    for (const TransformBatch &batch : batches)
+    {
+        const bool parentUpdated = batch.parent != nullptr && batch.parent->updatedFrame == frame;
+
+        for (std::size_t i = 0; i < batch.count; ++i)
+        {
+            LocalTransform &local = batch.locals[i];
+
+            if (!local.isDirty && !parentUpdated)
+            {
+                continue;
+            }
+
+            WorldTransform &world = batch.worlds[i];
+            world.matrix = batch.parent != nullptr ? batch.parent->matrix * local.matrix : local.matrix;
+            world.updatedFrame = frame;
+            local.isDirty = false;
+        }
+    }
+}
@@ -0,0 +1,144 @@
+/*! \file Transform.hpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Hierarchical transform components and their propagation
+*/
+
+#pragma once
+
+#include "ISystem.hpp"
+
+#include <glm/mat4x4.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace Hush
+{
+    /// Transform of an entity relative to its parent, or to the world if the entity has no parent.
+    /// Parents are set with \ref Hush::Entity::SetParent.
+    struct LocalTransform
+    {
+        glm::mat4 matrix{1.0f};
+
+        /// Must be set after changing the matrix, so the world transform of the entity and its children is recomputed.
+        bool isDirty = true;
+    };
+
+    /// Transform of an entity in world space. It is computed by the \ref TransformSystem, do not write it.
+    struct WorldTransform
+    {
+        glm::mat4 matrix{1.0f};
+
+        /// Frame in which the matrix was last recomputed. Children of the entity are recomputed in that frame too.
+        std::uint64_t updatedFrame = 0;
+    };
+
+    /// Computes the world transforms of the entities with both LocalTransform and WorldTransform.
+    ///
+    /// Entities are visited breadth-first: the query groups the tables by their depth in the ChildOf hierarchy, so a
+    /// level only depends on the level before it. The tables of a level are split across the scene thread pool, see
+    /// \ref Hush::Scene::SetThreadPool.
+    ///
+    /// Only dirty subtrees are recomputed. A world transform is updated when its local transform is dirty, or when
+    /// the world transform of its parent was updated in the same frame. Tables that did not change since the last
+    /// propagation, and whose parent is not updated, are skipped without visiting their entities.
+    ///
+    /// Every scene owns one. It runs in PreRender, so it sees all the changes done in Update.
+    class TransformSystem final : public ISystem
+    {
+    public:
+        /// Maximum number of entities of a batch. Bigger tables are split, so a level can be spread evenly.
+        static constexpr std::size_t BATCH_SIZE = 1024;
+
+        /// Minimum number of entities of a job, smaller levels are processed in the calling thread.
+        static constexpr std::size_t PARALLEL_THRESHOLD = 4 * BATCH_SIZE;
+
+        explicit TransformSystem(Scene &scene);
+
+        TransformSystem(const TransformSystem &) = delete;
+        TransformSystem &operator=(const TransformSystem &) = delete;
+
+        ~TransformSystem() override;
+
+        void Init() override
+        {
+        }
+
+        void OnShutdown() override
+        {
+        }
+
+        void OnUpdate(float) override
+        {
+        }
+
+        void OnFixedUpdate(float) override
+        {
+        }
+
+        void OnRender() override
+        {
+        }
+
+        void OnPreRender() override
+        {
+            Propagate();
+        }
+
+        void OnPostRender() override
+        {
+        }
+
+        [[nodiscard]]
+        std::string_view GetName() const override
+        {
+            return "TransformSystem";
+        }
+
+        /// Recompute the dirty world transforms of the scene.
+        void Propagate();
+
+        /// Get the frame of the last propagation. World transforms updated by it have it as their updatedFrame.
+        /// @return Current frame.
+        [[nodiscard]]
+        std::uint64_t GetFrame() const noexcept
+        {
+            return m_frame;
+        }
+
+    private:
+        /// Contiguous range of entities that share the same parent.
+        struct TransformBatch
+        {
+            LocalTransform *locals;
+            WorldTransform *worlds;
+
+            /// World transform of the parent, nullptr for root entities.
+            const WorldTransform *parent;
+            std::size_t count;
+        };
+
+        /// Recompute the world transforms of a range of batches.
+        /// @param batches Batches to process.
+        /// @param frame Current frame.
+        static void UpdateBatches(std::span<const TransformBatch> batches, std::uint64_t frame);
+
+        void *m_query = nullptr;
+
+        /// Batches of the current frame, sorted by depth.
+        std::vector<TransformBatch> m_batches;
+
+        /// Index of the first batch of each level. The last element is the number of batches.
+        std::vector<std::size_t> m_levelOffsets;
+
+        /// Tables visited in the current frame, their children might need to be updated.
+        std::unordered_set<const void *> m_updatedTables;
+
+        std::uint64_t m_frame = 0;
+    };
+} // namespace Hush
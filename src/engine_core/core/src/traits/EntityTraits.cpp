@@ -3,4 +3,13 @@
     \date 2025-01-26
     \brief Component traits
 */
-#include "EntityTraits.hpp"
\ No newline at end of file
+#include "EntityTraits.hpp"
+
+#include <atomic>
+
+std::uint32_t Hush::ComponentTraits::detail::NextTypeIndex() noexcept
+{
+    static std::atomic<std::uint32_t> nextTypeIndex = 0;
+
+    return nextTypeIndex.fetch_add(1, std::memory_order_relaxed);
+}
\ No newline at end of file
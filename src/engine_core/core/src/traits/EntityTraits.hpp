@@ -11,6 +11,7 @@
 
 #include <Result.hpp>
 #include <cstdint>
+#include <cstring>
 #include <string_view>
 #include <type_traits>
 
@@ -19,11 +20,16 @@ namespace Hush
     namespace ComponentTraits
     {
         enum class EComponentOpsFlags : std::uint32_t;
+        enum class EComponentFlags : std::uint32_t;
     }
     template <>
     struct EnableBitMaskOperators<ComponentTraits::EComponentOpsFlags> : std::true_type
     {
     };
+    template <>
+    struct EnableBitMaskOperators<ComponentTraits::EComponentFlags> : std::true_type
+    {
+    };
 } // namespace Hush
 
 namespace Hush::ComponentTraits
@@ -62,6 +68,62 @@ namespace Hush::ComponentTraits
         NoMoveAssignDtor = 1 << 15,
     };
 
+    /// Flags that change how the scene stores a component.
+    enum class EComponentFlags : std::uint32_t
+    {
+        None = 0,
+
+        /// Instances of a prefab read the component from the prefab until they override it, instead of getting a
+        /// copy. See \ref Hush::Scene::Instantiate.
+        Shared = 1 << 0,
+
+        /// The component is stored in a sparse set instead of in the columns of the tables. Pointers to it stay
+        /// valid when the entity changes tables, and table moves do not copy it. Adding or removing it still moves
+        /// the rest of the components of the entity to another table.
+        Sparse = 1 << 1,
+
+        /// The component is stored in a sparse set and is not part of the archetype of its entities, so adding or
+        /// removing it never moves the entity. Meant for tags and small components that are toggled often (i.e.
+        /// Selected, Hit, Visible), which would otherwise split entities in many tables and copy whole rows on every
+        /// toggle.
+        ///
+        /// Trade-off: queries go through the sparse set one entity at a time instead of iterating table columns, so
+        /// iterating the component is slower than with archetype storage. Use it when the component is toggled more
+        /// often than it is iterated. Implies \ref Sparse. Not saved by \ref Hush::SceneSnapshot.
+        ///
+        /// Requires flecs 4.1 or newer. Older versions fall back to \ref Sparse: the component is then part of the
+        /// archetype and toggling it moves the entity like any other sparse component.
+        DontFragment = 1 << 2,
+    };
+
+    /// Flags of a component type. Specialize it to change how the scene stores the component:
+    ///
+    /// ```cpp
+    /// template <>
+    /// struct Hush::ComponentTraits::ComponentFlags<MeshRef>
+    /// {
+    ///     static constexpr EComponentFlags value = EComponentFlags::Shared;
+    /// };
+    /// ```
+    /// @tparam T Type of the component.
+    template <typename T>
+    struct ComponentFlags
+    {
+        static constexpr EComponentFlags value = EComponentFlags::None;
+    };
+
+    /// Component flagged as \ref EComponentFlags::Shared. Queries only give const access to them, as the value might
+    /// belong to a prefab.
+    template <typename T>
+    concept SharedComponent = HasFlag(ComponentFlags<std::remove_cvref_t<T>>::value, EComponentFlags::Shared);
+
+    /// Component flagged as \ref EComponentFlags::Sparse or \ref EComponentFlags::DontFragment. They have no column
+    /// in the tables, each entity's value lives in the sparse set.
+    template <typename T>
+    concept SparseComponent =
+        HasFlag(ComponentFlags<std::remove_cvref_t<T>>::value, EComponentFlags::Sparse) ||
+        HasFlag(ComponentFlags<std::remove_cvref_t<T>>::value, EComponentFlags::DontFragment);
+
     struct ComponentOps
     {
         ComponentCtor ctor;
@@ -84,6 +146,8 @@ namespace Hush::ComponentTraits
 
         void *userCtx;
         void (*userCtxFree)(void *);
+
+        EComponentFlags flags = EComponentFlags::None;
     };
 
     template <typename T>
@@ -96,6 +160,13 @@ namespace Hush::ComponentTraits
         }
     }
 
+    /// Value-initialize components whose default constructor is trivial, which zero-initializes them.
+    template <typename T>
+    void ZeroCtorImpl(void *array, std::int32_t count, const ComponentInfo &)
+    {
+        std::memset(array, 0, sizeof(T) * static_cast<std::size_t>(count));
+    }
+
     template <typename T>
     void DtorImpl(void *array, std::int32_t count, const ComponentInfo &)
     {
@@ -178,33 +249,33 @@ namespace Hush::ComponentTraits
     /// @tparam T Type of the component.
     /// @return Function pointer to the function that will construct the component.
     template <typename T>
-        requires std::is_default_constructible_v<T>
+        requires(std::is_default_constructible_v<T> && !std::is_trivially_default_constructible_v<T>)
     constexpr ComponentCtor GetCtorImpl(EComponentOpsFlags &)
     {
         return &CtorImpl<T>;
     }
 
-    /// Get the constructor function for a component that does not have a trivial constructor.
+    /// Get the constructor function for a component that has a trivial default constructor.
     /// @tparam T Type of the component.
-    /// @return Nullptr
+    /// @return Function pointer to the function that will zero the component.
     template <typename T>
-        requires std::is_trivially_constructible_v<T> && !std::is_default_constructible_v<T>
+        requires std::is_trivially_default_constructible_v<T>
     constexpr ComponentCtor GetCtorImpl(EComponentOpsFlags &)
     {
-        return nullptr;
+        return &ZeroCtorImpl<T>;
     }
 
     template <typename T>
-        requires !std::is_default_constructible_v<T>
-                 constexpr ComponentCtor GetCtorImpl(EComponentOpsFlags & flags)
+        requires(!std::is_default_constructible_v<T>)
+    constexpr ComponentCtor GetCtorImpl(EComponentOpsFlags &flags)
     {
         flags |= EComponentOpsFlags::NoCtor;
         return nullptr;
     }
 
     template <typename T>
-        requires std::is_destructible_v<T> && !std::is_trivially_destructible_v<T>
-                                          constexpr ComponentDtor GetDtorImpl(EComponentOpsFlags &)
+        requires(std::is_destructible_v<T> && !std::is_trivially_destructible_v<T>)
+    constexpr ComponentDtor GetDtorImpl(EComponentOpsFlags &)
     {
         return &DtorImpl<T>;
     }
@@ -217,8 +288,8 @@ namespace Hush::ComponentTraits
     }
 
     template <typename T>
-        requires !std::is_destructible_v<T>
-                 constexpr ComponentDtor GetDtorImpl(EComponentOpsFlags & flags)
+        requires(!std::is_destructible_v<T>)
+    constexpr ComponentDtor GetDtorImpl(EComponentOpsFlags &flags)
     {
         static_assert(std::is_destructible_v<T>, "Component must be destructible");
         flags |= EComponentOpsFlags::NoDtor;
@@ -233,15 +304,15 @@ namespace Hush::ComponentTraits
     }
 
     template <typename T>
-        requires !std::is_trivially_copyable_v<T> && std::is_copy_assignable_v<T>
+        requires(!std::is_trivially_copyable_v<T> && std::is_copy_assignable_v<T>)
     constexpr ComponentCopy GetCopyImpl(EComponentOpsFlags &)
     {
         return &CopyImpl<T>;
     }
 
     template <typename T>
-        requires !(std::is_trivially_copyable_v<T> || std::is_copy_assignable_v<T>)
-                 constexpr ComponentCopy GetCopyImpl(EComponentOpsFlags & flags)
+        requires(!(std::is_trivially_copyable_v<T> || std::is_copy_assignable_v<T>))
+    constexpr ComponentCopy GetCopyImpl(EComponentOpsFlags &flags)
     {
         flags |= EComponentOpsFlags::NoCopy;
         return nullptr;
@@ -314,8 +385,8 @@ namespace Hush::ComponentTraits
     }
 
     template <typename T>
-        requires !(std::is_trivially_move_constructible_v<T> && std::is_trivially_destructible_v<T>) &&
-                 (std::is_move_constructible_v<T> && std::is_destructible_v<T>)
+        requires(!(std::is_trivially_move_constructible_v<T> && std::is_trivially_destructible_v<T>) &&
+                 (std::is_move_constructible_v<T> && std::is_destructible_v<T>))
     constexpr ComponentMoveCtor GetMoveDtorImpl(EComponentOpsFlags &)
     {
         return &MoveCtorDtorImpl<T>;
@@ -344,28 +415,49 @@ namespace Hush::ComponentTraits
     }
 
     template <typename T>
-        requires !(std::is_move_assignable_v<T> && std::is_destructible_v<T>)
-                 constexpr ComponentMoveCtor GetMoveAssignDtorImpl(EComponentOpsFlags & flags)
+        requires(!(std::is_move_assignable_v<T> && std::is_destructible_v<T>))
+    constexpr ComponentMoveCtor GetMoveAssignDtorImpl(EComponentOpsFlags &flags)
     {
         flags |= EComponentOpsFlags::NoMoveAssignDtor;
         return nullptr;
     }
 
     template <typename T>
-        requires !(std::is_trivially_move_assignable_v<T> && std::is_trivially_destructible_v<T>) &&
-                 (std::is_move_assignable_v<T> && std::is_destructible_v<T>)
+        requires(!(std::is_trivially_move_assignable_v<T> && std::is_trivially_destructible_v<T>) &&
+                 (std::is_move_assignable_v<T> && std::is_destructible_v<T>))
     constexpr ComponentMoveCtor GetMoveAssignDtorImpl(EComponentOpsFlags &)
     {
         return &MoveAssignDtorImpl<T>;
     }
 
+    /// Check if a component can be copied and relocated as raw bytes. Such components only need a constructor, flecs
+    /// moves them between tables with memcpy.
+    template <typename T>
+    concept TriviallyRelocatable = std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T> &&
+                                   std::is_copy_constructible_v<T> && std::is_copy_assignable_v<T> &&
+                                   std::is_move_constructible_v<T> && std::is_move_assignable_v<T>;
+
     /// Get the operations for a component.
     /// @tparam T Type of the component.
     /// @return Operations for the component.
     template <typename T>
-    requires !std::is_reference_v<T>
+        requires(!std::is_reference_v<T>)
     constexpr ComponentOps GetOps(EComponentOpsFlags &flags)
     {
+        if constexpr (TriviallyRelocatable<std::remove_cvref_t<T>>)
+        {
+            return ComponentOps{
+                .ctor = GetCtorImpl<std::remove_cvref_t<T>>(flags),
+                .dtor = nullptr,
+                .copy = nullptr,
+                .move = nullptr,
+                .copyCtor = nullptr,
+                .moveCtor = nullptr,
+                .moveDtor = nullptr,
+                .moveAssignDtor = nullptr,
+            };
+        }
+
         return ComponentOps{
             .ctor = GetCtorImpl<std::remove_cvref_t<T>>(flags),
             .dtor = GetDtorImpl<std::remove_cvref_t<T>>(flags),
@@ -374,18 +466,23 @@ namespace Hush::ComponentTraits
             .copyCtor = GetCopyCtorImpl<std::remove_cvref_t<T>>(flags),
             .moveCtor = GetMoveCtorImpl<std::remove_cvref_t<T>>(flags),
             .moveDtor = GetMoveDtorImpl<std::remove_cvref_t<T>>(flags),
+            .moveAssignDtor = GetMoveAssignDtorImpl<std::remove_cvref_t<T>>(flags),
         };
     }
 
+    template <typename T>
+    consteval std::string_view GetTypeName();
+
     template <typename T>
     ComponentInfo GetComponentInfo()
     {
         auto componentInfo = ComponentInfo{
             .size = sizeof(T),
             .alignment = alignof(T),
-            .name = typeid(T).name(),
+            .name = GetTypeName<T>(),
             .userCtx = nullptr,
             .userCtxFree = nullptr,
+            .flags = ComponentFlags<T>::value,
         };
 
         componentInfo.ops = GetOps<T>(componentInfo.opsFlags);
@@ -402,14 +499,14 @@ namespace Hush::ComponentTraits
         consteval std::string_view ExtractTypeFromPrettyFunction(std::string_view function)
         {
             // Example of function: consteval std::string_view GetTypeName() [with T = int; std::string_view =
-            // std::basic_string_view<char>]. We must extract T
+            // std::basic_string_view<char>]. We must extract T. Clang does not print the aliases, and ends with "]".
             std::size_t start = function.find("T = ");
             if (start == std::string_view::npos)
             {
                 return "Unknown";
             }
             start += 4;
-            std::size_t end = function.find(";", start);
+            std::size_t end = function.find_first_of(";]", start);
             if (end == std::string_view::npos)
             {
                 return "Unknown";
@@ -435,58 +532,59 @@ namespace Hush::ComponentTraits
             }
 
             // Remove any struct/class/enum/union prefix
+            std::string_view name = function.substr(start, end - start);
+            for (std::string_view prefix : {"struct ", "class ", "enum ", "union "})
+            {
+                if (name.starts_with(prefix))
+                {
+                    name.remove_prefix(prefix.size());
+                    break;
+                }
+            }
 
-            return function.substr(start, end - start);
+            return name;
         }
 #endif
 
-        enum class EEntityRegisterStatus
-        {
-            Registered,
-            NotRegistered,
-        };
+        /// Get the next free type index. Type indices are dense and start at zero.
+        /// @return Next type index.
+        std::uint32_t NextTypeIndex() noexcept;
 
-        /// Get the entity id for a given entity type.
-        /// @tparam T Type of the entity, without cvref.
-        /// @param worldPtr Pointer to the world.
-        /// @return Pair with the status of the entity and the entity id.
+        /// Get the type index of a component type.
+        /// The index is assigned the first time it is requested, and scenes use it as the slot of the type in their
+        /// component id table. The address of the returned value identifies the type within this binary, so a slot
+        /// filled by another binary (i.e. a module loaded as a shared library) is never mistaken for this type.
+        /// @tparam T Type of the component, without cvref.
+        /// @return Reference to the type index.
         template <typename T>
-        static std::pair<EEntityRegisterStatus, std::uint64_t *> GetEntityIdImpl(const void *worldPtr)
+        const std::uint32_t &GetTypeIndexImpl() noexcept
         {
-            thread_local std::uint64_t entityId = 0;
-            thread_local const void *world = nullptr;
-
-            // First, check if it's already registered
-            if (entityId == 0 || world != worldPtr)
-            {
-                world = worldPtr;
-                return {EEntityRegisterStatus::NotRegistered, &entityId};
-            }
-            world = worldPtr;
-
-            return {EEntityRegisterStatus::Registered, &entityId};
+            static const std::uint32_t typeIndex = NextTypeIndex();
+            return typeIndex;
         }
 
-        /// Get the entity id for a given entity type.
-        /// @tparam T Type of the entity.
-        /// @param worldPtr Pointer to the world.
-        /// @return Pair with the status of the entity and the entity id.
+        /// Get the type index of a component type.
+        /// @tparam T Type of the component.
+        /// @return Reference to the type index.
         template <typename T>
-        static std::pair<EEntityRegisterStatus, std::uint64_t *> GetEntityId(const void *worldPtr)
+        const std::uint32_t &GetTypeIndex() noexcept
         {
-            return GetEntityIdImpl<std::remove_cvref_t<T>>(worldPtr);
+            return GetTypeIndexImpl<std::remove_cvref_t<T>>();
         }
     } // namespace detail
 
+    /// Get the name of a type, as written in the source (i.e. "Hush::LocalTransform"). Unlike typeid names, it does
+    /// not depend on the ABI, so it can be stored in files. The view is not null terminated.
+    /// @tparam T Type to get the name of.
+    /// @return Name of the type.
     template <typename T>
     consteval std::string_view GetTypeName()
     {
         // Get the function name
 #if HUSH_COMPILER_CLANG || HUSH_COMPILER_GCC
-        std::string_view name = __PRETTY_FUNCTION__;
+        return detail::ExtractTypeFromPrettyFunction(__PRETTY_FUNCTION__);
 #elif HUSH_COMPILER_MSVC
-        std::string_view name = __FUNCSIG__;
+        return detail::ExtractTypeFromFuncSig(__FUNCSIG__);
 #endif
-        return "Unknown";
     }
 } // namespace Hush::ComponentTraits
\ No newline at end of file
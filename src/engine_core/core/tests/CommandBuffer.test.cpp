@@ -0,0 +1,220 @@
+/*! \file CommandBuffer.test.cpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief CommandBuffer test implementation
+*/
+#include <CommandBuffer.hpp>
+#include <Entity.hpp>
+#include <Scene.hpp>
+#include <ThreadPool.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+TEST_CASE("Command buffer", "[command_buffer]")
+{
+    struct Position
+    {
+        float x;
+        float y;
+    };
+
+    struct Tag
+    {
+    };
+
+    Hush::Scene scene(nullptr);
+    Hush::CommandBuffer &commands = scene.GetCommandBuffer();
+
+    SECTION("Same buffer for the same thread")
+    {
+        REQUIRE(&scene.GetCommandBuffer() == &commands);
+    }
+
+    SECTION("Commands are deferred until flush")
+    {
+        Hush::Entity entity = scene.CreateEntity();
+
+        commands.SetComponent(entity.GetId(), Position{1.0f, 2.0f});
+        REQUIRE(commands.Size() == 1);
+        REQUIRE_FALSE(entity.HasComponent<Position>());
+
+        scene.FlushCommandBuffers();
+        REQUIRE(commands.IsEmpty());
+        REQUIRE(entity.HasComponent<Position>());
+        REQUIRE(entity.GetComponent<Position>()->y == 2.0f);
+    }
+
+    SECTION("Pending entities")
+    {
+        Hush::CommandBuffer::PendingEntity pending = commands.CreateEntity();
+        commands.AddComponent<Tag>(pending);
+        commands.SetComponent(pending, Position{3.0f, 4.0f});
+
+        scene.FlushCommandBuffers();
+
+        Hush::Entity created(&scene, commands.GetCreatedEntity(pending));
+        REQUIRE(created.GetId() != 0);
+        REQUIRE(created.HasComponent<Tag>());
+        REQUIRE(created.GetComponent<Position>()->x == 3.0f);
+    }
+
+    SECTION("Remove and destroy")
+    {
+        Hush::Entity entity = scene.CreateEntity();
+        entity.AddComponent<Tag>();
+        Hush::Entity toDestroy = scene.CreateEntity();
+
+        commands.RemoveComponent<Tag>(entity.GetId());
+        commands.DestroyEntity(toDestroy.GetId());
+        // Setting a component of a destroyed entity is ignored.
+        commands.SetComponent(toDestroy.GetId(), Position{});
+
+        scene.FlushCommandBuffers();
+        REQUIRE_FALSE(entity.HasComponent<Tag>());
+    }
+
+    SECTION("Commands are applied by sort key")
+    {
+        Hush::Entity entity = scene.CreateEntity();
+
+        commands.SetSortKey(1);
+        commands.SetComponent(entity.GetId(), Position{1.0f, 1.0f});
+        commands.SetSortKey(0);
+        commands.SetComponent(entity.GetId(), Position{0.0f, 0.0f});
+
+        scene.FlushCommandBuffers();
+        REQUIRE(entity.GetComponent<Position>()->x == 1.0f);
+    }
+
+    SECTION("Remove and set are applied in recording order")
+    {
+        struct Handle
+        {
+            explicit Handle(int handleValue)
+                : value(handleValue)
+            {
+            }
+
+            int value;
+        };
+
+        Hush::Entity removed = scene.CreateEntity();
+        Hush::Entity readded = scene.CreateEntity();
+        Hush::Entity noDefault = scene.CreateEntity();
+
+        commands.SetComponent(removed.GetId(), Position{1.0f, 1.0f});
+        commands.RemoveComponent<Position>(removed.GetId());
+
+        commands.RemoveComponent<Position>(readded.GetId());
+        commands.SetComponent(readded.GetId(), Position{2.0f, 2.0f});
+
+        // Components without a default constructor are only added when their value is written.
+        commands.SetComponent(noDefault.GetId(), Handle{1});
+        commands.RemoveComponent<Handle>(noDefault.GetId());
+
+        scene.FlushCommandBuffers();
+        REQUIRE_FALSE(removed.HasComponent<Position>());
+        REQUIRE(readded.GetComponent<Position>()->x == 2.0f);
+        REQUIRE_FALSE(noDefault.HasComponent<Handle>());
+    }
+}
+
+TEST_CASE("Command buffers recorded from several threads", "[command_buffer]")
+{
+    struct Score
+    {
+        std::uint64_t value;
+    };
+
+    struct Spawned
+    {
+        std::uint64_t item;
+    };
+
+    constexpr std::size_t NUM_ENTITIES = 512;
+    constexpr std::size_t NUM_ITEMS = 4 * NUM_ENTITIES;
+    constexpr int NUM_RUNS = 8;
+    constexpr std::uint64_t NO_SCORE = std::numeric_limits<std::uint64_t>::max();
+
+    Hush::Threading::ThreadPool threadPool(4);
+    threadPool.Start();
+
+    // Records the same commands from the workers of the pool, and returns the resulting state of the scene.
+    const auto runOnce = [&]() {
+        Hush::Scene scene(nullptr);
+        scene.SetThreadPool(&threadPool);
+
+        // Components must be registered before recording from the workers.
+        (void)scene.GetComponentId<Score>();
+        (void)scene.GetComponentId<Spawned>();
+
+        std::vector<Hush::Entity::EntityId> entities;
+        for (std::size_t i = 0; i < NUM_ENTITIES; ++i)
+        {
+            entities.push_back(scene.CreateEntity().GetId());
+        }
+
+        // Every entity is written by several items, so the result depends on the order the commands are applied in.
+        threadPool.ParallelFor(NUM_ITEMS, 16, [&](std::size_t first, std::size_t last) {
+            Hush::CommandBuffer &commands = scene.GetCommandBuffer();
+
+            for (std::size_t item = first; item < last; ++item)
+            {
+                // The key depends on the item, not on the thread that records it.
+                commands.SetSortKey(item);
+
+                const Hush::Entity::EntityId entity = entities[item % NUM_ENTITIES];
+                commands.SetComponent(entity, Score{item});
+
+                if (item % 7 == 0)
+                {
+                    commands.RemoveComponent<Score>(entity);
+                }
+
+                if (item % 5 == 0)
+                {
+                    const Hush::CommandBuffer::PendingEntity spawned = commands.CreateEntity();
+                    commands.SetComponent(spawned, Spawned{item});
+                }
+            }
+        });
+
+        scene.FlushCommandBuffers();
+
+        std::vector<std::uint64_t> state;
+        for (const Hush::Entity::EntityId entityId : entities)
+        {
+            const Hush::Entity entity(&scene, entityId);
+            const Score *score = entity.GetComponent<Score>();
+            state.push_back(score != nullptr ? score->value : NO_SCORE);
+        }
+
+        scene.CreateQuery<Spawned>().Each([&state](Hush::Entity::EntityId entity, const Spawned &spawned) {
+            state.push_back(entity);
+            state.push_back(spawned.item);
+        });
+
+        return state;
+    };
+
+    // Arrange
+    const std::vector<std::uint64_t> firstState = runOnce();
+
+    // The last item of each entity wins, unless it also removed the score.
+    for (std::size_t i = 0; i < NUM_ENTITIES; ++i)
+    {
+        const std::uint64_t lastItem = i + NUM_ITEMS - NUM_ENTITIES;
+        REQUIRE(firstState[i] == (lastItem % 7 == 0 ? NO_SCORE : lastItem));
+    }
+    REQUIRE(firstState.size() == NUM_ENTITIES + 2 * ((NUM_ITEMS + 4) / 5));
+
+    // Act and assert
+    for (int run = 1; run < NUM_RUNS; ++run)
+    {
+        REQUIRE(runOnce() == firstState);
+    }
+}
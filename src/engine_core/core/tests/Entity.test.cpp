@@ -7,6 +7,19 @@
 #include <Scene.hpp>
 
 #include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+
+struct SharedMesh
+{
+    int meshId;
+};
+
+template <>
+struct Hush::ComponentTraits::ComponentFlags<SharedMesh>
+{
+    static constexpr Hush::ComponentTraits::EComponentFlags value = Hush::ComponentTraits::EComponentFlags::Shared;
+};
 
 TEST_CASE("Entity creation", "[entity]")
 {
@@ -107,4 +120,258 @@ TEST_CASE("Entity with components", "[entity]")
         REQUIRE(entity.RemoveComponent<Position>());
         REQUIRE_FALSE(entity.RemoveComponent<Position>());
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Entity components in multiple scenes", "[entity]")
+{
+    struct Health
+    {
+        int value;
+    };
+
+    struct Armor
+    {
+        int value;
+    };
+
+    SECTION("Component ids are per scene")
+    {
+        Hush::Scene sceneA(nullptr);
+        Hush::Scene sceneB(nullptr);
+
+        // Register the components in a different order, so the ids differ between scenes.
+        (void)sceneA.GetComponentId<Health>();
+        (void)sceneB.GetComponentId<Armor>();
+
+        REQUIRE(sceneA.GetComponentId<Health>() == sceneA.GetComponentId<const Health &>());
+        REQUIRE(sceneA.GetComponentId<Health>() != sceneA.GetComponentId<Armor>());
+        REQUIRE(sceneB.GetComponentId<Health>() != sceneB.GetComponentId<Armor>());
+        REQUIRE(sceneA.GetComponentId<Health>() != sceneB.GetComponentId<Health>());
+    }
+
+    SECTION("Ping-pong between scenes")
+    {
+        Hush::Scene sceneA(nullptr);
+        Hush::Scene sceneB(nullptr);
+
+        Hush::Entity entityA = sceneA.CreateEntity();
+        Hush::Entity entityB = sceneB.CreateEntity();
+
+        entityB.EmplaceComponent<Armor>(7);
+        entityA.EmplaceComponent<Health>(10);
+        entityB.EmplaceComponent<Health>(20);
+
+        for (int i = 0; i < 4; ++i)
+        {
+            REQUIRE(entityA.GetComponent<Health>()->value == 10);
+            REQUIRE(entityB.GetComponent<Health>()->value == 20);
+            REQUIRE(entityA.GetComponent<Armor>() == nullptr);
+            REQUIRE(entityB.GetComponent<Armor>()->value == 7);
+        }
+    }
+}
+
+TEST_CASE("Bulk entity operations", "[entity]")
+{
+    struct Position
+    {
+        float x;
+        float y;
+    };
+
+    struct Velocity
+    {
+        float x;
+        float y;
+    };
+
+    constexpr std::size_t NUM_ENTITIES = 1000;
+
+    SECTION("CreateEntities")
+    {
+        Hush::Scene scene(nullptr);
+
+        std::span<const Hush::Entity::EntityId> entities =
+            scene.CreateEntities(NUM_ENTITIES, Position{1.0f, 2.0f}, Velocity{3.0f, 4.0f});
+
+        REQUIRE(entities.size() == NUM_ENTITIES);
+
+        Hush::Entity last(&scene, entities.back());
+        REQUIRE(last.GetComponent<Position>()->y == 2.0f);
+        REQUIRE(last.GetComponent<Velocity>()->x == 3.0f);
+    }
+
+    SECTION("AddComponents and RemoveComponents")
+    {
+        Hush::Scene scene(nullptr);
+
+        std::span<const Hush::Entity::EntityId> created = scene.CreateEntities<Position>(NUM_ENTITIES);
+        std::vector<Hush::Entity::EntityId> entities(created.begin(), created.end());
+
+        scene.AddComponents<Velocity>(entities);
+
+        std::size_t numEntities = 0;
+        scene.CreateQuery<Position, Velocity>().Each([&numEntities](Position &, Velocity &) { ++numEntities; });
+        REQUIRE(numEntities == NUM_ENTITIES);
+
+        scene.RemoveComponents<Position, Velocity>(entities);
+
+        Hush::Entity first(&scene, entities.front());
+        REQUIRE_FALSE(first.HasComponent<Position>());
+        REQUIRE_FALSE(first.HasComponent<Velocity>());
+    }
+}
+
+TEST_CASE("Prefabs", "[entity]")
+{
+    struct Health
+    {
+        int value;
+    };
+
+    constexpr std::size_t NUM_INSTANCES = 100;
+
+    Hush::Scene scene(nullptr);
+
+    Hush::Entity prefab = scene.CreatePrefab();
+    prefab.EmplaceComponent<SharedMesh>(SharedMesh{7});
+    prefab.EmplaceComponent<Health>(Health{100});
+
+    std::span<const Hush::Entity::EntityId> created = scene.Instantiate(prefab, NUM_INSTANCES);
+    std::vector<Hush::Entity::EntityId> instances(created.begin(), created.end());
+
+    REQUIRE(instances.size() == NUM_INSTANCES);
+
+    SECTION("Shared components are read from the prefab")
+    {
+        const Hush::Entity instance(&scene, instances.front());
+        const Hush::Entity &constPrefab = prefab;
+
+        REQUIRE(instance.GetComponent<SharedMesh>() == constPrefab.GetComponent<SharedMesh>());
+        REQUIRE(instance.GetComponent<SharedMesh>()->meshId == 7);
+    }
+
+    SECTION("Other components are copied")
+    {
+        Hush::Entity instance(&scene, instances.front());
+
+        REQUIRE(instance.OwnsComponent<Health>());
+        REQUIRE(instance.GetComponent<Health>()->value == 100);
+    }
+
+    SECTION("Shared components are overridden explicitly")
+    {
+        Hush::Entity instance(&scene, instances.front());
+        REQUIRE_FALSE(instance.OwnsComponent<SharedMesh>());
+        REQUIRE(instance.GetComponent<SharedMesh>() == nullptr);
+
+        SharedMesh &mesh = instance.OverrideComponent<SharedMesh>();
+        REQUIRE(mesh.meshId == 7);
+        mesh.meshId = 8;
+
+        REQUIRE(instance.OwnsComponent<SharedMesh>());
+        REQUIRE(instance.GetComponent<SharedMesh>()->meshId == 8);
+        REQUIRE(prefab.GetComponent<SharedMesh>()->meshId == 7);
+    }
+
+    SECTION("Overrides can be recorded while iterating")
+    {
+        Hush::CommandBuffer &commands = scene.GetCommandBuffer();
+        Hush::Query<SharedMesh> query = scene.CreateQuery<SharedMesh>();
+
+        query.Each([&commands](Hush::Entity::EntityId entity, const SharedMesh &) {
+            commands.OverrideComponent<SharedMesh>(entity);
+        });
+        scene.FlushCommandBuffers();
+
+        Hush::Entity instance(&scene, instances.back());
+        REQUIRE(instance.OwnsComponent<SharedMesh>());
+        REQUIRE(instance.GetComponent<SharedMesh>()->meshId == 7);
+    }
+
+    SECTION("Queries match the instances")
+    {
+        Hush::Query<SharedMesh, Health> query = scene.CreateQuery<SharedMesh, Health>();
+
+        std::size_t numEntities = 0;
+        query.Each([&numEntities](const SharedMesh &mesh, Health &health) {
+            REQUIRE(mesh.meshId == 7);
+            REQUIRE(health.value == 100);
+            ++numEntities;
+        });
+
+        REQUIRE(numEntities == NUM_INSTANCES);
+    }
+
+    SECTION("Tables with shared components are iterated at once")
+    {
+        Hush::Query<SharedMesh, Health> query = scene.CreateQuery<SharedMesh, Health>();
+
+        for (auto it = query.begin(); it != query.end(); ++it)
+        {
+            auto [meshes, healths] = *it;
+
+            REQUIRE(it.IsShared(0));
+            REQUIRE_FALSE(it.IsShared(1));
+            REQUIRE(meshes.size() == 1);
+            REQUIRE(healths.size() == it.Size());
+            REQUIRE(&meshes.front() == prefab.GetComponent<SharedMesh>());
+        }
+    }
+}
+
+TEST_CASE("Component ops", "[entity]")
+{
+    struct Pod
+    {
+        float x;
+        float y;
+    };
+
+    struct WithString
+    {
+        std::string name = "default";
+    };
+
+    using namespace Hush::ComponentTraits;
+
+    SECTION("Trivially copyable components only get a constructor")
+    {
+        const ComponentInfo info = GetComponentInfo<Pod>();
+
+        REQUIRE(info.ops.ctor != nullptr);
+        REQUIRE(info.ops.dtor == nullptr);
+        REQUIRE(info.ops.copy == nullptr);
+        REQUIRE(info.ops.move == nullptr);
+        REQUIRE(info.ops.copyCtor == nullptr);
+        REQUIRE(info.ops.moveCtor == nullptr);
+        REQUIRE(info.ops.moveDtor == nullptr);
+        REQUIRE(info.ops.moveAssignDtor == nullptr);
+    }
+
+    SECTION("Other components get every hook")
+    {
+        const ComponentInfo info = GetComponentInfo<WithString>();
+
+        REQUIRE(info.ops.dtor != nullptr);
+        REQUIRE(info.ops.copy != nullptr);
+        REQUIRE(info.ops.moveDtor != nullptr);
+        REQUIRE(info.ops.moveAssignDtor != nullptr);
+    }
+
+    SECTION("Components are initialized and survive table moves")
+    {
+        Hush::Scene scene(nullptr);
+        Hush::Entity entity = scene.CreateEntity();
+
+        REQUIRE(entity.AddComponent<Pod>().x == 0.0f);
+        REQUIRE(entity.AddComponent<WithString>().name == "default");
+
+        entity.GetComponent<Pod>()->y = 2.0f;
+        entity.GetComponent<WithString>()->name = "moved";
+        entity.AddComponent<SharedMesh>();
+
+        REQUIRE(entity.GetComponent<Pod>()->y == 2.0f);
+        REQUIRE(entity.GetComponent<WithString>()->name == "moved");
+    }
+}
@@ -136,4 +136,48 @@ TEST_CASE("Query creation", "[query]")
         REQUIRE(numEntitiesVelocity == NUM_ENTITIES_WITH_VELOCITY + NUM_ENTITIES_WITH_BOTH);
         REQUIRE(numEntitiesBoth == NUM_ENTITIES_WITH_BOTH);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Query cache", "[query]")
+{
+    SECTION("Same signature returns the same query")
+    {
+        Hush::Scene scene(nullptr);
+
+        Hush::QueryHandle<Position, Velocity> first = scene.GetCachedQuery<Position, Velocity>();
+        scene.GetCachedQuery<Position, Velocity>();
+        scene.GetCachedQuery<Velocity, Position>();
+
+        const Hush::QueryCacheStats stats = scene.GetQueryCacheStats();
+
+        REQUIRE(first.IsValid());
+        REQUIRE(stats.misses == 2);
+        REQUIRE(stats.hits == 1);
+        REQUIRE(stats.cachedQueries == 2);
+    }
+
+    SECTION("Cached query matches new entities")
+    {
+        Hush::Scene scene(nullptr);
+        constexpr std::size_t NUM_ENTITIES = 100;
+
+        Hush::QueryHandle<Position, Velocity> query = scene.GetCachedQuery<Position, Velocity>();
+
+        for (std::size_t i = 0; i < NUM_ENTITIES; ++i)
+        {
+            Hush::Entity entity = scene.CreateEntity();
+            entity.EmplaceComponent<Position>(static_cast<float>(i), static_cast<float>(i));
+            entity.EmplaceComponent<Velocity>(static_cast<float>(i), static_cast<float>(i));
+        }
+
+        std::size_t numEntities = 0;
+        query.Each([&numEntities](const Position &, const Velocity &) { ++numEntities; });
+
+        const Hush::QueryCacheStats stats = scene.GetQueryCacheStats();
+
+        REQUIRE(numEntities == NUM_ENTITIES);
+        REQUIRE(stats.cachedQueries == 1);
+        REQUIRE(stats.matchedTables == 1);
+        REQUIRE(stats.matchedEntities == NUM_ENTITIES);
+    }
+}
@@ -0,0 +1,90 @@
+/*! \file SceneGroup.test.cpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Scene group test implementation
+*/
+#include <Entity.hpp>
+#include <Scene.hpp>
+#include <SceneGroup.hpp>
+#include <ThreadPool.hpp>
+#include <Transform.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace
+{
+    constexpr std::size_t NUM_SCENES = 64;
+    constexpr std::size_t NUM_ENTITIES = 128;
+
+    void PopulateScenes(Hush::SceneGroup &group)
+    {
+        for (std::size_t i = 0; i < NUM_SCENES; ++i)
+        {
+            Hush::Scene &scene = group.CreateScene();
+
+            for (std::size_t j = 0; j < NUM_ENTITIES; ++j)
+            {
+                Hush::Entity entity = scene.CreateEntity();
+                entity.AddComponent<Hush::LocalTransform>().matrix =
+                    glm::translate(glm::mat4(1.0f), glm::vec3(static_cast<float>(i), static_cast<float>(j), 0.0f));
+                entity.AddComponent<Hush::WorldTransform>();
+            }
+        }
+    }
+
+    void CheckScenes(Hush::SceneGroup &group)
+    {
+        REQUIRE(group.GetSceneCount() == NUM_SCENES);
+
+        for (std::size_t i = 0; i < NUM_SCENES; ++i)
+        {
+            std::size_t numEntities = 0;
+
+            group.GetScene(i).CreateQuery<Hush::WorldTransform>().Each([&](Hush::WorldTransform &world) {
+                REQUIRE(world.matrix[3].x == static_cast<float>(i));
+                ++numEntities;
+            });
+
+            REQUIRE(numEntities == NUM_ENTITIES);
+        }
+    }
+} // namespace
+
+TEST_CASE("Scene groups", "[scene]")
+{
+    SECTION("Scenes run in the calling thread without a thread pool")
+    {
+        Hush::SceneGroup group(nullptr, nullptr);
+        PopulateScenes(group);
+
+        group.PreRender();
+
+        CheckScenes(group);
+    }
+
+    SECTION("Scenes run concurrently in a thread pool")
+    {
+        Hush::Threading::ThreadPool threadPool(4);
+        threadPool.Start();
+
+        Hush::SceneGroup group(nullptr, &threadPool);
+        PopulateScenes(group);
+
+        group.PreRender();
+
+        CheckScenes(group);
+    }
+
+    SECTION("Destroying scenes")
+    {
+        Hush::SceneGroup group(nullptr, nullptr);
+        Hush::Scene &first = group.CreateScene();
+        Hush::Scene &second = group.CreateScene();
+
+        group.DestroyScene(first);
+
+        REQUIRE(group.GetSceneCount() == 1);
+        REQUIRE(&group.GetScene(0) == &second);
+    }
+}
@@ -0,0 +1,141 @@
+/*! \file SceneSnapshot.test.cpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Scene snapshot test implementation
+*/
+#include <Entity.hpp>
+#include <Scene.hpp>
+#include <SceneSnapshot.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+
+struct SnapshotPosition
+{
+    float x;
+    float y;
+};
+
+struct SnapshotVelocity
+{
+    float x;
+    float y;
+};
+
+struct SnapshotTag
+{
+};
+
+TEST_CASE("Scene snapshots", "[snapshot]")
+{
+    constexpr std::size_t NUM_ENTITIES = 256;
+
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "HushSceneSnapshot.test.bin";
+
+    {
+        Hush::Scene scene(nullptr);
+
+        for (std::size_t i = 0; i < NUM_ENTITIES; ++i)
+        {
+            Hush::Entity entity = scene.CreateEntity();
+            entity.AddComponent<SnapshotPosition>() = {static_cast<float>(i), 1.0f};
+
+            if (i % 2 == 0)
+            {
+                entity.AddComponent<SnapshotVelocity>() = {2.0f, static_cast<float>(i)};
+            }
+        }
+
+        Hush::Entity parent = scene.CreateEntity();
+        parent.AddComponent<SnapshotPosition>() = {-1.0f, -1.0f};
+        parent.AddComponent<SnapshotTag>();
+
+        Hush::Entity child = scene.CreateEntity();
+        child.AddComponent<SnapshotVelocity>() = {-2.0f, -2.0f};
+        child.SetParent(parent.GetId());
+
+        REQUIRE(Hush::SceneSnapshot::Save(scene, path).has_value());
+    }
+
+    Hush::Scene scene(nullptr);
+    REQUIRE(Hush::SceneSnapshot::Load(scene, path).has_value());
+
+    SECTION("Component values are restored")
+    {
+        std::size_t count = 0;
+        float sum = 0.0f;
+
+        scene.CreateQuery<SnapshotPosition>().Each([&](SnapshotPosition &position) {
+            ++count;
+            sum += position.x;
+        });
+
+        REQUIRE(count == NUM_ENTITIES + 1);
+        REQUIRE(sum == static_cast<float>(NUM_ENTITIES * (NUM_ENTITIES - 1) / 2) - 1.0f);
+
+        std::size_t numMoving = 0;
+        scene.CreateQuery<SnapshotPosition, SnapshotVelocity>().Each(
+            [&](SnapshotPosition &position, SnapshotVelocity &velocity) {
+                ++numMoving;
+                REQUIRE(velocity.y == position.x);
+            });
+
+        REQUIRE(numMoving == NUM_ENTITIES / 2);
+    }
+
+    SECTION("Hierarchy is restored")
+    {
+        std::size_t numChildren = 0;
+
+        scene.CreateQuery<SnapshotVelocity>().Each([&](Hush::Entity &entity, SnapshotVelocity &velocity) {
+            if (velocity.x != -2.0f)
+            {
+                REQUIRE(entity.GetParent() == 0);
+                return;
+            }
+
+            ++numChildren;
+            Hush::Entity parent(&scene, entity.GetParent());
+
+            REQUIRE(parent.HasComponent<SnapshotTag>());
+            REQUIRE(parent.GetComponent<SnapshotPosition>()->x == -1.0f);
+        });
+
+        REQUIRE(numChildren == 1);
+    }
+
+    SECTION("Invalid files are rejected")
+    {
+        {
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file << "not a snapshot";
+        }
+
+        auto result = Hush::SceneSnapshot::Load(scene, path);
+
+        REQUIRE(result.has_error());
+        REQUIRE(result.error() == Hush::SceneSnapshot::EError::InvalidFormat);
+    }
+
+    SECTION("Invalid alignments are rejected")
+    {
+        // The first component record follows the 32 bytes header, its alignment is its fourth field.
+        constexpr std::streamoff ALIGNMENT_OFFSET = 32 + 3 * sizeof(std::uint32_t);
+        constexpr std::uint32_t INVALID_ALIGNMENT = 3;
+
+        {
+            std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(ALIGNMENT_OFFSET);
+            file.write(reinterpret_cast<const char *>(&INVALID_ALIGNMENT), sizeof(INVALID_ALIGNMENT));
+        }
+
+        Hush::Scene otherScene(nullptr);
+        auto result = Hush::SceneSnapshot::Load(otherScene, path);
+
+        REQUIRE(result.has_error());
+        REQUIRE(result.error() == Hush::SceneSnapshot::EError::InvalidFormat);
+    }
+
+    std::filesystem::remove(path);
+}
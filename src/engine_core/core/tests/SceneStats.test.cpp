@@ -0,0 +1,73 @@
+/*! \file SceneStats.test.cpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Scene statistics test implementation
+*/
+#include <Entity.hpp>
+#include <Scene.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+
+struct StatsPosition
+{
+    float x;
+    float y;
+    float z;
+};
+
+struct StatsTagA
+{
+};
+
+struct StatsTagB
+{
+};
+
+TEST_CASE("Scene stats", "[scene]")
+{
+    constexpr std::size_t NUM_ENTITIES = 100;
+
+    Hush::Scene scene(nullptr);
+    (void)scene.CreateEntities<StatsPosition>(NUM_ENTITIES);
+    (void)scene.CreateEntities<StatsPosition, StatsTagA>(1);
+    (void)scene.CreateEntities<StatsPosition, StatsTagA, StatsTagB>(1);
+    (void)scene.GetCachedQuery<StatsPosition>();
+
+    const Hush::SceneStats stats = scene.GetStats();
+
+    SECTION("Tables")
+    {
+        REQUIRE(stats.entities >= NUM_ENTITIES + 2);
+        REQUIRE(stats.tables >= 3);
+        REQUIRE(stats.smallTables >= 2);
+        REQUIRE(stats.tableStats.front().entities == NUM_ENTITIES);
+        REQUIRE(stats.tableStats.front().type == "StatsPosition");
+    }
+
+    SECTION("Components")
+    {
+        const auto it = std::ranges::find(stats.componentStats, std::string("StatsPosition"),
+                                          &Hush::ComponentStats::name);
+
+        REQUIRE(it != stats.componentStats.end());
+        REQUIRE(it->size == sizeof(StatsPosition));
+        REQUIRE(it->tables == 3);
+        REQUIRE(it->entities == NUM_ENTITIES + 2);
+        REQUIRE(it->bytes >= sizeof(StatsPosition) * (NUM_ENTITIES + 2));
+    }
+
+    SECTION("Queries")
+    {
+        REQUIRE(stats.queries.size() == 1);
+        REQUIRE(stats.queries.front().terms == "StatsPosition");
+        REQUIRE(stats.queries.front().matchedTables == 3);
+        REQUIRE(stats.queries.front().matchedEntities == NUM_ENTITIES + 2);
+    }
+
+    SECTION("Structural changes")
+    {
+        REQUIRE(stats.tablesCreated >= 3);
+        REQUIRE(stats.structuralChangeTime.count() > 0);
+    }
+}
@@ -0,0 +1,197 @@
+/*! \file SparseStorage.test.cpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Sparse component storage test implementation
+*/
+#include <Entity.hpp>
+#include <Scene.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <span>
+#include <vector>
+
+struct SparseBody
+{
+    float position[4];
+    float velocity[4];
+};
+
+struct SparseHealth
+{
+    int value;
+};
+
+struct SparseSelected
+{
+    bool isSelected;
+};
+
+struct ArchetypeSelected
+{
+    bool isSelected;
+};
+
+template <>
+struct Hush::ComponentTraits::ComponentFlags<SparseHealth>
+{
+    static constexpr Hush::ComponentTraits::EComponentFlags value = Hush::ComponentTraits::EComponentFlags::Sparse;
+};
+
+template <>
+struct Hush::ComponentTraits::ComponentFlags<SparseSelected>
+{
+    static constexpr Hush::ComponentTraits::EComponentFlags value =
+        Hush::ComponentTraits::EComponentFlags::DontFragment;
+};
+
+TEST_CASE("Sparse storage", "[entity]")
+{
+    Hush::Scene scene(nullptr);
+
+    SECTION("Sparse components keep their address when the entity changes tables")
+    {
+        Hush::Entity entity = scene.CreateEntity();
+        SparseHealth *health = &entity.AddComponent<SparseHealth>();
+        health->value = 10;
+
+        entity.AddComponent<SparseBody>();
+        entity.AddComponent<ArchetypeSelected>();
+
+        REQUIRE(entity.GetComponent<SparseHealth>() == health);
+        REQUIRE(health->value == 10);
+    }
+
+    SECTION("Queries read sparse components of each entity")
+    {
+        constexpr int NUM_ENTITIES = 16;
+
+        for (int i = 0; i < NUM_ENTITIES; ++i)
+        {
+            Hush::Entity entity = scene.CreateEntity();
+            entity.AddComponent<SparseBody>();
+            entity.AddComponent<SparseHealth>().value = i;
+        }
+
+        int sum = 0;
+        scene.CreateQuery<SparseBody, SparseHealth>().Each([&](Hush::Entity &entity, SparseBody &, SparseHealth &health) {
+            REQUIRE(&health == entity.GetComponent<SparseHealth>());
+            sum += health.value;
+        });
+
+        REQUIRE(sum == NUM_ENTITIES * (NUM_ENTITIES - 1) / 2);
+    }
+
+    SECTION("Bulk creation fills sparse components across several pages")
+    {
+        // Recycled ids are not consecutive, and flecs sparse pages hold 4096 entities
+        for (int i = 0; i < 100; ++i)
+        {
+            scene.DestroyEntity(scene.CreateEntity());
+        }
+
+        constexpr std::size_t NUM_ENTITIES = 10000;
+        const std::span<const Hush::Entity::EntityId> ids =
+            scene.CreateEntities<SparseBody, SparseHealth>(NUM_ENTITIES, SparseBody{}, SparseHealth{42});
+        const std::vector<Hush::Entity::EntityId> entities(ids.begin(), ids.end());
+
+        REQUIRE(entities.size() == NUM_ENTITIES);
+        for (const Hush::Entity::EntityId id : entities)
+        {
+            REQUIRE(Hush::Entity(&scene, id).GetComponent<SparseHealth>()->value == 42);
+        }
+    }
+
+    SECTION("Non-fragmenting components can be toggled and queried")
+    {
+        constexpr std::size_t NUM_ENTITIES = 64;
+
+        std::vector<Hush::Entity> entities;
+        for (std::size_t i = 0; i < NUM_ENTITIES; ++i)
+        {
+            Hush::Entity &entity = entities.emplace_back(scene.CreateEntity());
+            entity.AddComponent<SparseBody>();
+        }
+
+        for (std::size_t i = 0; i < NUM_ENTITIES; i += 2)
+        {
+            entities[i].AddComponent<SparseSelected>().isSelected = true;
+        }
+
+        REQUIRE(entities[0].HasComponent<SparseSelected>());
+        REQUIRE(!entities[1].HasComponent<SparseSelected>());
+
+        entities[0].RemoveComponent<SparseSelected>();
+        REQUIRE(!entities[0].HasComponent<SparseSelected>());
+
+        std::size_t numSelected = 0;
+        scene.CreateQuery<SparseBody, SparseSelected>().Each(
+            [&](Hush::Entity &entity, SparseBody &, SparseSelected &selected) {
+                REQUIRE(&selected == entity.GetComponent<SparseSelected>());
+                REQUIRE(selected.isSelected);
+                ++numSelected;
+            });
+
+        REQUIRE(numSelected == NUM_ENTITIES / 2 - 1);
+    }
+}
+
+// Hidden from the default run, use `HushCoreTest "[.benchmark]"` to compare both storages.
+TEST_CASE("Sparse storage benchmark", "[.benchmark]")
+{
+    constexpr std::size_t NUM_ENTITIES = 10000;
+
+    Hush::Scene scene(nullptr);
+    std::vector<Hush::Entity> entities;
+
+    for (std::size_t i = 0; i < NUM_ENTITIES; ++i)
+    {
+        Hush::Entity &entity = entities.emplace_back(scene.CreateEntity());
+        entity.AddComponent<SparseBody>();
+    }
+
+    BENCHMARK("Toggle archetype component")
+    {
+        for (Hush::Entity &entity : entities)
+        {
+            entity.AddComponent<ArchetypeSelected>();
+        }
+        for (Hush::Entity &entity : entities)
+        {
+            entity.RemoveComponent<ArchetypeSelected>();
+        }
+    };
+
+    BENCHMARK("Toggle non-fragmenting component")
+    {
+        for (Hush::Entity &entity : entities)
+        {
+            entity.AddComponent<SparseSelected>();
+        }
+        for (Hush::Entity &entity : entities)
+        {
+            entity.RemoveComponent<SparseSelected>();
+        }
+    };
+
+    for (Hush::Entity &entity : entities)
+    {
+        entity.AddComponent<ArchetypeSelected>();
+        entity.AddComponent<SparseSelected>();
+    }
+
+    BENCHMARK("Iterate archetype component")
+    {
+        std::size_t count = 0;
+        scene.CreateQuery<SparseBody, ArchetypeSelected>().Each(
+            [&count](SparseBody &, ArchetypeSelected &) { ++count; });
+        return count;
+    };
+
+    BENCHMARK("Iterate non-fragmenting component")
+    {
+        std::size_t count = 0;
+        scene.CreateQuery<SparseBody, SparseSelected>().Each([&count](SparseBody &, SparseSelected &) { ++count; });
+        return count;
+    };
+}
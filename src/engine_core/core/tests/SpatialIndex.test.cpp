@@ -0,0 +1,182 @@
+/*! \file SpatialIndex.test.cpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Spatial index test implementation
+*/
+#include <Entity.hpp>
+#include <Scene.hpp>
+#include <SpatialIndex.hpp>
+#include <ThreadPool.hpp>
+#include <Transform.hpp>
+
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    Hush::Entity CreateBody(Hush::Scene &scene, const glm::vec3 &position, const glm::vec3 &extents = glm::vec3(0.5f))
+    {
+        Hush::Entity entity = scene.CreateEntity();
+        entity.AddComponent<Hush::LocalTransform>().matrix = glm::translate(glm::mat4(1.0f), position);
+        entity.AddComponent<Hush::WorldTransform>();
+        entity.AddComponent<Hush::SpatialBounds>().extents = extents;
+
+        return entity;
+    }
+
+    bool Contains(const std::vector<Hush::Entity::EntityId> &ids, const Hush::Entity &entity)
+    {
+        return std::ranges::find(ids, entity.GetId()) != ids.end();
+    }
+} // namespace
+
+TEST_CASE("Spatial index queries", "[spatial]")
+{
+    Hush::Scene scene(nullptr);
+
+    Hush::Entity near = CreateBody(scene, {1.0f, 0.0f, 0.0f});
+    Hush::Entity far = CreateBody(scene, {20.0f, 0.0f, 0.0f});
+    Hush::Entity huge = CreateBody(scene, {-100.0f, 0.0f, 0.0f}, glm::vec3(100.0f));
+
+    scene.PreRender();
+
+    REQUIRE(scene.GetSpatialIndex().GetEntityCount() == 3);
+
+    SECTION("Sphere")
+    {
+        const auto ids = scene.QuerySphere({0.0f, 0.0f, 0.0f}, 2.0f);
+
+        REQUIRE(ids.size() == 2);
+        REQUIRE(Contains(ids, near));
+        REQUIRE(Contains(ids, huge));
+    }
+
+    SECTION("Box spanning several cells reports each entity once")
+    {
+        const auto ids = scene.QueryAABB({0.5f, -1.0f, -1.0f}, {30.0f, 1.0f, 1.0f});
+
+        REQUIRE(ids.size() == 2);
+        REQUIRE(Contains(ids, near));
+        REQUIRE(Contains(ids, far));
+    }
+
+    SECTION("Ray hits are sorted by distance")
+    {
+        // The ray starts inside huge (x from -200 to 0), then enters near at x = 0.5 and far at x = 19.5.
+        const glm::vec3 origin = {-0.5f, 0.0f, 0.0f};
+        const auto ids = scene.QueryRay(origin, {1.0f, 0.0f, 0.0f}, 50.0f);
+
+        const auto entryDistance = [&origin](Hush::Entity &entity) {
+            const float position = entity.GetComponent<Hush::LocalTransform>()->matrix[3].x;
+            const float minX = position - entity.GetComponent<Hush::SpatialBounds>()->extents.x;
+            return std::max(minX - origin.x, 0.0f);
+        };
+
+        REQUIRE(entryDistance(huge) < entryDistance(near));
+        REQUIRE(entryDistance(near) < entryDistance(far));
+
+        REQUIRE(ids.size() == 3);
+        REQUIRE(ids[0] == huge.GetId());
+        REQUIRE(ids[1] == near.GetId());
+        REQUIRE(ids[2] == far.GetId());
+    }
+
+    SECTION("Moved entities are updated")
+    {
+        auto *localTransform = far.GetComponent<Hush::LocalTransform>();
+        localTransform->matrix = glm::translate(glm::mat4(1.0f), glm::vec3{2.0f, 0.0f, 0.0f});
+        localTransform->isDirty = true;
+
+        scene.PreRender();
+
+        REQUIRE(Contains(scene.QuerySphere({0.0f, 0.0f, 0.0f}, 2.0f), far));
+        REQUIRE(scene.QueryAABB({15.0f, -1.0f, -1.0f}, {25.0f, 1.0f, 1.0f}).empty());
+    }
+
+    SECTION("Entities moved after static frames are updated")
+    {
+        // Nothing changes, so the tables are skipped.
+        scene.PreRender();
+        scene.PreRender();
+
+        REQUIRE(Contains(scene.QueryAABB({15.0f, -1.0f, -1.0f}, {25.0f, 1.0f, 1.0f}), far));
+
+        auto *localTransform = far.GetComponent<Hush::LocalTransform>();
+        localTransform->matrix = glm::translate(glm::mat4(1.0f), glm::vec3{2.0f, 0.0f, 0.0f});
+        localTransform->isDirty = true;
+
+        scene.PreRender();
+
+        REQUIRE(Contains(scene.QuerySphere({0.0f, 0.0f, 0.0f}, 2.0f), far));
+        REQUIRE(scene.QueryAABB({15.0f, -1.0f, -1.0f}, {25.0f, 1.0f, 1.0f}).empty());
+    }
+
+    SECTION("Changed bounds are updated")
+    {
+        auto *bounds = far.GetComponent<Hush::SpatialBounds>();
+        bounds->extents = glm::vec3(18.0f);
+        bounds->isDirty = true;
+
+        scene.PreRender();
+
+        REQUIRE(Contains(scene.QuerySphere({0.0f, 0.0f, 0.0f}, 2.0f), far));
+    }
+
+    SECTION("Removed entities leave the index")
+    {
+        far.RemoveComponent<Hush::SpatialBounds>();
+        scene.DestroyEntity(std::move(near));
+
+        REQUIRE(scene.GetSpatialIndex().GetEntityCount() == 1);
+        REQUIRE(scene.QueryAABB({0.5f, -1.0f, -1.0f}, {30.0f, 1.0f, 1.0f}).empty());
+    }
+}
+
+TEST_CASE("Spatial index batch queries", "[spatial]")
+{
+    constexpr std::size_t NUM_BODIES = 1024;
+
+    Hush::Threading::ThreadPool threadPool(4);
+    threadPool.Start();
+
+    Hush::Scene scene(nullptr);
+    scene.SetThreadPool(&threadPool);
+
+    std::vector<Hush::Entity> bodies;
+    std::vector<Hush::SpatialQuery> queries;
+
+    for (std::size_t i = 0; i < NUM_BODIES; ++i)
+    {
+        const glm::vec3 position(static_cast<float>(i) * 4.0f, 0.0f, 0.0f);
+
+        bodies.push_back(CreateBody(scene, position));
+        queries.push_back(Hush::SpatialQuery::Sphere(position, 1.0f));
+    }
+
+    scene.PreRender();
+
+    std::vector<std::vector<Hush::Entity::EntityId>> results(queries.size());
+
+    SECTION("From the calling thread")
+    {
+        scene.GetSpatialIndex().QueryBatch(queries, results);
+    }
+
+    SECTION("From a job of the pool")
+    {
+        // The batch runs in the worker instead of waiting for workers that may all be busy.
+        const auto runBatch = [&]() { scene.GetSpatialIndex().QueryBatch(queries, results); };
+
+        auto job = threadPool.ScheduleFunction(runBatch);
+        job.Wait();
+    }
+
+    for (std::size_t i = 0; i < NUM_BODIES; ++i)
+    {
+        REQUIRE(results[i].size() == 1);
+        REQUIRE(results[i].front() == bodies[i].GetId());
+    }
+}
@@ -0,0 +1,98 @@
+/*! \file Staging.test.cpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Staged scene sections test implementation
+*/
+#include <Entity.hpp>
+#include <Scene.hpp>
+#include <ThreadPool.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <span>
+#include <vector>
+
+struct StagedCounter
+{
+    int value;
+};
+
+struct StagedTag
+{
+    bool isSet;
+};
+
+TEST_CASE("Staged sections", "[scene]")
+{
+    constexpr std::size_t NUM_ENTITIES = 4096;
+    constexpr std::size_t NUM_JOBS = 4;
+
+    Hush::Threading::ThreadPool threadPool(NUM_JOBS);
+    threadPool.Start();
+
+    Hush::Scene scene(nullptr);
+    scene.SetThreadPool(&threadPool);
+
+    // Components must be registered before the staged section.
+    (void)scene.GetComponentId<StagedTag>();
+    const std::span<const Hush::Entity::EntityId> created = scene.CreateEntities<StagedCounter>(NUM_ENTITIES);
+    const std::vector<Hush::Entity::EntityId> entities(created.begin(), created.end());
+
+    SECTION("Workers modify the scene without locks")
+    {
+        std::vector<std::span<const Hush::Entity::EntityId>> ranges;
+        for (std::size_t i = 0; i < NUM_JOBS; ++i)
+        {
+            ranges.push_back(std::span(entities).subspan(i * NUM_ENTITIES / NUM_JOBS, NUM_ENTITIES / NUM_JOBS));
+        }
+
+        const auto modifyRange = [&scene](std::span<const Hush::Entity::EntityId> range) {
+            for (const Hush::Entity::EntityId entityId : range)
+            {
+                Hush::Entity entity(&scene, entityId);
+                entity.GetComponent<StagedCounter>()->value = 1;
+                entity.AddComponent<StagedTag>().isSet = true;
+            }
+        };
+
+        scene.BeginStaged();
+        REQUIRE(scene.IsStaged());
+
+        std::vector<Hush::Threading::Job> jobs;
+        for (const auto &range : ranges)
+        {
+            jobs.push_back(threadPool.ScheduleFunction(modifyRange, range));
+        }
+
+        for (Hush::Threading::Job &job : jobs)
+        {
+            Hush::Threading::Wait(job);
+        }
+
+        // Structural changes are not visible until the section ends.
+        REQUIRE(!Hush::Entity(&scene, entities.front()).HasComponent<StagedTag>());
+
+        scene.EndStaged();
+
+        std::size_t numTagged = 0;
+        scene.CreateQuery<StagedCounter, StagedTag>().Each([&](StagedCounter &counter, StagedTag &tag) {
+            REQUIRE(counter.value == 1);
+            REQUIRE(tag.isSet);
+            ++numTagged;
+        });
+
+        REQUIRE(numTagged == NUM_ENTITIES);
+    }
+
+    SECTION("The calling thread uses its own stage")
+    {
+        scene.BeginStaged();
+
+        Hush::Entity entity = scene.CreateEntity();
+        entity.AddComponent<StagedTag>().isSet = true;
+
+        scene.EndStaged();
+
+        REQUIRE(entity.HasComponent<StagedTag>());
+        REQUIRE(entity.GetComponent<StagedTag>()->isSet);
+    }
+}
@@ -0,0 +1,134 @@
+/*! \file Transform.test.cpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Transform hierarchy test implementation
+*/
+#include <Entity.hpp>
+#include <Scene.hpp>
+#include <ThreadPool.hpp>
+#include <Transform.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <vector>
+
+namespace
+{
+    Hush::Entity CreateNode(Hush::Scene &scene, const glm::vec3 &translation, Hush::Entity::EntityId parent = 0)
+    {
+        Hush::Entity entity = scene.CreateEntity();
+        entity.AddComponent<Hush::LocalTransform>().matrix = glm::translate(glm::mat4(1.0f), translation);
+        entity.AddComponent<Hush::WorldTransform>();
+
+        if (parent != 0)
+        {
+            entity.SetParent(parent);
+        }
+
+        return entity;
+    }
+
+    glm::vec3 GetWorldPosition(Hush::Entity &entity)
+    {
+        return glm::vec3(entity.GetComponent<Hush::WorldTransform>()->matrix[3]);
+    }
+} // namespace
+
+TEST_CASE("Transform hierarchy", "[transform]")
+{
+    Hush::Scene scene(nullptr);
+
+    Hush::Entity root = CreateNode(scene, {1.0f, 0.0f, 0.0f});
+    Hush::Entity child = CreateNode(scene, {0.0f, 1.0f, 0.0f}, root.GetId());
+    Hush::Entity grandChild = CreateNode(scene, {0.0f, 0.0f, 1.0f}, child.GetId());
+
+    scene.PreRender();
+
+    SECTION("World transforms are propagated")
+    {
+        REQUIRE(child.GetParent() == root.GetId());
+        REQUIRE(GetWorldPosition(root) == glm::vec3(1.0f, 0.0f, 0.0f));
+        REQUIRE(GetWorldPosition(child) == glm::vec3(1.0f, 1.0f, 0.0f));
+        REQUIRE(GetWorldPosition(grandChild) == glm::vec3(1.0f, 1.0f, 1.0f));
+    }
+
+    SECTION("Clean subtrees are not recomputed")
+    {
+        const std::uint64_t updatedFrame = grandChild.GetComponent<Hush::WorldTransform>()->updatedFrame;
+
+        scene.PreRender();
+
+        REQUIRE(grandChild.GetComponent<Hush::WorldTransform>()->updatedFrame == updatedFrame);
+    }
+
+    SECTION("Dirty parents update their children")
+    {
+        auto *localTransform = root.GetComponent<Hush::LocalTransform>();
+        localTransform->matrix = glm::translate(glm::mat4(1.0f), glm::vec3{2.0f, 0.0f, 0.0f});
+        localTransform->isDirty = true;
+
+        scene.PreRender();
+
+        REQUIRE(GetWorldPosition(grandChild) == glm::vec3(2.0f, 1.0f, 1.0f));
+    }
+
+    SECTION("Changes after static frames are propagated")
+    {
+        // Nothing changes, so the tables are skipped.
+        scene.PreRender();
+        scene.PreRender();
+
+        const std::uint64_t rootUpdatedFrame = root.GetComponent<Hush::WorldTransform>()->updatedFrame;
+
+        auto *localTransform = child.GetComponent<Hush::LocalTransform>();
+        localTransform->matrix = glm::translate(glm::mat4(1.0f), glm::vec3{0.0f, 3.0f, 0.0f});
+        localTransform->isDirty = true;
+
+        scene.PreRender();
+
+        REQUIRE(GetWorldPosition(child) == glm::vec3(1.0f, 3.0f, 0.0f));
+        REQUIRE(GetWorldPosition(grandChild) == glm::vec3(1.0f, 3.0f, 1.0f));
+        REQUIRE(root.GetComponent<Hush::WorldTransform>()->updatedFrame == rootUpdatedFrame);
+    }
+
+    SECTION("Reparenting")
+    {
+        grandChild.SetParent(root.GetId());
+
+        scene.PreRender();
+
+        REQUIRE(GetWorldPosition(grandChild) == glm::vec3(1.0f, 0.0f, 1.0f));
+    }
+}
+
+TEST_CASE("Parallel transform propagation", "[transform]")
+{
+    constexpr std::size_t NUM_ROOTS = 16;
+    constexpr std::size_t NUM_CHILDREN = 1024;
+
+    Hush::Threading::ThreadPool threadPool(4);
+    threadPool.Start();
+
+    Hush::Scene scene(nullptr);
+    scene.SetThreadPool(&threadPool);
+
+    std::vector<Hush::Entity> children;
+
+    for (std::size_t i = 0; i < NUM_ROOTS; ++i)
+    {
+        Hush::Entity root = CreateNode(scene, {static_cast<float>(i), 0.0f, 0.0f});
+
+        for (std::size_t j = 0; j < NUM_CHILDREN; ++j)
+        {
+            children.push_back(CreateNode(scene, {0.0f, static_cast<float>(j), 0.0f}, root.GetId()));
+        }
+    }
+
+    scene.PreRender();
+
+    for (std::size_t i = 0; i < children.size(); ++i)
+    {
+        const glm::vec3 expected(static_cast<float>(i / NUM_CHILDREN), static_cast<float>(i % NUM_CHILDREN), 0.0f);
+        REQUIRE(GetWorldPosition(children[i]) == expected);
+    }
+}
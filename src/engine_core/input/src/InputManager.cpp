@@ -2,6 +2,11 @@
 #include "Logger.hpp"
 #include <magic_enum/magic_enum.hpp>
 #include <SDL2/SDL_mouse.h>
+#include <SDL2/SDL_timer.h>
+#include <algorithm>
+
+/// Weight of the newest sample in the average input latency
+constexpr float INPUT_LATENCY_SMOOTHING = 0.1f;
 
 #define IS_CURRENTLY_PRESSED(key) (key == EKeyState::Pressed || key == EKeyState::Held)
 
@@ -10,15 +15,23 @@
 std::unordered_map<EKeyCode, KeyData> Hush::InputManager::S_KEY_DATA_BY_CODE = {};
 // NOLINTNEXTLINE
 Hush::MouseData Hush::InputManager::S_MOUSE_DATA = {};
+// NOLINTNEXTLINE
+std::unordered_set<EKeyCode> Hush::InputManager::S_KEYS_PRESSED_THIS_FRAME = {};
+// NOLINTNEXTLINE
+std::unordered_set<EMouseButton> Hush::InputManager::S_MOUSE_BUTTONS_PRESSED_THIS_FRAME = {};
+// NOLINTNEXTLINE
+Hush::InputLatencyStats Hush::InputManager::S_INPUT_LATENCY = {};
 
 bool Hush::InputManager::IsKeyDown(EKeyCode key)
 {
-	return KeyMapContains(key) && IS_CURRENTLY_PRESSED(S_KEY_DATA_BY_CODE[key].currentState);
+	return S_KEYS_PRESSED_THIS_FRAME.contains(key) ||
+		(KeyMapContains(key) && IS_CURRENTLY_PRESSED(S_KEY_DATA_BY_CODE[key].currentState));
 }
 
 bool Hush::InputManager::IsKeyDownThisFrame(EKeyCode key)
 {
-	return KeyMapContains(key) && S_KEY_DATA_BY_CODE[key].currentState == EKeyState::Pressed;
+	return S_KEYS_PRESSED_THIS_FRAME.contains(key) ||
+		(KeyMapContains(key) && S_KEY_DATA_BY_CODE[key].currentState == EKeyState::Pressed);
 }
 
 bool Hush::InputManager::IsKeyUp(EKeyCode key)
@@ -33,7 +46,8 @@ bool Hush::InputManager::IsKeyHeld(EKeyCode key)
 
 bool Hush::InputManager::GetMouseButtonPressed(EMouseButton button)
 {
-	return MouseMapContains(button) && IS_CURRENTLY_PRESSED(S_MOUSE_DATA.mouseButtonMap[button]);
+	return S_MOUSE_BUTTONS_PRESSED_THIS_FRAME.contains(button) ||
+		(MouseMapContains(button) && IS_CURRENTLY_PRESSED(S_MOUSE_DATA.mouseButtonMap[button]));
 }
 
 glm::vec2 Hush::InputManager::GetMousePosition()
@@ -93,6 +107,62 @@ void Hush::InputManager::ResetMouseAcceleration()
 	S_MOUSE_DATA.wheelAcceleration.y = 0.f;
 }
 
+void Hush::InputManager::ProcessEventBatch(const InputEventBatch& batch)
+{
+	ResetMouseAcceleration();
+	S_KEYS_PRESSED_THIS_FRAME.clear();
+	S_MOUSE_BUTTONS_PRESSED_THIS_FRAME.clear();
+
+	for (const ButtonEvent& buttonEvent : batch.buttonEvents)
+	{
+		if (const auto* keyEvent = std::get_if<KeyEvent>(&buttonEvent))
+		{
+			SendKeyEvent(keyEvent->key, keyEvent->state);
+
+			// Repeated key downs become Held, only the first one counts as a press
+			const auto mappedKeyCode = static_cast<EKeyCode>(keyEvent->key);
+			if (S_KEY_DATA_BY_CODE[mappedKeyCode].currentState == EKeyState::Pressed)
+			{
+				S_KEYS_PRESSED_THIS_FRAME.insert(mappedKeyCode);
+			}
+			continue;
+		}
+
+		const auto& mouseButtonEvent = std::get<MouseButtonEvent>(buttonEvent);
+		SendMouseButtonEvent(mouseButtonEvent.button, mouseButtonEvent.state);
+
+		if (mouseButtonEvent.state == EKeyState::Pressed)
+		{
+			S_MOUSE_BUTTONS_PRESSED_THIS_FRAME.insert(static_cast<EMouseButton>(mouseButtonEvent.button));
+		}
+	}
+
+	if (batch.hasMouseMotion)
+	{
+		SendMouseMovementEvent(batch.mousePositionX, batch.mousePositionY, batch.mouseDeltaX, batch.mouseDeltaY);
+	}
+
+	SendWheelEvent(batch.wheelDelta.x, batch.wheelDelta.y);
+}
+
+void Hush::InputManager::RecordInputLatency(uint32_t eventTimestamp)
+{
+	// SDL timestamps wrap around after ~49 days, unsigned subtraction handles it
+	const auto latency = static_cast<float>(SDL_GetTicks() - eventTimestamp);
+
+	S_INPUT_LATENCY.lastMilliseconds = latency;
+	S_INPUT_LATENCY.averageMilliseconds = S_INPUT_LATENCY.samples == 0
+		? latency
+		: S_INPUT_LATENCY.averageMilliseconds + (latency - S_INPUT_LATENCY.averageMilliseconds) * INPUT_LATENCY_SMOOTHING;
+	S_INPUT_LATENCY.maxMilliseconds = std::max(S_INPUT_LATENCY.maxMilliseconds, latency);
+	S_INPUT_LATENCY.samples++;
+}
+
+const Hush::InputLatencyStats& Hush::InputManager::GetInputLatency()
+{
+	return S_INPUT_LATENCY;
+}
+
 void Hush::InputManager::SetCursorLock(ECursorLockMode lockMode)
 {
 	SDL_SetRelativeMouseMode(static_cast<SDL_bool>(lockMode));
@@ -5,11 +5,13 @@
 */
 
 #pragma once
+#include "definitions/InputEventBatch.hpp"
 #include "definitions/KeyData.hpp"
 #include "definitions/MouseButton.hpp"
 #include "definitions/MouseData.hpp"
 #include <glm/vec2.hpp>
 #include <unordered_map>
+#include <unordered_set>
 namespace Hush
 {
 
@@ -21,10 +23,11 @@ namespace Hush
     class InputManager
     {
     public:
-        /// @brief Evaluates to true whilst the key is pressed down 
+        /// @brief Evaluates to true whilst the key is pressed down, and the frame of a press released in that same frame
         static bool IsKeyDown(EKeyCode key);
 
-        /// @brief Evaluates to true the frame the key is identified as EKeyState::Pressed
+        /// @brief Evaluates to true the frame the key is identified as EKeyState::Pressed, even if it was released
+        /// before the end of the frame
         static bool IsKeyDownThisFrame(EKeyCode key);
 
         /// @brief Evaluates to true the frame the key is identified as EKeyState::Release
@@ -33,7 +36,8 @@ namespace Hush
         /// @brief Evaluates to true as long as the key is identified asEKeyState::Held
         static bool IsKeyHeld(EKeyCode key);
 
-        /// @brief Evaluates to true for as long as the mouse button is pressed
+        /// @brief Evaluates to true for as long as the mouse button is pressed, and the frame of a click released in
+        /// that same frame
         static bool GetMouseButtonPressed(EMouseButton button);
 
         /// @brief Gets the vector of the mouse's position in pixels
@@ -56,6 +60,18 @@ namespace Hush
 
         static void ResetMouseAcceleration();
 
+        /// @brief Applies the events drained from SDL in a frame in order, replacing the mouse acceleration and the
+        /// presses of the last frame
+        static void ProcessEventBatch(const InputEventBatch& batch);
+
+        /// @brief Records the latency of an event batch. Call it once the frame that processed the batch has been
+        /// submitted for presentation
+        /// @param eventTimestamp SDL timestamp of the oldest event of the batch, in milliseconds
+        static void RecordInputLatency(uint32_t eventTimestamp);
+
+        /// @brief Gets the latency from input events to the submission of the frame that processed them
+        static const InputLatencyStats& GetInputLatency();
+
         static void SetCursorLock(ECursorLockMode lockMode);
 
     private:
@@ -66,6 +82,17 @@ namespace Hush
         // NOLINTNEXTLINE
         static MouseData S_MOUSE_DATA;
 
+        /// @brief Keys and buttons pressed during the last processed batch. A press followed by a release in the same
+        /// batch leaves the state as Released, these keep the press visible for that frame
+        // NOLINTNEXTLINE
+        static std::unordered_set<EKeyCode> S_KEYS_PRESSED_THIS_FRAME;
+
+        // NOLINTNEXTLINE
+        static std::unordered_set<EMouseButton> S_MOUSE_BUTTONS_PRESSED_THIS_FRAME;
+
+        // NOLINTNEXTLINE
+        static InputLatencyStats S_INPUT_LATENCY;
+
         static void UpdateKeyStateFromData(KeyData& keyData, EKeyState incomingState);
 
         static bool KeyMapContains(EKeyCode key);
@@ -0,0 +1,76 @@
+/*! \file InputEventBatch.hpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Input events drained from SDL in a single frame
+*/
+
+#pragma once
+#include "KeyCode.hpp"
+#include "KeyStates.hpp"
+#include "MouseButton.hpp"
+#include <cstdint>
+#include <glm/vec2.hpp>
+#include <variant>
+#include <vector>
+
+namespace Hush {
+    struct KeyEvent
+    {
+        KeyCode key;
+        EKeyState state;
+    };
+
+    struct MouseButtonEvent
+    {
+        MouseButton button;
+        EKeyState state;
+    };
+
+    /// @brief Key or mouse button event. Both kinds go in the same list so their relative order is kept
+    using ButtonEvent = std::variant<KeyEvent, MouseButtonEvent>;
+
+    /// @brief Events of a frame, in the order they were received. Mouse motion and wheel events are coalesced: only
+    /// the last position is kept, and their deltas are added up
+    struct InputEventBatch
+    {
+        std::vector<ButtonEvent> buttonEvents;
+
+        bool hasMouseMotion = false;
+        int32_t mousePositionX = 0;
+        int32_t mousePositionY = 0;
+        int32_t mouseDeltaX = 0;
+        int32_t mouseDeltaY = 0;
+
+        glm::vec2 wheelDelta { 0.0f };
+
+        /// @brief Number of SDL events drained, before coalescing
+        uint32_t eventCount = 0;
+
+        /// @brief SDL timestamp of the oldest event, in milliseconds. Only meaningful if eventCount is not 0
+        uint32_t oldestEventTimestamp = 0;
+
+        void Clear()
+        {
+            this->buttonEvents.clear();
+            this->hasMouseMotion = false;
+            this->mouseDeltaX = 0;
+            this->mouseDeltaY = 0;
+            this->wheelDelta = glm::vec2 { 0.0f };
+            this->eventCount = 0;
+            this->oldestEventTimestamp = 0;
+        }
+    };
+
+    /// @brief Time from an input event to the submission for presentation of the frame that processed it
+    struct InputLatencyStats
+    {
+        float lastMilliseconds = 0.0f;
+
+        /// @brief Exponential moving average
+        float averageMilliseconds = 0.0f;
+
+        float maxMilliseconds = 0.0f;
+
+        uint64_t samples = 0;
+    };
+}
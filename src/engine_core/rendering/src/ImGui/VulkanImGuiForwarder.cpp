@@ -56,9 +56,41 @@ void Hush::VulkanImGuiForwarder::Dispose() noexcept
     ImGui_ImplVulkan_Shutdown();
 }
 
-void Hush::VulkanImGuiForwarder::RenderFrame(VkCommandBuffer cmd)
+void Hush::VulkanImGuiForwarder::RenderFrame(VkCommandBuffer cmd, ImDrawData *drawData)
 {
-    ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), cmd);
+    if (!drawData->Valid)
+    {
+        return;
+    }
+
+    ImGui_ImplVulkan_RenderDrawData(drawData, cmd);
+}
+
+void Hush::VulkanImGuiForwarder::CopyDrawData(ImDrawData *destination)
+{
+    ReleaseDrawData(destination);
+
+    const ImDrawData *source = ImGui::GetDrawData();
+    if (source == nullptr || !source->Valid)
+    {
+        return;
+    }
+
+    *destination = *source;
+    for (ImDrawList *&drawList : destination->CmdLists)
+    {
+        drawList = drawList->CloneOutput();
+    }
+}
+
+void Hush::VulkanImGuiForwarder::ReleaseDrawData(ImDrawData *drawData)
+{
+    for (ImDrawList *drawList : drawData->CmdLists)
+    {
+        IM_DELETE(drawList);
+    }
+
+    drawData->Clear();
 }
 
 ImGui_ImplVulkan_InitInfo Hush::VulkanImGuiForwarder::CreateInitData(VulkanRenderer *vulkanRenderer) const noexcept
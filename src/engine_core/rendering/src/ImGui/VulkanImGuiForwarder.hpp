@@ -24,7 +24,16 @@ namespace Hush
 
         void Dispose() noexcept override;
 
-        void RenderFrame(VkCommandBuffer cmd);
+        /// @brief Records the given UI draw data
+        void RenderFrame(VkCommandBuffer cmd, ImDrawData *drawData);
+
+        /// @brief Copies the draw data of the last rendered ImGui frame. ImGui reuses its draw lists on the next
+        /// frame, the copy stays valid until it is released or overwritten
+        /// @param destination Draw data to copy to, its previous draw lists are released
+        void CopyDrawData(ImDrawData *destination);
+
+        /// @brief Releases the draw lists of a copy made with CopyDrawData
+        static void ReleaseDrawData(ImDrawData *drawData);
 
       private:
         [[nodiscard]] ImGui_ImplVulkan_InitInfo CreateInitData(VulkanRenderer *vulkanRenderer) const noexcept;
@@ -0,0 +1,102 @@
+/*! \file NullRenderer.cpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Renderer that draws nothing, for headless runs
+*/
+
+#include "NullRenderer.hpp"
+#include "WindowRenderer.hpp"
+
+#include <imgui/imgui.h>
+
+Hush::NullRenderer::NullRenderer()
+    : IRenderer(nullptr)
+{
+    this->CreateSwapChain(DEFAULT_WINDOW_WIDTH, DEFAULT_WINDOW_HEIGHT);
+}
+
+Hush::NullRenderer::~NullRenderer()
+{
+    if (this->m_ownsImGuiContext)
+    {
+        ImGui::DestroyContext();
+    }
+}
+
+void Hush::NullRenderer::CreateSwapChain(uint32_t width, uint32_t height)
+{
+    this->m_width = width;
+    this->m_height = height;
+}
+
+void Hush::NullRenderer::InitImGui()
+{
+    if (ImGui::GetCurrentContext() == nullptr)
+    {
+        ImGui::CreateContext();
+        this->m_ownsImGuiContext = true;
+    }
+
+    ImGuiIO &io = ImGui::GetIO();
+    io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
+    io.DisplaySize = ImVec2(static_cast<float>(this->m_width), static_cast<float>(this->m_height));
+    // Nobody saves the layout of a headless run
+    io.IniFilename = nullptr;
+
+    // ImGui refuses to start a frame until the font atlas is built, even without a backend to upload it to
+    unsigned char *pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+}
+
+void Hush::NullRenderer::Draw(float delta)
+{
+    this->Extract(delta);
+    this->Submit();
+}
+
+void Hush::NullRenderer::Extract(float delta)
+{
+    this->UpdateSceneObjects(delta);
+    // Applications are not required to render the UI frame they started
+    this->EndUIFrame();
+}
+
+void Hush::NullRenderer::Submit()
+{
+}
+
+void Hush::NullRenderer::UpdateSceneObjects(float delta)
+{
+    (void)delta;
+}
+
+void Hush::NullRenderer::InitRendering()
+{
+}
+
+void Hush::NullRenderer::NewUIFrame() const noexcept
+{
+    ImGui::NewFrame();
+}
+
+void Hush::NullRenderer::EndUIFrame() const noexcept
+{
+    ImGui::EndFrame();
+}
+
+void Hush::NullRenderer::HandleEvents(std::span<const SDL_Event> events) noexcept
+{
+    (void)events;
+}
+
+void Hush::NullRenderer::SetThreadPool(Threading::ThreadPool *threadPool) noexcept
+{
+    (void)threadPool;
+}
+
+void *Hush::NullRenderer::GetWindowContext() const noexcept
+{
+    return nullptr;
+}
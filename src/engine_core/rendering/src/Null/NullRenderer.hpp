@@ -0,0 +1,58 @@
+/*! \file NullRenderer.hpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Renderer that draws nothing, for headless runs
+*/
+
+#pragma once
+
+#include "Renderer.hpp"
+
+namespace Hush
+{
+    /// @brief Renderer without a window or a GPU, used by the headless mode of the engine. It keeps an ImGui context
+    /// so applications can build their UI as usual, the draw data is just discarded
+    class NullRenderer final : public IRenderer
+    {
+      public:
+        NullRenderer();
+
+        NullRenderer(const NullRenderer &) = delete;
+        NullRenderer &operator=(const NullRenderer &) = delete;
+        NullRenderer(NullRenderer &&) = delete;
+        NullRenderer &operator=(NullRenderer &&) = delete;
+
+        ~NullRenderer() override;
+
+        void CreateSwapChain(uint32_t width, uint32_t height) override;
+
+        void InitImGui() override;
+
+        void Draw(float delta) override;
+
+        void Extract(float delta) override;
+
+        void Submit() override;
+
+        void UpdateSceneObjects(float delta) override;
+
+        void InitRendering() override;
+
+        void NewUIFrame() const noexcept override;
+
+        void EndUIFrame() const noexcept override;
+
+        void HandleEvents(std::span<const SDL_Event> events) noexcept override;
+
+        void SetThreadPool(Threading::ThreadPool *threadPool) noexcept override;
+
+        [[nodiscard]] void *GetWindowContext() const noexcept override;
+
+      private:
+        uint32_t m_width = 0u;
+        uint32_t m_height = 0u;
+
+        /// @brief Whether the ImGui context was created by this renderer
+        bool m_ownsImGuiContext = false;
+    };
+} // namespace Hush
@@ -0,0 +1,57 @@
+#include "RenderThread.hpp"
+#include "Assertions.hpp"
+
+#include <utility>
+
+Hush::RenderThread::RenderThread(IRenderer *renderer)
+    : m_renderer(renderer),
+      m_thread([this](std::stop_token stopToken) { this->ThreadFunction(std::move(stopToken)); })
+{
+}
+
+Hush::RenderThread::~RenderThread()
+{
+    this->WaitIdle();
+    this->m_thread.request_stop();
+}
+
+void Hush::RenderThread::Kick()
+{
+    {
+        std::lock_guard lock(this->m_mutex);
+        HUSH_ASSERT(!this->m_hasPendingFrame, "Kicked a frame while the previous one is still being submitted");
+        this->m_hasPendingFrame = true;
+    }
+
+    this->m_condition.notify_all();
+}
+
+void Hush::RenderThread::WaitIdle()
+{
+    std::unique_lock lock(this->m_mutex);
+    this->m_condition.wait(lock, [this]() { return !this->m_hasPendingFrame; });
+}
+
+void Hush::RenderThread::ThreadFunction(std::stop_token stopToken)
+{
+    while (true)
+    {
+        {
+            std::unique_lock lock(this->m_mutex);
+            if (!this->m_condition.wait(lock, stopToken, [this]() { return this->m_hasPendingFrame; }))
+            {
+                return;
+            }
+        }
+
+        // The main thread does not touch the renderer until the frame is marked as done
+        this->m_renderer->Submit();
+
+        {
+            std::lock_guard lock(this->m_mutex);
+            this->m_hasPendingFrame = false;
+        }
+
+        this->m_condition.notify_all();
+    }
+}
@@ -0,0 +1,57 @@
+/*! \file RenderThread.hpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Thread that submits the frames extracted by the main thread
+*/
+
+#pragma once
+
+#include "Renderer.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+
+namespace Hush
+{
+    /// @brief Submits frames on a dedicated thread, so the main thread can simulate frame N+1 while frame N is being
+    /// recorded and presented. At most one frame is in flight: the main thread calls WaitIdle before extracting the
+    /// next snapshot, then Kick to hand it over
+    class RenderThread
+    {
+      public:
+        /// @param renderer Renderer to submit the frames with, it must outlive the render thread
+        explicit RenderThread(IRenderer *renderer);
+
+        RenderThread(const RenderThread &) = delete;
+        RenderThread &operator=(const RenderThread &) = delete;
+        RenderThread(RenderThread &&) = delete;
+        RenderThread &operator=(RenderThread &&) = delete;
+
+        /// @brief Waits for the pending frame and stops the thread
+        ~RenderThread();
+
+        /// @brief Hands the extracted snapshot to the render thread, which calls IRenderer::Submit with it. The
+        /// previous frame must be done, see WaitIdle
+        void Kick();
+
+        /// @brief Blocks until the render thread is done with the last kicked frame. After it returns, the renderer can
+        /// be used from the calling thread until the next Kick
+        void WaitIdle();
+
+      private:
+        void ThreadFunction(std::stop_token stopToken);
+
+        IRenderer *m_renderer;
+
+        std::mutex m_mutex;
+        std::condition_variable_any m_condition;
+
+        /// @brief Whether there is a frame kicked and not submitted yet
+        bool m_hasPendingFrame = false;
+
+        // Declared last, so it is joined before the rest of the members are destroyed
+        std::jthread m_thread;
+    };
+} // namespace Hush
@@ -8,9 +8,15 @@
 
 #include <SDL2/SDL.h>
 #include <cstdint>
+#include <span>
 
 namespace Hush
 {
+    namespace Threading
+    {
+        class ThreadPool;
+    }
+
     /// @brief A common interface for renderers, Hush supports many graphics APIs, and this is the interface
     /// that allows us to standardize all of them...
     /// All renderers MUST bind to SDL and ImGUI, the latter can be done through the IImGuiForwarder interface
@@ -33,8 +39,17 @@ namespace Hush
 
         virtual void InitImGui() = 0;
 
+        /// @brief Extracts and submits a frame, see Extract and Submit
         virtual void Draw(float delta) = 0;
 
+        /// @brief Copies everything the next frame needs (draw lists, camera, UI draw data) into a snapshot owned by
+        /// the renderer. Runs on the main thread, while no Submit is running
+        virtual void Extract(float delta) = 0;
+
+        /// @brief Records and presents the last extracted snapshot. It only reads the snapshot, so it can run on a
+        /// render thread while the main thread simulates the next frame (see RenderThread)
+        virtual void Submit() = 0;
+
         /// @brief Each renderer will have to implement a way of updating all the objects
         /// inside of the scene, these are instances of the IRenderableNode, which is a common interface
         /// for all renderers, but additional render data (i.e drawContext) might be needed by their underlying implementation
@@ -49,7 +64,12 @@ namespace Hush
 
         virtual void EndUIFrame() const noexcept = 0;
 
-        virtual void HandleEvent(const SDL_Event *event) noexcept = 0;
+        /// @brief Handles the events of a frame, in the order they were received
+        virtual void HandleEvents(std::span<const SDL_Event> events) noexcept = 0;
+
+        /// @brief Sets the thread pool the renderer may split its per frame work across
+        /// @param threadPool Thread pool, or nullptr to do all the work in the calling thread
+        virtual void SetThreadPool(Threading::ThreadPool *threadPool) noexcept = 0;
 
         [[nodiscard]] virtual void *GetWindowContext() const noexcept = 0;
     };
@@ -0,0 +1,167 @@
+/*! \file Frustum.cpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief View frustum and bounding volumes used for visibility culling
+*/
+
+#include "Frustum.hpp"
+#include "Assertions.hpp"
+
+#include <ThreadPool.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HUSH_FRUSTUM_SSE 1
+#include <xmmintrin.h>
+#else
+#define HUSH_FRUSTUM_SSE 0
+#endif
+
+Hush::Bounds Hush::Bounds::FromPoints(std::span<const glm::vec3> positions) noexcept
+{
+    if (positions.empty())
+    {
+        return {};
+    }
+
+    glm::vec3 minPos = positions.front();
+    glm::vec3 maxPos = positions.front();
+
+    for (const glm::vec3 &position : positions)
+    {
+        minPos = glm::min(minPos, position);
+        maxPos = glm::max(maxPos, position);
+    }
+
+    Bounds bounds;
+    bounds.origin = (maxPos + minPos) * 0.5f;
+    bounds.extents = (maxPos - minPos) * 0.5f;
+    bounds.sphereRadius = glm::length(bounds.extents);
+
+    return bounds;
+}
+
+glm::vec4 Hush::Bounds::GetWorldSphere(const glm::mat4 &transform) const noexcept
+{
+    const glm::vec3 center = glm::vec3(transform * glm::vec4(this->origin, 1.0f));
+
+    // Non-uniform scale stretches the sphere, the longest axis keeps it conservative
+    const float scale = std::sqrt(std::max({glm::dot(glm::vec3(transform[0]), glm::vec3(transform[0])),
+                                            glm::dot(glm::vec3(transform[1]), glm::vec3(transform[1])),
+                                            glm::dot(glm::vec3(transform[2]), glm::vec3(transform[2]))}));
+
+    return glm::vec4(center, this->sphereRadius * scale);
+}
+
+Hush::Frustum Hush::Frustum::FromViewProjection(const glm::mat4 &viewProjection) noexcept
+{
+    // glm is column major, rows of the matrix are read across columns
+    const auto row = [&viewProjection](int index) {
+        return glm::vec4(viewProjection[0][index], viewProjection[1][index], viewProjection[2][index],
+                         viewProjection[3][index]);
+    };
+
+    const glm::vec4 row0 = row(0);
+    const glm::vec4 row1 = row(1);
+    const glm::vec4 row2 = row(2);
+    const glm::vec4 row3 = row(3);
+
+    Frustum frustum;
+    frustum.m_planes = {
+        row3 + row0, // Left
+        row3 - row0, // Right
+        row3 + row1, // Bottom
+        row3 - row1, // Top
+        // -w <= z <= w, also holds (conservatively) for the [0, 1] depth range and reversed depth
+        row3 + row2, // Near
+        row3 - row2, // Far
+    };
+
+    for (glm::vec4 &plane : frustum.m_planes)
+    {
+        const float length = glm::length(glm::vec3(plane));
+        if (length > std::numeric_limits<float>::epsilon())
+        {
+            plane /= length;
+        }
+    }
+
+    return frustum;
+}
+
+bool Hush::Frustum::IsSphereVisible(const glm::vec4 &sphere) const noexcept
+{
+    for (const glm::vec4 &plane : this->m_planes)
+    {
+        if (glm::dot(glm::vec3(plane), glm::vec3(sphere)) + plane.w < -sphere.w)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void Hush::Frustum::TestSpheres(std::span<const glm::vec4> spheres, std::span<std::uint8_t> visible) const noexcept
+{
+    HUSH_ASSERT(visible.size() >= spheres.size(), "Visibility output has {} entries for {} spheres", visible.size(),
+                spheres.size());
+
+    std::size_t i = 0;
+
+#if HUSH_FRUSTUM_SSE
+    static_assert(sizeof(glm::vec4) == 4 * sizeof(float), "Spheres are loaded as four packed floats");
+
+    // Four spheres per iteration, transposed so each register holds one component of all of them
+    for (; i + 4 <= spheres.size(); i += 4)
+    {
+        __m128 x = _mm_loadu_ps(&spheres[i].x);
+        __m128 y = _mm_loadu_ps(&spheres[i + 1].x);
+        __m128 z = _mm_loadu_ps(&spheres[i + 2].x);
+        __m128 radius = _mm_loadu_ps(&spheres[i + 3].x);
+        _MM_TRANSPOSE4_PS(x, y, z, radius);
+
+        const __m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), radius);
+        __m128 outside = _mm_setzero_ps();
+
+        for (const glm::vec4 &plane : this->m_planes)
+        {
+            __m128 distance = _mm_mul_ps(x, _mm_set1_ps(plane.x));
+            distance = _mm_add_ps(distance, _mm_mul_ps(y, _mm_set1_ps(plane.y)));
+            distance = _mm_add_ps(distance, _mm_mul_ps(z, _mm_set1_ps(plane.z)));
+            distance = _mm_add_ps(distance, _mm_set1_ps(plane.w));
+
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, negRadius));
+        }
+
+        const int outsideMask = _mm_movemask_ps(outside);
+        for (int lane = 0; lane < 4; ++lane)
+        {
+            visible[i + lane] = (outsideMask & (1 << lane)) == 0 ? 1 : 0;
+        }
+    }
+#endif
+
+    for (; i < spheres.size(); ++i)
+    {
+        visible[i] = this->IsSphereVisible(spheres[i]) ? 1 : 0;
+    }
+}
+
+void Hush::Frustum::TestSpheres(std::span<const glm::vec4> spheres, std::span<std::uint8_t> visible,
+                                Threading::ThreadPool *threadPool) const
+{
+    if (threadPool == nullptr || spheres.size() < PARALLEL_THRESHOLD)
+    {
+        this->TestSpheres(spheres, visible);
+        return;
+    }
+
+    // Chunks are a multiple of 4, so only the last one has a scalar tail
+    threadPool->ParallelFor(spheres.size(), 4u, [this, spheres, visible](std::size_t first, std::size_t last) {
+        this->TestSpheres(spheres.subspan(first, last - first), visible.subspan(first, last - first));
+    });
+}
@@ -0,0 +1,88 @@
+/*! \file Frustum.hpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief View frustum and bounding volumes used for visibility culling
+*/
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace Hush
+{
+    namespace Threading
+    {
+        class ThreadPool;
+    }
+
+    /// @brief Local space bounds of a surface, computed when the mesh is loaded
+    struct Bounds
+    {
+        /// @brief Center of the box and the sphere
+        glm::vec3 origin{0.0f};
+        /// @brief Radius of the sphere that encloses the box
+        float sphereRadius = 0.0f;
+        /// @brief Half size of the box on each axis
+        glm::vec3 extents{0.0f};
+
+        /// @brief Computes the bounds of a set of points
+        /// @param positions Points to enclose, the bounds are empty if there are none
+        /// @return Bounds enclosing every point
+        [[nodiscard]]
+        static Bounds FromPoints(std::span<const glm::vec3> positions) noexcept;
+
+        /// @brief Gets the world space bounding sphere of these bounds
+        /// @param transform Local to world transform
+        /// @return Center in xyz and radius in w
+        [[nodiscard]]
+        glm::vec4 GetWorldSphere(const glm::mat4 &transform) const noexcept;
+    };
+
+    /// @brief Six planes of a view frustum, pointing inwards
+    class Frustum
+    {
+      public:
+        /// @brief Extracts the planes of a view projection matrix
+        /// @param viewProjection Projection * view matrix of the camera
+        /// @return Frustum of the camera, in world space
+        [[nodiscard]]
+        static Frustum FromViewProjection(const glm::mat4 &viewProjection) noexcept;
+
+        /// @brief Tests a single sphere against the frustum
+        /// @param sphere Center in xyz and radius in w
+        /// @return False if the sphere is completely outside the frustum
+        [[nodiscard]]
+        bool IsSphereVisible(const glm::vec4 &sphere) const noexcept;
+
+        /// @brief Tests a batch of spheres against the frustum, four at a time when SIMD is available
+        /// @param spheres Centers in xyz and radius in w
+        /// @param visible Output, 1 for each sphere that is at least partially inside, 0 otherwise. Must be as big as
+        /// spheres
+        void TestSpheres(std::span<const glm::vec4> spheres, std::span<std::uint8_t> visible) const noexcept;
+
+        /// @brief Tests a batch of spheres like TestSpheres, split across a thread pool when there are at least
+        /// PARALLEL_THRESHOLD of them
+        /// @param spheres Centers in xyz and radius in w
+        /// @param visible Output, must be as big as spheres
+        /// @param threadPool Thread pool, or nullptr to test them in the calling thread
+        void TestSpheres(std::span<const glm::vec4> spheres, std::span<std::uint8_t> visible,
+                         Threading::ThreadPool *threadPool) const;
+
+        /// @brief Below this many spheres, the thread pool is not used
+        static constexpr std::size_t PARALLEL_THRESHOLD = 1024;
+
+        [[nodiscard]]
+        const std::array<glm::vec4, 6> &GetPlanes() const noexcept
+        {
+            return this->m_planes;
+        }
+
+      private:
+        /// @brief Normal in xyz and distance in w, normalized
+        std::array<glm::vec4, 6> m_planes{};
+    };
+} // namespace Hush
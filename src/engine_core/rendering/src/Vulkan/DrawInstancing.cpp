@@ -0,0 +1,92 @@
+/*! \file DrawInstancing.cpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Grouping of identical draws into instanced draws
+*/
+
+#include "DrawInstancing.hpp"
+#include "FrameAllocator.hpp"
+
+#include <functional>
+#include <memory_resource>
+#include <unordered_map>
+
+namespace
+{
+    struct GroupKey
+    {
+        VkBuffer indexBuffer;
+        uint32_t firstIndex;
+        const Hush::VkMaterialInstance *material;
+
+        bool operator==(const GroupKey &) const noexcept = default;
+    };
+
+    struct GroupKeyHash
+    {
+        size_t operator()(const GroupKey &key) const noexcept
+        {
+            size_t hash = std::hash<const void *>{}(key.material);
+            hash ^= std::hash<VkBuffer>{}(key.indexBuffer) + 0x9E3779B9u + (hash << 6u) + (hash >> 2u);
+            hash ^= std::hash<uint32_t>{}(key.firstIndex) + 0x9E3779B9u + (hash << 6u) + (hash >> 2u);
+            return hash;
+        }
+    };
+} // namespace
+
+void Hush::DrawInstancer::Build(std::span<const VkRenderObject> surfaces, std::vector<InstancedDraw> &draws,
+                                std::vector<GPUDrawInstance> &instances)
+{
+    draws.clear();
+    instances.resize(surfaces.size());
+    this->m_groupOfSurface.resize(surfaces.size());
+
+    // Only lives for this call, the frame allocator saves the node allocations
+    std::pmr::unordered_map<GroupKey, uint32_t, GroupKeyHash> groups(GetFrameResource());
+    groups.reserve(surfaces.size());
+
+    for (size_t i = 0; i < surfaces.size(); ++i)
+    {
+        const VkRenderObject &surface = surfaces[i];
+        auto groupIndex = static_cast<uint32_t>(draws.size());
+
+        if (surface.material->pipeline->instancedPipeline != VK_NULL_HANDLE)
+        {
+            const GroupKey key{surface.indexBuffer, surface.firstIndex, surface.material};
+            groupIndex = groups.try_emplace(key, groupIndex).first->second;
+        }
+
+        if (groupIndex == draws.size())
+        {
+            InstancedDraw draw;
+            draw.surface = surface;
+            draws.push_back(draw);
+        }
+
+        ++draws[groupIndex].instanceCount;
+        this->m_groupOfSurface[i] = groupIndex;
+    }
+
+    // Each group gets a contiguous range, the counts are rebuilt while scattering
+    uint32_t firstInstance = 0;
+    for (InstancedDraw &draw : draws)
+    {
+        draw.firstInstance = firstInstance;
+        firstInstance += draw.instanceCount;
+        draw.instanceCount = 0;
+    }
+
+    for (size_t i = 0; i < surfaces.size(); ++i)
+    {
+        const VkRenderObject &surface = surfaces[i];
+        InstancedDraw &draw = draws[this->m_groupOfSurface[i]];
+
+        GPUDrawInstance instance{};
+        instance.worldMatrix = surface.transform;
+        instance.boundingSphere = glm::vec4(surface.bounds.origin, surface.bounds.sphereRadius);
+        instance.vertexBuffer = surface.vertexBufferAddress;
+        instance.indexCount = surface.indexCount;
+        instance.firstIndex = surface.firstIndex;
+        instances[draw.firstInstance + draw.instanceCount++] = instance;
+    }
+}
@@ -0,0 +1,46 @@
+/*! \file DrawInstancing.hpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Grouping of identical draws into instanced draws
+*/
+
+#pragma once
+
+#include "VkRenderObject.hpp"
+#include "VkTypes.hpp"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Hush
+{
+    /// @brief Every copy of a surface sharing the same mesh range and material, drawn with a single instanced call
+    struct InstancedDraw
+    {
+        /// @brief First surface of the group, its transform is only used if the group is not instanced
+        VkRenderObject surface;
+        /// @brief First instance of the group in the instance buffer, passed as firstInstance of the draw
+        uint32_t firstInstance = 0;
+        uint32_t instanceCount = 0;
+    };
+
+    /// @brief Groups surfaces with the same index buffer, first index and material. The transforms of each group are
+    /// laid out contiguously, so they can be uploaded to an instance buffer and drawn with one vkCmdDrawIndexed.
+    /// Surfaces whose material has no instanced pipeline each get their own group of one
+    class DrawInstancer
+    {
+      public:
+        /// @brief Builds the instanced draws of a list of surfaces
+        /// @param surfaces Opaque surfaces, groups are emitted in the order of their first surface so a sorted list
+        /// stays sorted
+        /// @param draws Output, one entry per group
+        /// @param instances Output, per instance data of every group, in group order
+        void Build(std::span<const VkRenderObject> surfaces, std::vector<InstancedDraw> &draws,
+                   std::vector<GPUDrawInstance> &instances);
+
+      private:
+        // Scratch, reused every frame
+        std::vector<uint32_t> m_groupOfSurface;
+    };
+} // namespace Hush
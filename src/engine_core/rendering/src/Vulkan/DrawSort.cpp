@@ -0,0 +1,165 @@
+/*! \file DrawSort.cpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Sorting of the draw lists by render state and depth
+*/
+
+#include "DrawSort.hpp"
+
+#include <array>
+#include <bit>
+#include <type_traits>
+
+namespace
+{
+    constexpr uint32_t DEPTH_BITS = 24;
+    constexpr uint32_t INDEX_BUFFER_BITS = 12;
+    constexpr uint32_t MATERIAL_BITS = 15;
+    constexpr uint32_t PIPELINE_BITS = 12;
+
+    constexpr uint32_t INDEX_BUFFER_SHIFT = DEPTH_BITS;
+    constexpr uint32_t MATERIAL_SHIFT = INDEX_BUFFER_SHIFT + INDEX_BUFFER_BITS;
+    constexpr uint32_t PIPELINE_SHIFT = MATERIAL_SHIFT + MATERIAL_BITS;
+    constexpr uint32_t PASS_SHIFT = PIPELINE_SHIFT + PIPELINE_BITS;
+
+    static_assert(PASS_SHIFT == 63, "The sort key fields must fill the 64 bits");
+
+    /// @brief Fibonacci hash of a handle, folded to the given number of bits. Two different handles might share a
+    /// value, which only costs an extra bind, never a wrong draw
+    template <typename Handle>
+    uint64_t HashHandle(Handle handle, uint32_t bits) noexcept
+    {
+        uint64_t value = 0;
+        if constexpr (std::is_pointer_v<Handle>)
+        {
+            value = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(handle));
+        }
+        else
+        {
+            value = static_cast<uint64_t>(handle);
+        }
+
+        return (value * 0x9E3779B97F4A7C15ull) >> (64u - bits);
+    }
+
+    /// @brief Quantizes a depth keeping its order. The bits of a positive float sort like the float itself
+    uint64_t QuantizeDepth(float depth) noexcept
+    {
+        const float clampedDepth = depth > 0.0f ? depth : 0.0f;
+        return static_cast<uint64_t>(std::bit_cast<uint32_t>(clampedDepth) >> (32u - DEPTH_BITS));
+    }
+
+    /// @brief Distance along the view direction, the camera looks towards -z
+    float ViewDepth(const Hush::VkRenderObject &surface, const glm::mat4 &view) noexcept
+    {
+        const glm::vec4 center = surface.transform * glm::vec4(surface.bounds.origin, 1.0f);
+        return -(view * center).z;
+    }
+} // namespace
+
+uint64_t Hush::DrawSorter::MakeOpaqueKey(const VkRenderObject &surface, float depth) noexcept
+{
+    const auto pass = static_cast<uint64_t>(surface.material->passType == EMaterialPass::Transparent);
+
+    return (pass << PASS_SHIFT) | (HashHandle(surface.material->pipeline, PIPELINE_BITS) << PIPELINE_SHIFT) |
+           (HashHandle(surface.material, MATERIAL_BITS) << MATERIAL_SHIFT) |
+           (HashHandle(surface.indexBuffer, INDEX_BUFFER_BITS) << INDEX_BUFFER_SHIFT) | QuantizeDepth(depth);
+}
+
+uint64_t Hush::DrawSorter::MakeTransparentKey(float depth) noexcept
+{
+    constexpr uint64_t depthMask = (1ull << DEPTH_BITS) - 1ull;
+    return depthMask - QuantizeDepth(depth);
+}
+
+void Hush::DrawSorter::SortOpaque(std::vector<VkRenderObject> &surfaces, const glm::mat4 &view)
+{
+    this->BuildEntries(surfaces, view, &DrawSorter::MakeOpaqueKey);
+    this->RadixSort();
+    this->ApplyOrder(surfaces);
+}
+
+void Hush::DrawSorter::SortTransparent(std::vector<VkRenderObject> &surfaces, const glm::mat4 &view)
+{
+    this->BuildEntries(surfaces, view,
+                       [](const VkRenderObject &, float depth) { return DrawSorter::MakeTransparentKey(depth); });
+    this->RadixSort();
+    this->ApplyOrder(surfaces);
+}
+
+template <typename KeyFunction>
+void Hush::DrawSorter::BuildEntries(std::span<const VkRenderObject> surfaces, const glm::mat4 &view,
+                                    KeyFunction &&makeKey)
+{
+    this->m_entries.resize(surfaces.size());
+
+    for (size_t i = 0; i < surfaces.size(); ++i)
+    {
+        this->m_entries[i].key = makeKey(surfaces[i], ViewDepth(surfaces[i], view));
+        this->m_entries[i].index = static_cast<uint32_t>(i);
+    }
+}
+
+void Hush::DrawSorter::RadixSort()
+{
+    constexpr uint32_t radixBits = 8;
+    constexpr uint32_t bucketCount = 1u << radixBits;
+
+    const size_t entryCount = this->m_entries.size();
+    if (entryCount < 2)
+    {
+        return;
+    }
+
+    // Bits that are not the same in every key, the bytes without any are already sorted
+    uint64_t differentBits = 0;
+    for (const SortEntry &entry : this->m_entries)
+    {
+        differentBits |= entry.key ^ this->m_entries.front().key;
+    }
+
+    this->m_scratch.resize(entryCount);
+
+    for (uint32_t shift = 0; shift < 64; shift += radixBits)
+    {
+        if (((differentBits >> shift) & (bucketCount - 1)) == 0)
+        {
+            continue;
+        }
+
+        std::array<size_t, bucketCount> offsets{};
+        for (const SortEntry &entry : this->m_entries)
+        {
+            ++offsets[(entry.key >> shift) & (bucketCount - 1)];
+        }
+
+        size_t offset = 0;
+        for (size_t &bucket : offsets)
+        {
+            const size_t count = bucket;
+            bucket = offset;
+            offset += count;
+        }
+
+        for (const SortEntry &entry : this->m_entries)
+        {
+            this->m_scratch[offsets[(entry.key >> shift) & (bucketCount - 1)]++] = entry;
+        }
+
+        this->m_entries.swap(this->m_scratch);
+    }
+}
+
+void Hush::DrawSorter::ApplyOrder(std::vector<VkRenderObject> &surfaces)
+{
+    this->m_sortedSurfaces.clear();
+    this->m_sortedSurfaces.reserve(surfaces.size());
+
+    for (const SortEntry &entry : this->m_entries)
+    {
+        this->m_sortedSurfaces.push_back(surfaces[entry.index]);
+    }
+
+    // Swapping keeps the capacity of both vectors around for the next frame
+    surfaces.swap(this->m_sortedSurfaces);
+}
@@ -0,0 +1,73 @@
+/*! \file DrawSort.hpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Sorting of the draw lists by render state and depth
+*/
+
+#pragma once
+
+#include "VkRenderObject.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Hush
+{
+    /// @brief Builds 64-bit sort keys for the surfaces of a draw list and reorders it with a radix sort.
+    /// Opaque keys, from the most significant bit:
+    /// | pass (1) | pipeline (12) | material (15) | index buffer (12) | depth (24) |
+    /// so surfaces that share state end up next to each other, and within the same state they go front to back.
+    /// Transparent keys only hold the inverted depth, they must be drawn back to front regardless of their state.
+    class DrawSorter
+    {
+      public:
+        /// @brief Sorts opaque surfaces by pipeline, material, index buffer and then front to back
+        /// @param surfaces Surfaces to sort in place
+        /// @param view View matrix of the camera
+        void SortOpaque(std::vector<VkRenderObject> &surfaces, const glm::mat4 &view);
+
+        /// @brief Sorts transparent surfaces back to front
+        /// @param surfaces Surfaces to sort in place
+        /// @param view View matrix of the camera
+        void SortTransparent(std::vector<VkRenderObject> &surfaces, const glm::mat4 &view);
+
+        /// @brief Builds the sort key of an opaque surface
+        /// @param surface Surface to build the key of
+        /// @param depth View space distance to the camera
+        /// @return Sort key
+        [[nodiscard]]
+        static uint64_t MakeOpaqueKey(const VkRenderObject &surface, float depth) noexcept;
+
+        /// @brief Builds the sort key of a transparent surface
+        /// @param depth View space distance to the camera
+        /// @return Sort key, bigger depths get smaller keys
+        [[nodiscard]]
+        static uint64_t MakeTransparentKey(float depth) noexcept;
+
+      private:
+        struct SortEntry
+        {
+            uint64_t key;
+            uint32_t index;
+        };
+
+        /// @brief Fills the sort keys of every surface
+        template <typename KeyFunction>
+        void BuildEntries(std::span<const VkRenderObject> surfaces, const glm::mat4 &view, KeyFunction &&makeKey);
+
+        /// @brief Stable LSD radix sort of m_entries by key, 8 bits per pass. Passes where every key has the same
+        /// byte are skipped
+        void RadixSort();
+
+        /// @brief Reorders the surfaces following m_entries
+        void ApplyOrder(std::vector<VkRenderObject> &surfaces);
+
+        // Scratch, reused every frame
+        std::vector<SortEntry> m_entries;
+        std::vector<SortEntry> m_scratch;
+        std::vector<VkRenderObject> m_sortedSurfaces;
+    };
+} // namespace Hush
@@ -8,6 +8,7 @@
 #include "VulkanDeletionQueue.hpp"
 #include <vulkan/vulkan.h>
 #include "VkDescriptors.hpp"
+#include <vector>
 
 /// @brief Definition of the frame data structure to pass in Vulkan's dynamic rendering
 /// from VKGuide (https://vkguide.dev/docs/new_chapter_1/vulkan_mainloop_code/)
@@ -27,4 +28,11 @@ struct FrameData
     VulkanDeletionQueue deletionQueue;
 
     DescriptorAllocatorGrowable frameDescriptors;
+
+    /// @brief One pool per recording thread, so secondary command buffers can be recorded in parallel. Created on
+    /// demand the first time parallel recording needs them
+    std::vector<VkCommandPool> workerCommandPools;
+
+    /// @brief Secondary command buffer of each worker pool, same index as workerCommandPools
+    std::vector<VkCommandBuffer> workerCommandBuffers;
 };
\ No newline at end of file
@@ -8,7 +8,8 @@
 #include "VkUtilsFactory.hpp"
 #include "VkMaterialInstance.hpp"
 
-void Hush::GLTFMetallicRoughness::BuildPipelines(IRenderer* engine, const std::string_view& fragmentShaderPath, const std::string_view& vertexShaderPath)
+void Hush::GLTFMetallicRoughness::BuildPipelines(IRenderer* engine, const std::string_view& fragmentShaderPath, const std::string_view& vertexShaderPath,
+	const std::string_view& instancedVertexShaderPath)
 {
 	auto* vkEngine = static_cast<VulkanRenderer*>(engine);
 	VkShaderModule meshFragmentShader;
@@ -70,6 +71,15 @@ void Hush::GLTFMetallicRoughness::BuildPipelines(IRenderer* engine, const std::s
 	// Create the opaque variant
 	this->opaquePipeline.pipeline = pipelineBuilder.Build(device);
 
+	// Same state and layout, the vertex shader reads its transform from an instance buffer
+	VkShaderModule instancedVertexShader;
+	if (!instancedVertexShaderPath.empty() && VulkanHelper::LoadShaderModule(instancedVertexShaderPath, device, &instancedVertexShader)) {
+		pipelineBuilder.SetShaders(instancedVertexShader, meshFragmentShader);
+		this->opaquePipeline.instancedPipeline = pipelineBuilder.Build(device);
+		vkDestroyShaderModule(device, instancedVertexShader, nullptr);
+		pipelineBuilder.SetShaders(meshVertexShader, meshFragmentShader);
+	}
+
 	// Create the transparent variant
 	pipelineBuilder.EnableBlendingAdditive();
 
@@ -42,7 +42,10 @@ namespace Hush {
 
 		DescriptorWriter writer;
 
-		void BuildPipelines(IRenderer* engine, const std::string_view& fragmentShaderPath, const std::string_view& vertexShaderPath);
+		/// @brief Builds the opaque and transparent pipelines
+		/// @param instancedVertexShaderPath Path to mesh_instanced.vert, if set the opaque pipeline gets an instanced variant
+		void BuildPipelines(IRenderer* engine, const std::string_view& fragmentShaderPath, const std::string_view& vertexShaderPath,
+			const std::string_view& instancedVertexShaderPath = {});
 		void ClearResources(VkDevice device);
 
 		inline VkMaterialInstance WriteMaterial(VkDevice device, EMaterialPass pass, const MaterialResources& resources, DescriptorAllocatorGrowable& descriptorAllocator) {
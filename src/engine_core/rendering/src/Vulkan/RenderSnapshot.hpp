@@ -0,0 +1,25 @@
+#pragma once
+#include "DrawContext.hpp"
+#include "DrawInstancing.hpp"
+#include "GPUSceneData.hpp"
+#include <imgui/imgui.h>
+
+namespace Hush {
+	/// @brief Everything a frame needs to be recorded, copied out of the scene and the UI during the extract phase.
+	/// Submitting only reads it, so the main thread can work on the next frame meanwhile
+	struct RenderSnapshot {
+		DrawContext drawContext;
+		GPUSceneData sceneData;
+		/// @brief Opaque surfaces go through the GPU driven path, the indirect ones were not culled on the CPU
+		bool gpuDrivenOpaque = false;
+		/// @brief With gpuDrivenOpaque, number of opaque surfaces drawn indirectly. The ones after them have no instanced
+		/// pipeline, so they are culled on the CPU and drawn one by one
+		size_t indirectOpaqueCount = 0;
+		/// @brief Opaque surfaces are drawn from instancedDraws instead of drawContext
+		bool instancedOpaque = false;
+		std::vector<InstancedDraw> instancedDraws;
+		std::vector<GPUDrawInstance> drawInstances;
+		/// @brief Copy of the UI draw lists, owned by the snapshot (see VulkanImGuiForwarder::CopyDrawData)
+		ImDrawData uiDrawData;
+	};
+}
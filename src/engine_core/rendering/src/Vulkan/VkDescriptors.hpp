@@ -10,6 +10,7 @@
 #include <vector>
 #include "VkTypes.hpp"
 #include <deque>
+#include <memory_resource>
 
 //> descriptor_layout
 struct DescriptorLayoutBuilder
@@ -27,9 +28,18 @@ struct DescriptorLayoutBuilder
 //> writer
 struct DescriptorWriter
 {
-    std::deque<VkDescriptorImageInfo> imageInfos;
-    std::deque<VkDescriptorBufferInfo> bufferInfos;
-    std::vector<VkWriteDescriptorSet> writes;
+    std::pmr::deque<VkDescriptorImageInfo> imageInfos;
+    std::pmr::deque<VkDescriptorBufferInfo> bufferInfos;
+    std::pmr::vector<VkWriteDescriptorSet> writes;
+
+    DescriptorWriter() = default;
+
+    /// @brief Creates a writer whose infos are allocated from the given resource, e.g. the frame allocator for writers
+    /// that only live during a frame.
+    explicit DescriptorWriter(std::pmr::memory_resource *resource)
+        : imageInfos(resource), bufferInfos(resource), writes(resource)
+    {
+    }
 
     void WriteImage(int32_t binding, VkImageView image, VkSampler sampler, VkImageLayout layout, VkDescriptorType type);
     void WriteBuffer(int32_t binding, VkBuffer buffer, size_t size, size_t offset, VkDescriptorType type);
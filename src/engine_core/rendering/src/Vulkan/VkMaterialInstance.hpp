@@ -7,6 +7,9 @@ namespace Hush {
 	struct VkMaterialPipeline {
 		VkPipeline pipeline;
 		VkPipelineLayout layout; //Check deletion queue?
+		/// @brief Same pipeline reading the transform of each instance from an instance buffer (mesh_instanced.vert),
+		/// used by instanced and GPU driven draws. Null if the shader could not be loaded
+		VkPipeline instancedPipeline = VK_NULL_HANDLE;
 	};
 
 	struct VkMaterialInstance {
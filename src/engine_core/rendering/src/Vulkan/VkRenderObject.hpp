@@ -1,5 +1,6 @@
 #pragma once
 #include "VkMaterialInstance.hpp"
+#include "Shared/Frustum.hpp"
 namespace Hush {
 	struct VkRenderObject {
 		uint32_t indexCount;
@@ -9,5 +10,6 @@ namespace Hush {
 		VkMaterialInstance* material;
 		glm::mat4 transform;
 		VkDeviceAddress vertexBufferAddress;
+		Bounds bounds;
 	};
 }
@@ -30,6 +30,23 @@ struct GPUDrawPushConstants {
 	VkDeviceAddress vertexBuffer;
 };
 
+// per instance data of instanced and GPU driven draws, read by mesh_instanced.vert and indirect_cull.comp (std430)
+struct GPUDrawInstance {
+	glm::mat4 worldMatrix;
+	// local bounding sphere, xyz center and w radius
+	glm::vec4 boundingSphere;
+	VkDeviceAddress vertexBuffer;
+	uint32_t indexCount;
+	uint32_t firstIndex;
+	// batch whose draw count this instance increments when visible, GPU driven draws only
+	uint32_t batchIndex;
+	// first indirect command of the batch, visible instances are compacted from there
+	uint32_t firstCommand;
+	uint32_t padding[2];
+};
+
+HUSH_STATIC_ASSERT(sizeof(GPUDrawInstance) == 112, "GPUDrawInstance must match the std430 layout of the shaders");
+
 struct AllocatedImage
 {
 	VkImage image;
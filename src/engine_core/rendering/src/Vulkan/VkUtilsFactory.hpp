@@ -49,14 +49,15 @@ class VkUtilsFactory
         return commandPoolInfo;
     }
 
-    static VkCommandBufferAllocateInfo CreateCommandBufferAllocateInfo(VkCommandPool pool, uint32_t count = 1u)
+    static VkCommandBufferAllocateInfo CreateCommandBufferAllocateInfo(
+        VkCommandPool pool, uint32_t count = 1u, VkCommandBufferLevel level = VK_COMMAND_BUFFER_LEVEL_PRIMARY)
     {
         VkCommandBufferAllocateInfo cmdAllocInfo = {};
         cmdAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
         cmdAllocInfo.pNext = nullptr;
         cmdAllocInfo.commandPool = pool;
         cmdAllocInfo.commandBufferCount = count;
-        cmdAllocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        cmdAllocInfo.level = level;
         return cmdAllocInfo;
     }
 
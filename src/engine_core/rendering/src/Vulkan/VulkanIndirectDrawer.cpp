@@ -0,0 +1,306 @@
+/*! \file VulkanIndirectDrawer.cpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief GPU driven path for opaque geometry, culled in a compute shader and drawn with indirect commands
+*/
+
+// NOTE: Keep volk at the top to avoid function redefinitions with Vulkan
+#include <volk.h>
+#include "VulkanIndirectDrawer.hpp"
+#include "Assertions.hpp"
+#include "Logger.hpp"
+#include "VkTypes.hpp"
+#include "VkUtilsFactory.hpp"
+#include "VulkanPipelineBuilder.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+namespace
+{
+    constexpr uint32_t CULL_GROUP_SIZE = 64;
+    constexpr uint32_t MIN_INSTANCE_CAPACITY = 1024;
+
+    /// @brief Push constants of indirect_cull.comp
+    struct CullPushConstants
+    {
+        std::array<glm::vec4, 6> frustumPlanes;
+        VkDeviceAddress instances;
+        VkDeviceAddress commands;
+        VkDeviceAddress counts;
+        uint32_t instanceCount;
+        uint32_t padding;
+    };
+
+    static_assert(sizeof(CullPushConstants) <= 128, "Only 128 bytes of push constants are guaranteed");
+
+    VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment) noexcept
+    {
+        return (value + alignment - 1u) & ~(alignment - 1u);
+    }
+} // namespace
+
+bool Hush::VulkanIndirectDrawer::Init(VkDevice device, VmaAllocator allocator, std::string_view cullShaderPath,
+                                      uint32_t frameCount)
+{
+    HUSH_ASSERT(frameCount > 0u, "The indirect drawer needs at least one frame");
+
+    VkShaderModule cullShader = VK_NULL_HANDLE;
+    if (!VulkanHelper::LoadShaderModule(cullShaderPath, device, &cullShader))
+    {
+        LogError("Error when building the indirect culling compute shader");
+        return false;
+    }
+
+    VkPushConstantRange pushConstant{};
+    pushConstant.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    pushConstant.offset = 0;
+    pushConstant.size = sizeof(CullPushConstants);
+
+    // Every buffer is reached through its device address, no descriptor sets needed
+    VkPipelineLayoutCreateInfo layoutInfo = VkUtilsFactory::PipelineLayoutCreateInfo();
+    layoutInfo.pushConstantRangeCount = 1;
+    layoutInfo.pPushConstantRanges = &pushConstant;
+
+    VkResult rc = vkCreatePipelineLayout(device, &layoutInfo, nullptr, &this->m_cullPipelineLayout);
+    HUSH_VK_ASSERT(rc, "Creating indirect culling pipeline layout failed!");
+
+    VkPipelineShaderStageCreateInfo stageInfo{};
+    stageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stageInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    stageInfo.module = cullShader;
+    stageInfo.pName = "main";
+
+    VkComputePipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.layout = this->m_cullPipelineLayout;
+    pipelineInfo.stage = stageInfo;
+
+    rc = vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &this->m_cullPipeline);
+    HUSH_VK_ASSERT(rc, "Creating indirect culling pipeline failed!");
+
+    vkDestroyShaderModule(device, cullShader, nullptr);
+
+    if (rc != VK_SUCCESS)
+    {
+        vkDestroyPipelineLayout(device, this->m_cullPipelineLayout, nullptr);
+        return false;
+    }
+
+    this->m_device = device;
+    this->m_allocator = allocator;
+    this->m_frames.resize(frameCount);
+
+    return true;
+}
+
+void Hush::VulkanIndirectDrawer::Dispose()
+{
+    if (this->m_device == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    for (FrameBuffer& frame : this->m_frames)
+    {
+        if (frame.capacity > 0u)
+        {
+            frame.buffer.Dispose(this->m_allocator);
+        }
+    }
+
+    this->m_frames.clear();
+    this->m_currentFrame = nullptr;
+
+    vkDestroyPipeline(this->m_device, this->m_cullPipeline, nullptr);
+    vkDestroyPipelineLayout(this->m_device, this->m_cullPipelineLayout, nullptr);
+    this->m_device = VK_NULL_HANDLE;
+}
+
+bool Hush::VulkanIndirectDrawer::IsInitialized() const noexcept
+{
+    return this->m_device != VK_NULL_HANDLE;
+}
+
+void Hush::VulkanIndirectDrawer::Prepare(uint32_t frameIndex, std::span<const VkRenderObject> surfaces)
+{
+    FrameBuffer& frame = this->m_frames[frameIndex % this->m_frames.size()];
+    this->Reserve(frame, static_cast<uint32_t>(surfaces.size()));
+    this->m_currentFrame = &frame;
+    this->m_batches.clear();
+
+    auto* mappedData = static_cast<std::byte*>(frame.buffer.GetAllocationInfo().pMappedData);
+    auto* instances = reinterpret_cast<GPUDrawInstance*>(mappedData);
+    uint32_t instanceCount = 0;
+
+    for (const VkRenderObject& surface : surfaces)
+    {
+        HUSH_ASSERT(surface.material->pipeline->instancedPipeline != VK_NULL_HANDLE,
+                    "Surfaces without an instanced pipeline must be drawn through the CPU path");
+
+        // The surfaces are sorted by state, a new batch starts whenever the bindings change
+        if (this->m_batches.empty() || this->m_batches.back().material != surface.material ||
+            this->m_batches.back().indexBuffer != surface.indexBuffer)
+        {
+            Batch batch;
+            batch.material = surface.material;
+            batch.indexBuffer = surface.indexBuffer;
+            batch.firstCommand = instanceCount;
+            this->m_batches.push_back(batch);
+        }
+
+        Batch& batch = this->m_batches.back();
+        ++batch.maxDrawCount;
+
+        GPUDrawInstance instance{};
+        instance.worldMatrix = surface.transform;
+        instance.boundingSphere = glm::vec4(surface.bounds.origin, surface.bounds.sphereRadius);
+        instance.vertexBuffer = surface.vertexBufferAddress;
+        instance.indexCount = surface.indexCount;
+        instance.firstIndex = surface.firstIndex;
+        instance.batchIndex = static_cast<uint32_t>(this->m_batches.size() - 1u);
+        instance.firstCommand = batch.firstCommand;
+        instances[instanceCount++] = instance;
+    }
+
+    this->m_instanceCount = instanceCount;
+
+    // The culling pass counts visible instances up from zero
+    std::memset(mappedData + frame.countsOffset, 0, this->m_batches.size() * sizeof(uint32_t));
+
+    // No-op for host coherent memory
+    vmaFlushAllocation(this->m_allocator, frame.buffer.GetAllocation(), 0, VK_WHOLE_SIZE);
+}
+
+void Hush::VulkanIndirectDrawer::RecordCulling(VkCommandBuffer cmd, const Frustum& frustum)
+{
+    if (this->m_currentFrame == nullptr || this->m_instanceCount == 0u)
+    {
+        return;
+    }
+
+    CullPushConstants pushConstants{};
+    pushConstants.frustumPlanes = frustum.GetPlanes();
+    pushConstants.instances = this->m_currentFrame->address;
+    pushConstants.commands = this->m_currentFrame->address + this->m_currentFrame->commandsOffset;
+    pushConstants.counts = this->m_currentFrame->address + this->m_currentFrame->countsOffset;
+    pushConstants.instanceCount = this->m_instanceCount;
+
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, this->m_cullPipeline);
+    vkCmdPushConstants(cmd, this->m_cullPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullPushConstants),
+                       &pushConstants);
+    vkCmdDispatch(cmd, (this->m_instanceCount + CULL_GROUP_SIZE - 1u) / CULL_GROUP_SIZE, 1, 1);
+
+    // Commands and counts are consumed by the indirect draws, instances by the vertex shader
+    VkMemoryBarrier2 memoryBarrier{};
+    memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+    memoryBarrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    memoryBarrier.srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+    memoryBarrier.dstStageMask = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT;
+    memoryBarrier.dstAccessMask = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_READ_BIT;
+
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.memoryBarrierCount = 1;
+    dependencyInfo.pMemoryBarriers = &memoryBarrier;
+
+    vkCmdPipelineBarrier2(cmd, &dependencyInfo);
+}
+
+void Hush::VulkanIndirectDrawer::RecordDraws(VkCommandBuffer cmd, VkDescriptorSet globalDescriptor)
+{
+    if (this->m_currentFrame == nullptr || this->m_instanceCount == 0u)
+    {
+        return;
+    }
+
+    const VkBuffer buffer = this->m_currentFrame->buffer.GetBuffer();
+
+    // mesh_instanced.vert reads the world matrix and vertex buffer of each instance, the matrix is unused
+    GPUDrawPushConstants pushConstants{};
+    pushConstants.worldMatrix = glm::mat4(1.0f);
+    pushConstants.vertexBuffer = this->m_currentFrame->address;
+
+    const VkMaterialPipeline* lastPipeline = nullptr;
+    const VkMaterialInstance* lastMaterial = nullptr;
+    VkBuffer lastIndexBuffer = VK_NULL_HANDLE;
+
+    for (size_t i = 0; i < this->m_batches.size(); ++i)
+    {
+        const Batch& batch = this->m_batches[i];
+        const VkMaterialPipeline* pipeline = batch.material->pipeline;
+
+        if (pipeline != lastPipeline)
+        {
+            lastPipeline = pipeline;
+            lastMaterial = nullptr;
+            vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline->instancedPipeline);
+            vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline->layout, 0, 1, &globalDescriptor,
+                                    0, nullptr);
+            vkCmdPushConstants(cmd, pipeline->layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(GPUDrawPushConstants),
+                               &pushConstants);
+        }
+
+        if (batch.material != lastMaterial)
+        {
+            lastMaterial = batch.material;
+            vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline->layout, 1, 1,
+                                    &batch.material->materialSet, 0, nullptr);
+        }
+
+        if (batch.indexBuffer != lastIndexBuffer)
+        {
+            lastIndexBuffer = batch.indexBuffer;
+            vkCmdBindIndexBuffer(cmd, batch.indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+        }
+
+        vkCmdDrawIndexedIndirectCount(
+            cmd, buffer,
+            this->m_currentFrame->commandsOffset + batch.firstCommand * sizeof(VkDrawIndexedIndirectCommand), buffer,
+            this->m_currentFrame->countsOffset + i * sizeof(uint32_t), batch.maxDrawCount,
+            sizeof(VkDrawIndexedIndirectCommand));
+    }
+}
+
+uint32_t Hush::VulkanIndirectDrawer::GetBatchCount() const noexcept
+{
+    return static_cast<uint32_t>(this->m_batches.size());
+}
+
+void Hush::VulkanIndirectDrawer::Reserve(FrameBuffer& frame, uint32_t instanceCount)
+{
+    // The first frame allocates even without surfaces, so the buffer can always be mapped
+    if (frame.capacity > 0u && instanceCount <= frame.capacity)
+    {
+        return;
+    }
+
+    // Only called once the fence of the frame was waited on, the GPU no longer uses the old buffer
+    if (frame.capacity > 0u)
+    {
+        frame.buffer.Dispose(this->m_allocator);
+    }
+
+    uint32_t capacity = std::max(frame.capacity, MIN_INSTANCE_CAPACITY);
+    while (capacity < instanceCount)
+    {
+        capacity *= 2u;
+    }
+
+    // Batches never outnumber instances, so every region is sized by the instance capacity
+    frame.capacity = capacity;
+    frame.commandsOffset = AlignUp(capacity * sizeof(GPUDrawInstance), 16u);
+    frame.countsOffset = AlignUp(frame.commandsOffset + capacity * sizeof(VkDrawIndexedIndirectCommand), 16u);
+    const VkDeviceSize bufferSize = frame.countsOffset + capacity * sizeof(uint32_t);
+
+    frame.buffer = VulkanAllocatedBuffer(static_cast<uint32_t>(bufferSize),
+                                         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+                                             VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                                         VMA_MEMORY_USAGE_CPU_TO_GPU, this->m_allocator);
+
+    VkBufferDeviceAddressInfo deviceAddressInfo{};
+    deviceAddressInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+    deviceAddressInfo.buffer = frame.buffer.GetBuffer();
+    frame.address = vkGetBufferDeviceAddress(this->m_device, &deviceAddressInfo);
+}
@@ -0,0 +1,103 @@
+/*! \file VulkanIndirectDrawer.hpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief GPU driven path for opaque geometry, culled in a compute shader and drawn with indirect commands
+*/
+
+#pragma once
+
+#include "VkRenderObject.hpp"
+#include "VkTypes.hpp"
+#include "VulkanAllocatedBuffer.hpp"
+#include "vk_mem_alloc.hpp"
+#include <vulkan/vulkan.h>
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace Hush
+{
+    /// @brief Draws opaque surfaces without any per draw CPU work. Every frame the surfaces are written to a storage
+    /// buffer, a compute shader culls them against the frustum and writes one indirect command per visible surface,
+    /// and each batch of surfaces sharing material and index buffer becomes a single vkCmdDrawIndexedIndirectCount.
+    /// Needs the drawIndirectCount, multiDrawIndirect and drawIndirectFirstInstance features, and pipelines built with
+    /// mesh_instanced.vert (VkMaterialPipeline::instancedPipeline)
+    class VulkanIndirectDrawer final
+    {
+      public:
+        VulkanIndirectDrawer() = default;
+
+        VulkanIndirectDrawer(const VulkanIndirectDrawer&) = delete;
+        VulkanIndirectDrawer& operator=(const VulkanIndirectDrawer&) = delete;
+
+        /// @brief Creates the culling compute pipeline
+        /// @param device Logical device
+        /// @param allocator VMA allocator, buffers are created lazily on the first frame
+        /// @param cullShaderPath Path to the compiled indirect_cull.comp
+        /// @param frameCount Number of frames in flight, each one gets its own buffer
+        /// @return True if the pipeline could be created
+        bool Init(VkDevice device, VmaAllocator allocator, std::string_view cullShaderPath, uint32_t frameCount);
+
+        void Dispose();
+
+        [[nodiscard]] bool IsInitialized() const noexcept;
+
+        /// @brief Writes the surfaces and the batches of a frame. The fence of the frame must have been waited on
+        /// @param frameIndex Index of the frame in flight
+        /// @param surfaces Opaque surfaces, sorted by state so consecutive ones can share a batch. Their material must
+        /// have an instanced pipeline, the others go through VulkanRenderer's CPU path
+        void Prepare(uint32_t frameIndex, std::span<const VkRenderObject> surfaces);
+
+        /// @brief Records the culling dispatch and the barrier protecting the indirect commands. Must be recorded
+        /// outside of a rendering instance
+        /// @param cmd Command buffer
+        /// @param frustum Camera frustum
+        void RecordCulling(VkCommandBuffer cmd, const Frustum& frustum);
+
+        /// @brief Records one indirect draw per batch
+        /// @param cmd Command buffer, inside the geometry rendering instance with viewport and scissor set
+        /// @param globalDescriptor Scene data descriptor set
+        void RecordDraws(VkCommandBuffer cmd, VkDescriptorSet globalDescriptor);
+
+        /// @brief Gets the number of indirect draws recorded for the last prepared frame
+        [[nodiscard]] uint32_t GetBatchCount() const noexcept;
+
+      private:
+        /// @brief Surfaces sharing pipeline, material and index buffer, drawn with a single indirect call
+        struct Batch
+        {
+            const VkMaterialInstance* material = nullptr;
+            VkBuffer indexBuffer = VK_NULL_HANDLE;
+            uint32_t firstCommand = 0;
+            uint32_t maxDrawCount = 0;
+        };
+
+        /// @brief One buffer per frame in flight holding instances, then indirect commands, then batch counts
+        struct FrameBuffer
+        {
+            VulkanAllocatedBuffer buffer;
+            VkDeviceAddress address = 0;
+            uint32_t capacity = 0;
+            VkDeviceSize commandsOffset = 0;
+            VkDeviceSize countsOffset = 0;
+        };
+
+        /// @brief Makes sure the buffer of a frame holds at least instanceCount instances
+        void Reserve(FrameBuffer& frame, uint32_t instanceCount);
+
+        VkDevice m_device = VK_NULL_HANDLE;
+        VmaAllocator m_allocator = nullptr;
+        VkPipeline m_cullPipeline = VK_NULL_HANDLE;
+        VkPipelineLayout m_cullPipelineLayout = VK_NULL_HANDLE;
+
+        std::vector<FrameBuffer> m_frames;
+        FrameBuffer* m_currentFrame = nullptr;
+        uint32_t m_instanceCount = 0;
+        std::vector<Batch> m_batches;
+    };
+} // namespace Hush
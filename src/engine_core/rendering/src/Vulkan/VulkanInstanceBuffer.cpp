@@ -0,0 +1,92 @@
+/*! \file VulkanInstanceBuffer.cpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Per frame storage buffer with the instances of instanced draws
+*/
+
+// NOTE: Keep volk at the top to avoid function redefinitions with Vulkan
+#include <volk.h>
+#include "VulkanInstanceBuffer.hpp"
+#include "Assertions.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    constexpr uint32_t MIN_INSTANCE_CAPACITY = 1024;
+} // namespace
+
+void Hush::VulkanInstanceBuffer::Init(VkDevice device, VmaAllocator allocator, uint32_t frameCount)
+{
+    HUSH_ASSERT(frameCount > 0u, "The instance buffer needs at least one frame");
+
+    this->m_device = device;
+    this->m_allocator = allocator;
+    this->m_frames.resize(frameCount);
+}
+
+void Hush::VulkanInstanceBuffer::Dispose()
+{
+    for (FrameBuffer& frame : this->m_frames)
+    {
+        if (frame.capacity > 0u)
+        {
+            frame.buffer.Dispose(this->m_allocator);
+        }
+    }
+
+    this->m_frames.clear();
+    this->m_device = VK_NULL_HANDLE;
+}
+
+bool Hush::VulkanInstanceBuffer::IsInitialized() const noexcept
+{
+    return this->m_device != VK_NULL_HANDLE;
+}
+
+VkDeviceAddress Hush::VulkanInstanceBuffer::Upload(uint32_t frameIndex, std::span<const GPUDrawInstance> instances)
+{
+    FrameBuffer& frame = this->m_frames[frameIndex % this->m_frames.size()];
+    this->Reserve(frame, static_cast<uint32_t>(instances.size()));
+
+    if (!instances.empty())
+    {
+        std::memcpy(frame.buffer.GetAllocationInfo().pMappedData, instances.data(), instances.size_bytes());
+        // No-op for host coherent memory
+        vmaFlushAllocation(this->m_allocator, frame.buffer.GetAllocation(), 0, instances.size_bytes());
+    }
+
+    return frame.address;
+}
+
+void Hush::VulkanInstanceBuffer::Reserve(FrameBuffer& frame, uint32_t instanceCount)
+{
+    // The first frame allocates even without instances, so the address is always valid
+    if (frame.capacity > 0u && instanceCount <= frame.capacity)
+    {
+        return;
+    }
+
+    // Only called once the fence of the frame was waited on, the GPU no longer uses the old buffer
+    if (frame.capacity > 0u)
+    {
+        frame.buffer.Dispose(this->m_allocator);
+    }
+
+    uint32_t capacity = std::max(frame.capacity, MIN_INSTANCE_CAPACITY);
+    while (capacity < instanceCount)
+    {
+        capacity *= 2u;
+    }
+
+    frame.capacity = capacity;
+    frame.buffer = VulkanAllocatedBuffer(capacity * static_cast<uint32_t>(sizeof(GPUDrawInstance)),
+                                         VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                                         VMA_MEMORY_USAGE_CPU_TO_GPU, this->m_allocator);
+
+    VkBufferDeviceAddressInfo deviceAddressInfo{};
+    deviceAddressInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+    deviceAddressInfo.buffer = frame.buffer.GetBuffer();
+    frame.address = vkGetBufferDeviceAddress(this->m_device, &deviceAddressInfo);
+}
@@ -0,0 +1,61 @@
+/*! \file VulkanInstanceBuffer.hpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Per frame storage buffer with the instances of instanced draws
+*/
+
+#pragma once
+
+#include "VkTypes.hpp"
+#include "VulkanAllocatedBuffer.hpp"
+#include "vk_mem_alloc.hpp"
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Hush
+{
+    /// @brief One mapped storage buffer per frame in flight, read by mesh_instanced.vert through its device address.
+    /// A buffer only grows, and only once the fence of its frame was waited on
+    class VulkanInstanceBuffer final
+    {
+      public:
+        VulkanInstanceBuffer() = default;
+
+        VulkanInstanceBuffer(const VulkanInstanceBuffer&) = delete;
+        VulkanInstanceBuffer& operator=(const VulkanInstanceBuffer&) = delete;
+
+        /// @brief Sets up the buffers, they are created lazily on the first upload
+        /// @param device Logical device
+        /// @param allocator VMA allocator
+        /// @param frameCount Number of frames in flight
+        void Init(VkDevice device, VmaAllocator allocator, uint32_t frameCount);
+
+        void Dispose();
+
+        [[nodiscard]] bool IsInitialized() const noexcept;
+
+        /// @brief Copies the instances of a frame to its buffer. The fence of the frame must have been waited on
+        /// @param frameIndex Index of the frame in flight
+        /// @param instances Instances to copy
+        /// @return Device address of the first instance
+        VkDeviceAddress Upload(uint32_t frameIndex, std::span<const GPUDrawInstance> instances);
+
+      private:
+        struct FrameBuffer
+        {
+            VulkanAllocatedBuffer buffer;
+            VkDeviceAddress address = 0;
+            uint32_t capacity = 0;
+        };
+
+        /// @brief Makes sure the buffer of a frame holds at least instanceCount instances
+        void Reserve(FrameBuffer& frame, uint32_t instanceCount);
+
+        VkDevice m_device = VK_NULL_HANDLE;
+        VmaAllocator m_allocator = nullptr;
+        std::vector<FrameBuffer> m_frames;
+    };
+} // namespace Hush
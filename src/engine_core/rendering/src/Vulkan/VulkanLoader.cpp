@@ -148,6 +148,7 @@ Hush::VulkanMeshNode Hush::VulkanLoader::CreateMeshFromGltfMesh(const fastgltf::
 			});
 
 		std::vector<glm::vec3> vertexBuffer = GltfLoadFunctions::FindAttributeByName<glm::vec3>(primitive, asset, "POSITION");
+		surfaceToAdd.bounds = Bounds::FromPoints(vertexBuffer);
 		for (const glm::vec3& v : vertexBuffer) {
 			Vertex vertexToAdd{};
 			vertexToAdd.position = v;
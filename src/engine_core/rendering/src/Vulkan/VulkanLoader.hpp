@@ -16,6 +16,7 @@
 #include <fastgltf/types.hpp>
 #include <Result.hpp>
 #include "VkMaterialInstance.hpp"
+#include "Shared/Frustum.hpp"
 #include "Shared/ImageTexture.hpp"
 #include "VulkanMeshNode.hpp"
 
@@ -24,6 +25,7 @@ namespace Hush {
 	struct GeoSurface {
 		uint32_t startIndex;
 		uint32_t count;
+		Bounds bounds;
 		std::shared_ptr<VkMaterialInstance> material;
 	};
 
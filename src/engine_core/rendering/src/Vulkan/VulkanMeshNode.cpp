@@ -25,6 +25,7 @@ void Hush::VulkanMeshNode::Draw(const glm::mat4& topMatrix, void* drawContext)
 
 		def.transform = nodeMatrix;
 		def.vertexBufferAddress = this->m_mesh->meshBuffers.vertexBufferAddress;
+		def.bounds = s.bounds;
 		if (s.material->passType == EMaterialPass::Transparent) {
 			drawCtxImpl->transparentSurfaces.push_back(def);
 		}
@@ -22,6 +22,7 @@
 #define VOLK_IMPLEMENTATION
 
 #include "Assertions.hpp"
+#include "FrameAllocator.hpp"
 #include "ImGui/VulkanImGuiForwarder.hpp"
 #include "VkUtilsFactory.hpp"
 #include "VulkanPipelineBuilder.hpp"
@@ -35,6 +36,19 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/transform.hpp>
 #include "VulkanMeshNode.hpp"
+#include <ThreadPool.hpp>
+#include <algorithm>
+#include <filesystem>
+
+namespace
+{
+    /// @brief Path of a compiled shader. The build compiles the shaders of res/ into HUSH_SHADER_DIR, or points it
+    /// to res/ itself when no GLSL compiler is available
+    std::string GetShaderPath(std::string_view fileName)
+    {
+        return (std::filesystem::path(HUSH_SHADER_DIR) / fileName).string();
+    }
+} // namespace
 
 PFN_vkVoidFunction Hush::VulkanRenderer::CustomVulkanFunctionLoader(const char *functionName, void *userData)
 {
@@ -172,13 +186,30 @@ void Hush::VulkanRenderer::InitImGui()
  
 void Hush::VulkanRenderer::Draw(float delta)
 {
+    this->Extract(delta);
+    this->Submit();
+}
+
+void Hush::VulkanRenderer::Extract(float delta)
+{
+    // Resizing waits for the device, it must not happen while a frame is being submitted
     if (this->m_resizeRequested) {
         this->ResizeSwapchain();
-        return;
     }
-    
+
     this->UpdateSceneObjects(delta);
 
+    auto* uiImpl = dynamic_cast<VulkanImGuiForwarder*>(this->m_uiForwarder.get());
+    uiImpl->CopyDrawData(&this->m_snapshot.uiDrawData);
+}
+
+void Hush::VulkanRenderer::Submit()
+{
+    if (this->m_resizeRequested) {
+        // Skip the frame, the swapchain is resized on the next extract
+        return;
+    }
+
     //Prepare and flush the render command
     FrameData &currentFrame = this->GetCurrentFrame();
     uint32_t swapchainImageIndex = 0u;
@@ -188,6 +219,14 @@ void Hush::VulkanRenderer::Draw(float delta)
         return;
     }
 
+    // The fence of this frame was waited on, the GPU is done with its uniforms
+    this->m_uniformRing.BeginFrame(this->m_frameNumber % FRAME_OVERLAP);
+    if (this->m_snapshot.instancedOpaque)
+    {
+        this->m_instanceBufferAddress =
+            this->m_instanceBuffer.Upload(this->m_frameNumber % FRAME_OVERLAP, this->m_snapshot.drawInstances);
+    }
+
     VkImage currentImage = this->m_swapchain.GetImages().at(swapchainImageIndex);
 
     this->TransitionImage(cmd, this->m_drawImage.image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL);
@@ -196,6 +235,14 @@ void Hush::VulkanRenderer::Draw(float delta)
 	this->TransitionImage(cmd, this->m_drawImage.image, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
 	this->TransitionImage(cmd, this->m_depthImage.image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL);
     //Geometry
+    if (this->m_snapshot.gpuDrivenOpaque)
+    {
+        // Dispatches can't be recorded inside the rendering instance, cull before the geometry pass
+        this->m_indirectDrawer.Prepare(this->m_frameNumber % FRAME_OVERLAP,
+                                       std::span(this->m_snapshot.drawContext.opaqueSurfaces)
+                                           .first(this->m_snapshot.indirectOpaqueCount));
+        this->m_indirectDrawer.RecordCulling(cmd, Frustum::FromViewProjection(this->m_snapshot.sceneData.viewproj));
+    }
     this->DrawGeometry(cmd);
 
 	//transtion the draw image and the swapchain image into their correct transfer layouts
@@ -234,46 +281,74 @@ void Hush::VulkanRenderer::EndUIFrame() const noexcept
     this->m_uiForwarder->EndFrame();
 }
 
-void Hush::VulkanRenderer::HandleEvent(const SDL_Event *event) noexcept
+void Hush::VulkanRenderer::HandleEvents(std::span<const SDL_Event> events) noexcept
 {
-    this->m_uiForwarder->HandleEvent(event);
+    for (const SDL_Event &event : events)
+    {
+        this->m_uiForwarder->HandleEvent(&event);
+    }
 }
 
 void Hush::VulkanRenderer::UpdateSceneObjects(float delta)
 {
 
     this->m_editorCamera.OnUpdate(delta);
-	this->m_mainDrawContext.opaqueSurfaces.clear();
-	this->m_mainDrawContext.transparentSurfaces.clear();
+	this->m_snapshot.drawContext.opaqueSurfaces.clear();
+	this->m_snapshot.drawContext.transparentSurfaces.clear();
 	// Test stuff just to show that it works... to be refactored into a more dynamic approach
 	glm::mat4 topMatrix{ 1.0f };
     for (auto& nodeEntry : this->m_loadedNodes)
     {
-	    nodeEntry.second->Draw(topMatrix, &this->m_mainDrawContext);
+	    nodeEntry.second->Draw(topMatrix, &this->m_snapshot.drawContext);
     }
 
     glm::mat4 scaleMat = glm::scale(glm::mat4(1.0f), glm::vec3{1.0f});
     glm::mat4 viewMatrix = this->m_editorCamera.GetViewMatrix() * scaleMat;
-	this->m_sceneData.view = viewMatrix;
+	this->m_snapshot.sceneData.view = viewMatrix;
 	// camera projection
-	//this->m_sceneData.proj = this->m_editorCamera.GetProjectionMatrix();
-	this->m_sceneData.proj = glm::perspective(glm::radians(70.f), (float)this->m_width / (float)this->m_height, 10000.f, 0.1f);
+	//this->m_snapshot.sceneData.proj = this->m_editorCamera.GetProjectionMatrix();
+	this->m_snapshot.sceneData.proj = glm::perspective(glm::radians(70.f), (float)this->m_width / (float)this->m_height, 10000.f, 0.1f);
 
 	// invert the Y direction on projection matrix so that we are more similar
 	// to opengl and gltf axis
-	this->m_sceneData.proj[1][1] *= -1;
-	this->m_sceneData.viewproj = this->m_sceneData.proj * this->m_sceneData.view;
+	this->m_snapshot.sceneData.proj[1][1] *= -1;
+	this->m_snapshot.sceneData.viewproj = this->m_snapshot.sceneData.proj * this->m_snapshot.sceneData.view;
 
 	//some default lighting parameters
-	this->m_sceneData.ambientColor = glm::vec4(.1f);
-	this->m_sceneData.sunlightColor = glm::vec4(1.f);
-	this->m_sceneData.sunlightDirection = glm::vec4(0, 1, 0.5, 1.f);
+	this->m_snapshot.sceneData.ambientColor = glm::vec4(.1f);
+	this->m_snapshot.sceneData.sunlightColor = glm::vec4(1.f);
+	this->m_snapshot.sceneData.sunlightDirection = glm::vec4(0, 1, 0.5, 1.f);
+
+	this->m_snapshot.gpuDrivenOpaque = this->m_gpuDrivenRendering;
+	this->CullDrawContext();
+
+	// Surfaces sharing state end up next to each other, so DrawGeometry can skip most binds
+	this->m_drawSorter.SortOpaque(this->m_snapshot.drawContext.opaqueSurfaces, this->m_snapshot.sceneData.view);
+	this->m_drawSorter.SortTransparent(this->m_snapshot.drawContext.transparentSurfaces, this->m_snapshot.sceneData.view);
+
+	if (this->m_snapshot.gpuDrivenOpaque)
+	{
+		this->SplitIndirectOpaque();
+	}
+
+	// Copies of the same surface become a single instanced draw, transparent ones must keep their back to front order
+	this->m_snapshot.instancedOpaque = !this->m_snapshot.gpuDrivenOpaque && this->m_automaticInstancing &&
+									   this->m_instanceBuffer.IsInitialized();
+	if (this->m_snapshot.instancedOpaque)
+	{
+		this->m_drawInstancer.Build(this->m_snapshot.drawContext.opaqueSurfaces, this->m_snapshot.instancedDraws,
+									this->m_snapshot.drawInstances);
+	}
 }
 
 void Hush::VulkanRenderer::InitRendering()
 {
     this->CreateSyncObjects();
 
+    this->m_uniformRing.Init(this->m_allocator, UNIFORM_RING_BYTES_PER_FRAME, FRAME_OVERLAP,
+                             this->m_minUniformBufferOffsetAlignment);
+    this->m_mainDeletionQueue.PushFunction([&]() { m_uniformRing.Dispose(); });
+
     this->InitializeCommands();
 
     this->InitDescriptors();
@@ -291,6 +366,7 @@ void Hush::VulkanRenderer::InitRendering()
 
 void Hush::VulkanRenderer::Dispose()
 {
+    VulkanImGuiForwarder::ReleaseDrawData(&this->m_snapshot.uiDrawData);
     this->m_uiForwarder->Dispose();
     LogTrace("Disposed of ImGui resources");
     if (this->m_device != nullptr)
@@ -308,6 +384,10 @@ void Hush::VulkanRenderer::Dispose()
             this->m_frames.at(i).deletionQueue.Flush();
             // Delete any command pools
             vkDestroyCommandPool(this->m_device, this->m_frames.at(i).commandPool, nullptr);
+            for (VkCommandPool workerPool : this->m_frames.at(i).workerCommandPools)
+            {
+                vkDestroyCommandPool(this->m_device, workerPool, nullptr);
+            }
             // Destroy the sync objects
             vkDestroyFence(this->m_device, this->m_frames.at(i).renderFence, nullptr);
             vkDestroySemaphore(this->m_device, this->m_frames.at(i).renderSemaphore, nullptr);
@@ -357,7 +437,10 @@ void Hush::VulkanRenderer::ImmediateSubmit(std::function<void(VkCommandBuffer cm
         VkUtilsFactory::CreateCommandBufferSubmitInfo(this->m_immediateCommandBuffer);
     VkSubmitInfo2 submit = this->SubmitInfo(&cmdSubmitInfo, nullptr, nullptr);
 
-    rc = vkQueueSubmit2(this->m_graphicsQueue, 1u, &submit, this->m_immediateFence);
+    {
+        std::unique_lock<std::mutex> queueLock = this->LockGraphicsQueue();
+        rc = vkQueueSubmit2(this->m_graphicsQueue, 1u, &submit, this->m_immediateFence);
+    }
     HUSH_VK_ASSERT(rc, "Failed to submit graphics queue!");
 
     rc = vkWaitForFences(this->m_device, 1u, &this->m_immediateFence, VK_TRUE, 9999999999);
@@ -409,6 +492,136 @@ VkQueue Hush::VulkanRenderer::GetGraphicsQueue() const noexcept
     return this->m_graphicsQueue;
 }
 
+std::unique_lock<std::mutex> Hush::VulkanRenderer::LockGraphicsQueue()
+{
+    return std::unique_lock<std::mutex>(this->m_graphicsQueueMutex);
+}
+
+Hush::VulkanUniformRing &Hush::VulkanRenderer::GetUniformRing() noexcept
+{
+    return this->m_uniformRing;
+}
+
+void Hush::VulkanRenderer::SetThreadPool(Threading::ThreadPool *threadPool) noexcept
+{
+    this->m_threadPool = threadPool;
+}
+
+uint32_t Hush::VulkanRenderer::GetVisibleSurfaceCount() const noexcept
+{
+    return this->m_visibleSurfaceCount;
+}
+
+uint32_t Hush::VulkanRenderer::GetCulledSurfaceCount() const noexcept
+{
+    return this->m_culledSurfaceCount;
+}
+
+void Hush::VulkanRenderer::SetGpuDrivenRendering(bool enabled) noexcept
+{
+    if (enabled && !this->IsGpuDrivenRenderingSupported())
+    {
+        LogWarn("GPU driven rendering is not supported by this device, keeping the CPU path");
+        return;
+    }
+
+    this->m_gpuDrivenRendering = enabled;
+}
+
+bool Hush::VulkanRenderer::IsGpuDrivenRenderingEnabled() const noexcept
+{
+    return this->m_gpuDrivenRendering;
+}
+
+bool Hush::VulkanRenderer::IsGpuDrivenRenderingSupported() const noexcept
+{
+    return this->m_supportsIndirectCount && this->m_indirectDrawer.IsInitialized();
+}
+
+void Hush::VulkanRenderer::SetAutomaticInstancing(bool enabled) noexcept
+{
+    this->m_automaticInstancing = enabled;
+}
+
+bool Hush::VulkanRenderer::IsAutomaticInstancingEnabled() const noexcept
+{
+    return this->m_automaticInstancing;
+}
+
+size_t Hush::VulkanRenderer::GetOpaqueDrawCount() const noexcept
+{
+    return this->m_snapshot.instancedOpaque ? this->m_snapshot.instancedDraws.size()
+                                            : this->m_snapshot.drawContext.opaqueSurfaces.size();
+}
+
+void Hush::VulkanRenderer::CullDrawContext()
+{
+    const Frustum frustum = Frustum::FromViewProjection(this->m_snapshot.sceneData.viewproj);
+
+    this->m_visibleSurfaceCount = 0u;
+    this->m_culledSurfaceCount = 0u;
+
+    // The compute pass culls them, transparent surfaces always take the CPU path
+    if (!this->m_snapshot.gpuDrivenOpaque)
+    {
+        this->CullSurfaces(frustum, this->m_snapshot.drawContext.opaqueSurfaces);
+    }
+    this->CullSurfaces(frustum, this->m_snapshot.drawContext.transparentSurfaces);
+}
+
+void Hush::VulkanRenderer::SplitIndirectOpaque()
+{
+    std::vector<VkRenderObject> &opaqueSurfaces = this->m_snapshot.drawContext.opaqueSurfaces;
+
+    // Stable, both halves keep the state order of the sort
+    const auto fallbackBegin =
+        std::stable_partition(opaqueSurfaces.begin(), opaqueSurfaces.end(), [](const VkRenderObject &surface) {
+            return surface.material->pipeline->instancedPipeline != VK_NULL_HANDLE;
+        });
+    this->m_snapshot.indirectOpaqueCount = static_cast<size_t>(fallbackBegin - opaqueSurfaces.begin());
+
+    // The compute pass culls the indirect ones, the rest are culled here
+    this->CullSurfaces(Frustum::FromViewProjection(this->m_snapshot.sceneData.viewproj), opaqueSurfaces,
+                       this->m_snapshot.indirectOpaqueCount);
+}
+
+void Hush::VulkanRenderer::CullSurfaces(const Frustum &frustum, std::vector<VkRenderObject> &surfaces, size_t first)
+{
+    const size_t surfaceCount = surfaces.size() - first;
+    this->m_cullSpheres.resize(surfaceCount);
+    this->m_cullVisibility.resize(surfaceCount);
+
+    for (size_t i = 0; i < surfaceCount; ++i)
+    {
+        const VkRenderObject &surface = surfaces[first + i];
+        this->m_cullSpheres[i] = surface.bounds.GetWorldSphere(surface.transform);
+    }
+
+    // Big scenes are split across the thread pool, see Frustum::PARALLEL_THRESHOLD
+    frustum.TestSpheres(this->m_cullSpheres, this->m_cullVisibility, this->m_threadPool);
+
+    // Compact in place, draw order is kept for the transparent pass
+    size_t visibleCount = 0;
+    for (size_t i = 0; i < surfaceCount; ++i)
+    {
+        if (this->m_cullVisibility[i] == 0)
+        {
+            continue;
+        }
+
+        if (visibleCount != i)
+        {
+            surfaces[first + visibleCount] = surfaces[first + i];
+        }
+        ++visibleCount;
+    }
+
+    surfaces.resize(first + visibleCount);
+
+    this->m_visibleSurfaceCount += static_cast<uint32_t>(visibleCount);
+    this->m_culledSurfaceCount += static_cast<uint32_t>(surfaceCount - visibleCount);
+}
+
 FrameData &Hush::VulkanRenderer::GetCurrentFrame() noexcept
 {
     return this->m_frames.at(this->m_frameNumber % FRAME_OVERLAP);
@@ -471,6 +684,18 @@ void Hush::VulkanRenderer::Configure(vkb::Instance vkbInstance)
                                                 .select()
                                                 .value();
 
+    // Optional, only the GPU driven path needs them (lavapipe has them, MoltenVK lacks drawIndirectCount)
+    VkPhysicalDeviceFeatures indirectFeatures{};
+    indirectFeatures.multiDrawIndirect = VK_TRUE;
+    indirectFeatures.drawIndirectFirstInstance = VK_TRUE;
+
+    VkPhysicalDeviceVulkan12Features indirectCountFeatures{};
+    indirectCountFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    indirectCountFeatures.drawIndirectCount = VK_TRUE;
+
+    this->m_supportsIndirectCount = vkbPhysicalDevice.enable_features_if_present(indirectFeatures) &&
+                                    vkbPhysicalDevice.enable_extension_features_if_present(indirectCountFeatures);
+
     // Get our virtual device based on the physical one
     vkb::DeviceBuilder deviceBuilder(vkbPhysicalDevice);
 
@@ -482,6 +707,7 @@ void Hush::VulkanRenderer::Configure(vkb::Instance vkbInstance)
 
     VkPhysicalDeviceProperties properties{};
     vkGetPhysicalDeviceProperties(this->m_vulkanPhysicalDevice, &properties);
+    this->m_minUniformBufferOffsetAlignment = properties.limits.minUniformBufferOffsetAlignment;
 
     // Get the queue
     vkb::Result<VkQueue> queueResult = vkbDevice.get_queue(vkb::QueueType::graphics);
@@ -748,9 +974,30 @@ void Hush::VulkanRenderer::InitPipelines() noexcept
     this->InitBackgroundPipelines();
     this->InitMeshPipeline();
 
-	constexpr std::string_view fragmentShaderPath = "C:\\Users\\nefes\\Personal\\Hush-Engine\\res\\mesh.frag.spv";
-    constexpr std::string_view vertexShaderPath = "C:\\Users\\nefes\\Personal\\Hush-Engine\\res\\mesh.vert.spv";
-    this->m_metalRoughMaterial.BuildPipelines(this, fragmentShaderPath, vertexShaderPath);
+	const std::string fragmentShaderPath = GetShaderPath("mesh.frag.spv");
+    const std::string vertexShaderPath = GetShaderPath("mesh.vert.spv");
+    const std::string instancedVertexShaderPath = GetShaderPath("mesh_instanced.vert.spv");
+    this->m_metalRoughMaterial.BuildPipelines(this, fragmentShaderPath, vertexShaderPath, instancedVertexShaderPath);
+
+    if (this->m_metalRoughMaterial.opaquePipeline.instancedPipeline == VK_NULL_HANDLE)
+    {
+        // Every opaque surface is drawn on its own
+        return;
+    }
+
+    this->m_instanceBuffer.Init(this->m_device, this->m_allocator, FRAME_OVERLAP);
+    this->m_mainDeletionQueue.PushFunction([&]() {
+        this->m_instanceBuffer.Dispose();
+        vkDestroyPipeline(this->m_device, this->m_metalRoughMaterial.opaquePipeline.instancedPipeline, nullptr);
+    });
+
+    // The GPU driven path stays unsupported unless the device has the indirect count features
+    const std::string cullShaderPath = GetShaderPath("indirect_cull.comp.spv");
+    if (this->m_supportsIndirectCount &&
+        this->m_indirectDrawer.Init(this->m_device, this->m_allocator, cullShaderPath, FRAME_OVERLAP))
+    {
+        this->m_mainDeletionQueue.PushFunction([&]() { this->m_indirectDrawer.Dispose(); });
+    }
 }
 
 void Hush::VulkanRenderer::InitBackgroundPipelines() noexcept
@@ -763,7 +1010,7 @@ void Hush::VulkanRenderer::InitBackgroundPipelines() noexcept
 
     // layout code
     VkShaderModule computeDrawShader = nullptr;
-    constexpr std::string_view shaderPath = "C:\\Users\\nefes\\Personal\\Hush-Engine\\res\\gradient_color.comp.spv";
+    const std::string shaderPath = GetShaderPath("gradient_color.comp.spv");
     if (!VulkanHelper::LoadShaderModule(shaderPath, this->m_device, &computeDrawShader))
     {
         LogError("Error when building the compute shader");
@@ -807,8 +1054,8 @@ void Hush::VulkanRenderer::InitBackgroundPipelines() noexcept
 
 void Hush::VulkanRenderer::InitMeshPipeline() noexcept
 {
-	constexpr std::string_view fragmentShaderPath = "C:\\Users\\nefes\\Personal\\Hush-Engine\\res\\tex_image.frag.spv";
-    constexpr std::string_view vertexShaderPath = "C:\\Users\\nefes\\Personal\\Hush-Engine\\res\\colored_triangle_mesh.vert.spv";
+	const std::string fragmentShaderPath = GetShaderPath("tex_image.frag.spv");
+    const std::string vertexShaderPath = GetShaderPath("colored_triangle_mesh.vert.spv");
 
 	VkShaderModule triangleFragShader;
 	if (!VulkanHelper::LoadShaderModule(fragmentShaderPath, this->m_device, &triangleFragShader)) {
@@ -950,25 +1197,20 @@ void Hush::VulkanRenderer::InitDefaultData() noexcept
 
 void Hush::VulkanRenderer::DrawGeometry(VkCommandBuffer cmd)
 {
-	////allocate a new uniform buffer for the scene data
-	VulkanAllocatedBuffer gpuSceneDataBuffer(sizeof(GPUSceneData), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU, this->m_allocator);
-    
-	////add it to the deletion queue of this frame so it gets deleted once its been used
-	this->GetCurrentFrame().deletionQueue.PushFunction([=, this]() {
-		    gpuSceneDataBuffer.Dispose(m_allocator);
-	});
-    
-	////write the buffer
-	GPUSceneData* sceneUniformData = (GPUSceneData*)gpuSceneDataBuffer.GetAllocation()->GetMappedData();
-	*sceneUniformData = this->m_sceneData;
+	// Scene data goes to the uniform ring, no buffer is created per frame
+	const VulkanUniformRing::Allocation sceneUniform = this->m_uniformRing.Push(this->m_snapshot.sceneData);
+	if (sceneUniform.data == nullptr)
+	{
+		return;
+	}
 
 	//create a descriptor set that binds that buffer and update it
 	VkDescriptorSet globalDescriptor = this->GetCurrentFrame().frameDescriptors.Allocate(this->m_device, this->m_gpuSceneDataDescriptorLayout);
     
     // Local scope to use another writer later one
     {
-	    DescriptorWriter writer;
-	    writer.WriteBuffer(0, gpuSceneDataBuffer.GetBuffer(), sizeof(GPUSceneData), 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
+	    DescriptorWriter writer(Hush::GetFrameResource());
+	    writer.WriteBuffer(0, sceneUniform.buffer, sizeof(GPUSceneData), sceneUniform.offset, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
 	    writer.UpdateSet(this->m_device, globalDescriptor);
     }
 
@@ -991,7 +1233,118 @@ void Hush::VulkanRenderer::DrawGeometry(VkCommandBuffer cmd)
     };
 
 	VkRenderingInfo renderInfo = VkUtilsFactory::CreateRenderingInfo(extent, &colorAttachment, &depthAttachment);
+
+	const size_t drawCount = this->GetOpaqueDrawCount() + this->m_snapshot.drawContext.transparentSurfaces.size();
+
+	if (this->m_snapshot.gpuDrivenOpaque)
+	{
+		// Opaque surfaces cost one indirect draw per batch, only transparent ones and opaque ones without an instanced
+		// pipeline are recorded one by one
+		vkCmdBeginRendering(cmd, &renderInfo);
+		this->SetViewportAndScissor(cmd);
+		this->m_indirectDrawer.RecordDraws(cmd, globalDescriptor);
+		this->RecordDrawRange(cmd, globalDescriptor, this->m_snapshot.indirectOpaqueCount, drawCount);
+		vkCmdEndRendering(cmd);
+		return;
+	}
+
+	if (this->m_threadPool != nullptr && drawCount >= PARALLEL_RECORDING_THRESHOLD)
+	{
+		this->RecordDrawsInParallel(cmd, renderInfo, globalDescriptor, drawCount);
+		return;
+	}
+
 	vkCmdBeginRendering(cmd, &renderInfo);
+	this->RecordDrawRange(cmd, globalDescriptor, 0, drawCount);
+	vkCmdEndRendering(cmd);
+}
+
+void Hush::VulkanRenderer::RecordDrawsInParallel(VkCommandBuffer cmd, VkRenderingInfo renderInfo,
+                                                 VkDescriptorSet globalDescriptor, size_t drawCount)
+{
+    FrameData& currentFrame = this->GetCurrentFrame();
+
+    // One chunk per thread, the calling thread records the first one
+    const uint32_t chunkCount = this->m_threadPool->GetNumThreads() + 1u;
+    const size_t drawsPerChunk = (drawCount + chunkCount - 1u) / chunkCount;
+    this->CreateWorkerCommandBuffers(currentFrame, chunkCount);
+
+    // Secondaries recorded inside a dynamic rendering instance must declare its attachment formats
+    const VkFormat colorFormat = this->m_drawImage.imageFormat;
+    VkCommandBufferInheritanceRenderingInfo inheritanceRendering = {};
+    inheritanceRendering.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO;
+    inheritanceRendering.colorAttachmentCount = 1u;
+    inheritanceRendering.pColorAttachmentFormats = &colorFormat;
+    inheritanceRendering.depthAttachmentFormat = this->m_depthImage.imageFormat;
+    inheritanceRendering.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    VkCommandBufferInheritanceInfo inheritance = {};
+    inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritance.pNext = &inheritanceRendering;
+
+    const auto recordChunk = [&](size_t chunk) {
+        const size_t first = std::min(drawCount, chunk * drawsPerChunk);
+        const size_t last = std::min(drawCount, first + drawsPerChunk);
+
+        // Each pool is only touched by the job recording its chunk
+        VkResult rc = vkResetCommandPool(this->m_device, currentFrame.workerCommandPools[chunk], 0u);
+        HUSH_VK_ASSERT(rc, "Reset worker command pool failed!");
+
+        VkCommandBuffer secondary = currentFrame.workerCommandBuffers[chunk];
+        VkCommandBufferBeginInfo beginInfo = VkUtilsFactory::CreateCommandBufferBeginInfo(
+            VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT);
+        beginInfo.pInheritanceInfo = &inheritance;
+
+        rc = vkBeginCommandBuffer(secondary, &beginInfo);
+        HUSH_VK_ASSERT(rc, "Begin secondary command buffer failed!");
+        this->RecordDrawRange(secondary, globalDescriptor, first, last);
+        rc = vkEndCommandBuffer(secondary);
+        HUSH_VK_ASSERT(rc, "End secondary command buffer failed!");
+    };
+
+    // As many chunks as threads, so each job records exactly one
+    this->m_threadPool->ParallelFor(chunkCount, 1u, [&recordChunk](size_t first, size_t last) {
+        for (size_t chunk = first; chunk < last; ++chunk)
+        {
+            recordChunk(chunk);
+        }
+    });
+
+    // Chunks are executed in order, so the sorted draw order is kept
+    renderInfo.flags = VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT;
+    vkCmdBeginRendering(cmd, &renderInfo);
+    vkCmdExecuteCommands(cmd, chunkCount, currentFrame.workerCommandBuffers.data());
+    vkCmdEndRendering(cmd);
+}
+
+void Hush::VulkanRenderer::CreateWorkerCommandBuffers(FrameData& frame, uint32_t count)
+{
+    const VkCommandPoolCreateInfo commandPoolInfo =
+        VkUtilsFactory::CreateCommandPoolInfo(this->m_graphicsQueueFamily, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
+
+    while (frame.workerCommandPools.size() < count)
+    {
+        VkCommandPool pool = VK_NULL_HANDLE;
+        VkResult rc = vkCreateCommandPool(this->m_device, &commandPoolInfo, nullptr, &pool);
+        HUSH_VK_ASSERT(rc, "Creating worker command pool failed!");
+
+        VkCommandBuffer secondary = VK_NULL_HANDLE;
+        VkCommandBufferAllocateInfo cmdAllocInfo =
+            VkUtilsFactory::CreateCommandBufferAllocateInfo(pool, 1u, VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+        rc = vkAllocateCommandBuffers(this->m_device, &cmdAllocInfo, &secondary);
+        HUSH_VK_ASSERT(rc, "Allocating worker command buffer failed!");
+
+        frame.workerCommandPools.push_back(pool);
+        frame.workerCommandBuffers.push_back(secondary);
+    }
+}
+
+void Hush::VulkanRenderer::SetViewportAndScissor(VkCommandBuffer cmd)
+{
+	const VkExtent2D extent = {
+		this->m_width,
+		this->m_height
+	};
 
 	//set dynamic viewport and scissor
 	VkViewport viewport = {};
@@ -1010,16 +1363,48 @@ void Hush::VulkanRenderer::DrawGeometry(VkCommandBuffer cmd)
 	scissor.extent.width = extent.width;
 	scissor.extent.height = extent.height;
 
-	vkCmdSetScissor(cmd, 0, 1, &scissor);	
+	vkCmdSetScissor(cmd, 0, 1, &scissor);
+}
+
+void Hush::VulkanRenderer::RecordDrawRange(VkCommandBuffer cmd, VkDescriptorSet globalDescriptor, size_t first,
+                                           size_t last)
+{
+	//every secondary command buffer needs its own dynamic state
+	this->SetViewportAndScissor(cmd);
 
     int32_t drawCalls = 0;
 
-    auto drawRenderObject = [&](const VkRenderObject& draw) {
-        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, draw.material->pipeline->pipeline);
-        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, draw.material->pipeline->layout, 0, 1, &globalDescriptor, 0, nullptr);
-        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, draw.material->pipeline->layout, 1, 1, &draw.material->materialSet, 0, nullptr);
+    // The draw lists are sorted by state, only bind what changed since the previous draw
+    VkPipeline lastPipeline = VK_NULL_HANDLE;
+    const VkMaterialInstance* lastMaterial = nullptr;
+    VkBuffer lastIndexBuffer = VK_NULL_HANDLE;
 
-        vkCmdBindIndexBuffer(cmd, draw.indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+    // Instanced variants share the layout of their material pipeline
+    auto bindState = [&](const VkRenderObject& draw, VkPipeline pipeline) {
+        if (pipeline != lastPipeline)
+        {
+            lastPipeline = pipeline;
+            // A different layout might disturb the bound sets, bind them again
+            lastMaterial = nullptr;
+            vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+            vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, draw.material->pipeline->layout, 0, 1, &globalDescriptor, 0, nullptr);
+        }
+
+        if (draw.material != lastMaterial)
+        {
+            lastMaterial = draw.material;
+            vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, draw.material->pipeline->layout, 1, 1, &draw.material->materialSet, 0, nullptr);
+        }
+
+        if (draw.indexBuffer != lastIndexBuffer)
+        {
+            lastIndexBuffer = draw.indexBuffer;
+            vkCmdBindIndexBuffer(cmd, draw.indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+        }
+    };
+
+    auto drawRenderObject = [&](const VkRenderObject& draw) {
+        bindState(draw, draw.material->pipeline->pipeline);
 
         GPUDrawPushConstants pushConstants;
         pushConstants.vertexBuffer = draw.vertexBufferAddress;
@@ -1029,15 +1414,47 @@ void Hush::VulkanRenderer::DrawGeometry(VkCommandBuffer cmd)
         drawCalls++;
     };
 
-	for (const VkRenderObject& draw : this->m_mainDrawContext.opaqueSurfaces) {
-        drawRenderObject(draw);
-	}
+    auto drawInstanced = [&](const InstancedDraw& group) {
+        const VkRenderObject& draw = group.surface;
+        // Groups without an instanced pipeline always hold a single surface
+        if (draw.material->pipeline->instancedPipeline == VK_NULL_HANDLE)
+        {
+            drawRenderObject(draw);
+            return;
+        }
 
-	for (const VkRenderObject& draw : this->m_mainDrawContext.transparentSurfaces) {
-		drawRenderObject(draw);
-	}
+        bindState(draw, draw.material->pipeline->instancedPipeline);
 
-	vkCmdEndRendering(cmd);
+        // mesh_instanced.vert reads the transforms from the instance buffer, the matrix is unused
+        GPUDrawPushConstants pushConstants;
+        pushConstants.vertexBuffer = this->m_instanceBufferAddress;
+        pushConstants.worldMatrix = glm::mat4(1.0f);
+        vkCmdPushConstants(cmd, draw.material->pipeline->layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(GPUDrawPushConstants), &pushConstants);
+        vkCmdDrawIndexed(cmd, draw.indexCount, group.instanceCount, draw.firstIndex, 0, group.firstInstance);
+        drawCalls++;
+    };
+
+    // Opaque and transparent draws are one list for chunking purposes, opaque first
+    const std::vector<VkRenderObject>& opaqueSurfaces = this->m_snapshot.drawContext.opaqueSurfaces;
+    const std::vector<InstancedDraw>& instancedDraws = this->m_snapshot.instancedDraws;
+    const std::vector<VkRenderObject>& transparentSurfaces = this->m_snapshot.drawContext.transparentSurfaces;
+    const size_t opaqueDrawCount = this->GetOpaqueDrawCount();
+
+    for (size_t i = first; i < last; ++i)
+    {
+        if (i >= opaqueDrawCount)
+        {
+            drawRenderObject(transparentSurfaces[i - opaqueDrawCount]);
+        }
+        else if (this->m_snapshot.instancedOpaque)
+        {
+            drawInstanced(instancedDraws[i]);
+        }
+        else
+        {
+            drawRenderObject(opaqueSurfaces[i]);
+        }
+    }
 }
 
 void Hush::VulkanRenderer::DrawBackground(VkCommandBuffer cmd) noexcept
@@ -1067,7 +1484,7 @@ void Hush::VulkanRenderer::DrawUI(VkCommandBuffer cmd, VkImageView imageView)
 
 	vkCmdBeginRendering(cmd, &renderInfo);
 	auto* uiImpl = dynamic_cast<VulkanImGuiForwarder*>(this->m_uiForwarder.get());
-	uiImpl->RenderFrame(cmd);
+	uiImpl->RenderFrame(cmd, &this->m_snapshot.uiDrawData);
 
     vkCmdEndRendering(cmd);
 }
@@ -19,6 +19,7 @@
 #include <VkBootstrap.h>
 #include <array>
 #include <functional>
+#include <mutex>
 #include <vector>
 #include <vulkan/vulkan.h>
 #include "VkDescriptors.hpp"
@@ -30,17 +31,31 @@
 #include "Shared/EditorCamera.hpp"
 #include "VulkanSwapchain.hpp"
 #include "DrawContext.hpp"
+#include "DrawSort.hpp"
+#include "VulkanUniformRing.hpp"
+#include "VulkanIndirectDrawer.hpp"
+#include "VulkanInstanceBuffer.hpp"
+#include "DrawInstancing.hpp"
+#include "RenderSnapshot.hpp"
 
 ///@brief Double frame buffering, allows for the GPU and CPU to work in parallel. NOTE: increase to 3 if experiencing
 /// jittery framerates
 constexpr uint32_t FRAME_OVERLAP = 2;
 
+///@brief Size of the dynamic uniform data that can be written in a single frame
+constexpr uint32_t UNIFORM_RING_BYTES_PER_FRAME = 64 * 1024;
+
 constexpr uint32_t VK_OPERATION_TIMEOUT_NS = 1'000'000'000; // This is one second, trust me (1E-9)
 
 namespace Hush
 {
     struct MeshAsset;
 
+    namespace Threading
+    {
+        class ThreadPool;
+    }
+
     class VulkanRenderer final : public IRenderer
     {
     public:
@@ -68,11 +83,15 @@ namespace Hush
 
         void Draw(float delta) override;
 
+        void Extract(float delta) override;
+
+        void Submit() override;
+
         void NewUIFrame() const noexcept override;
 
         void EndUIFrame() const noexcept override;
 
-        void HandleEvent(const SDL_Event* event) noexcept override;
+        void HandleEvents(std::span<const SDL_Event> events) noexcept override;
 
         void UpdateSceneObjects(float delta) override;
 
@@ -82,8 +101,41 @@ namespace Hush
 
         FrameData& GetCurrentFrame() noexcept;
 
+        /// @brief Gets the ring dynamic uniforms of the frame being recorded are allocated from
+        [[nodiscard]] VulkanUniformRing& GetUniformRing() noexcept;
+
         FrameData& GetLastFrame() noexcept;
 
+        /// @brief Locks the graphics queue. Every submit and present must hold it, the queue is used by the render
+        /// thread and by uploads from the main thread
+        [[nodiscard]] std::unique_lock<std::mutex> LockGraphicsQueue();
+
+        /// @brief Sets the thread pool used to split frustum culling and command recording of big scenes
+        /// @param threadPool Thread pool, or nullptr to cull in the calling thread
+        void SetThreadPool(Threading::ThreadPool* threadPool) noexcept override;
+
+        /// @brief Gets how many surfaces were drawn and how many were culled in the last extracted frame
+        [[nodiscard]] uint32_t GetVisibleSurfaceCount() const noexcept;
+
+        [[nodiscard]] uint32_t GetCulledSurfaceCount() const noexcept;
+
+        /// @brief Enables the GPU driven path for opaque surfaces: they are culled in a compute shader and drawn with
+        /// one indirect call per batch instead of one draw call each. Takes effect on the next extracted frame
+        /// @param enabled True to enable it, ignored if the device does not support it
+        void SetGpuDrivenRendering(bool enabled) noexcept;
+
+        [[nodiscard]] bool IsGpuDrivenRenderingEnabled() const noexcept;
+
+        /// @brief Gets whether the device has the indirect count features and the indirect pipelines could be built
+        [[nodiscard]] bool IsGpuDrivenRenderingSupported() const noexcept;
+
+        /// @brief Enables grouping opaque surfaces with the same mesh range and material into instanced draws, on by
+        /// default. Has no effect while GPU driven rendering is enabled
+        /// @param enabled True to enable it
+        void SetAutomaticInstancing(bool enabled) noexcept;
+
+        [[nodiscard]] bool IsAutomaticInstancingEnabled() const noexcept;
+
         /* CONSTANT GETTERS */
 
 		[[nodiscard]] VkSampler GetDefaultSamplerLinear() noexcept;
@@ -133,6 +185,22 @@ namespace Hush
     private:
         void Configure(vkb::Instance vkbInstance);
 
+        /// @brief Removes the surfaces of the draw context that are outside the camera frustum
+        void CullDrawContext();
+
+        /// @brief Culls a list of surfaces in place, keeping their order
+        /// @param frustum Camera frustum
+        /// @param surfaces Surfaces to cull
+        /// @param first Surfaces before this index are kept without being tested
+        void CullSurfaces(const Frustum& frustum, std::vector<VkRenderObject>& surfaces, size_t first = 0);
+
+        /// @brief Moves the opaque surfaces the GPU driven path can't draw (no instanced pipeline) after the others and
+        /// culls them, they are drawn one by one. Sets RenderSnapshot::indirectOpaqueCount
+        void SplitIndirectOpaque();
+
+        /// @brief Below this many draws, the geometry pass is recorded directly in the primary command buffer
+        static constexpr size_t PARALLEL_RECORDING_THRESHOLD = 2048;
+
         void CreateSyncObjects();
 
         VkSubmitInfo2 SubmitInfo(VkCommandBufferSubmitInfo* cmd, VkSemaphoreSubmitInfo* signalSemaphoreInfo,
@@ -165,6 +233,32 @@ namespace Hush
 
         void DrawGeometry(VkCommandBuffer cmd);
 
+        /// @brief Records the draw list in chunks, one secondary command buffer per thread pool worker, and executes
+        /// them from the primary command buffer
+        /// @param cmd Primary command buffer
+        /// @param renderInfo Rendering info of the geometry pass
+        /// @param globalDescriptor Scene data descriptor set
+        /// @param drawCount Number of opaque and transparent draws
+        void RecordDrawsInParallel(VkCommandBuffer cmd, VkRenderingInfo renderInfo, VkDescriptorSet globalDescriptor,
+                                   size_t drawCount);
+
+        /// @brief Records a range of the draw list, opaque draws first (instanced groups if the snapshot has them) and then
+        /// transparent surfaces
+        /// @param cmd Command buffer, inside the geometry rendering instance
+        /// @param globalDescriptor Scene data descriptor set
+        /// @param first First draw of the range
+        /// @param last One past the last draw of the range
+        void RecordDrawRange(VkCommandBuffer cmd, VkDescriptorSet globalDescriptor, size_t first, size_t last);
+
+        /// @brief Gets how many opaque draws the frame being submitted records, one per group when instancing
+        [[nodiscard]] size_t GetOpaqueDrawCount() const noexcept;
+
+        /// @brief Sets the dynamic viewport and scissor to the draw extent
+        void SetViewportAndScissor(VkCommandBuffer cmd);
+
+        /// @brief Makes sure a frame has at least count worker command pools, each with a secondary command buffer
+        void CreateWorkerCommandBuffers(FrameData& frame, uint32_t count);
+
         void DrawBackground(VkCommandBuffer cmd) noexcept;
 
         void DrawUI(VkCommandBuffer cmd, VkImageView imageView);
@@ -197,7 +291,6 @@ namespace Hush
 		VkPipeline m_trianglePipeline = nullptr;
 		VkPipelineLayout m_meshPipelineLayout = nullptr;
 		VkPipeline m_meshPipeline = nullptr;
-        GPUSceneData m_sceneData;
         VkDescriptorSetLayout m_gpuSceneDataDescriptorLayout;
 
         std::vector<std::shared_ptr<MeshAsset>> m_testMeshes;
@@ -215,9 +308,29 @@ namespace Hush
         AllocatedImage m_drawImage{};
         AllocatedImage m_depthImage{};
 
-        DrawContext m_mainDrawContext;
+        /// @brief Written by Extract and read by Submit, never both at the same time
+        RenderSnapshot m_snapshot;
         std::unordered_map<std::string, std::shared_ptr<RenderableNode>> m_loadedNodes;
 
+        // Culling scratch, reused every frame
+        std::vector<glm::vec4> m_cullSpheres;
+        std::vector<uint8_t> m_cullVisibility;
+        Threading::ThreadPool* m_threadPool = nullptr;
+        DrawSorter m_drawSorter;
+        uint32_t m_visibleSurfaceCount = 0u;
+        uint32_t m_culledSurfaceCount = 0u;
+
+        /// @brief Culls and draws opaque surfaces on the GPU when m_gpuDrivenRendering is set
+        VulkanIndirectDrawer m_indirectDrawer;
+        bool m_supportsIndirectCount = false;
+        bool m_gpuDrivenRendering = false;
+
+        DrawInstancer m_drawInstancer;
+        /// @brief Instances of the snapshot being submitted, only valid while recording
+        VulkanInstanceBuffer m_instanceBuffer;
+        VkDeviceAddress m_instanceBufferAddress = 0u;
+        bool m_automaticInstancing = true;
+
         // Test stuff
 		AllocatedImage m_whiteImage{};
 		AllocatedImage m_blackImage{};
@@ -242,6 +355,10 @@ namespace Hush
 
         VulkanDeletionQueue m_mainDeletionQueue{};
         VmaAllocator m_allocator = nullptr; // vma lib allocator
+        VkDeviceSize m_minUniformBufferOffsetAlignment = 256u;
+        /// @brief Dynamic uniforms of the frames in flight, like the scene data
+        VulkanUniformRing m_uniformRing;
+        std::mutex m_graphicsQueueMutex;
         bool m_resizeRequested = false;
         VulkanSwapchain m_swapchain{};
     };
@@ -122,6 +122,8 @@ void Hush::VulkanSwapchain::Present(VkCommandBuffer cmd, uint32_t* swapchainImag
 
 	VkSubmitInfo2 submit = VkUtilsFactory::SubmitInfo(&cmdinfo, &signalInfo, &waitInfo);
 
+	std::unique_lock<std::mutex> queueLock = this->m_renderer->LockGraphicsQueue();
+
 	// submit command buffer to the queue and execute it.
 	//  _renderFence will now block until the graphic commands finish execution
 	HUSH_VK_ASSERT(vkQueueSubmit2(this->m_renderer->GetGraphicsQueue(), 1, &submit, currentFrame.renderFence), "Queue submit failed!");
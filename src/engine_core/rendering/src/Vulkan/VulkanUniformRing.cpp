@@ -0,0 +1,93 @@
+/*! \file VulkanUniformRing.cpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Persistently mapped ring of per-frame uniform data
+*/
+
+#include "VulkanUniformRing.hpp"
+#include "Assertions.hpp"
+#include "VkTypes.hpp"
+
+namespace
+{
+    uint32_t AlignUp(uint32_t value, uint32_t alignment) noexcept
+    {
+        return (value + alignment - 1u) & ~(alignment - 1u);
+    }
+} // namespace
+
+void Hush::VulkanUniformRing::Init(VmaAllocator allocator, uint32_t bytesPerFrame, uint32_t frameCount,
+                                   VkDeviceSize minAlignment)
+{
+    HUSH_ASSERT(frameCount > 0u, "The uniform ring needs at least one frame");
+
+    this->m_allocator = allocator;
+    this->m_alignment = minAlignment > 0u ? static_cast<uint32_t>(minAlignment) : 1u;
+    // Every slice starts aligned, so offsets inside it only need to be aligned relative to the slice
+    this->m_bytesPerFrame = AlignUp(bytesPerFrame, this->m_alignment);
+    this->m_frameCount = frameCount;
+
+    this->m_buffer = VulkanAllocatedBuffer(this->m_bytesPerFrame * frameCount, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                                           VMA_MEMORY_USAGE_CPU_TO_GPU, allocator);
+    this->m_mappedData = static_cast<std::byte*>(this->m_buffer.GetAllocationInfo().pMappedData);
+    HUSH_ASSERT(this->m_mappedData != nullptr, "Uniform ring buffer could not be mapped");
+
+    this->BeginFrame(0u);
+}
+
+void Hush::VulkanUniformRing::Dispose()
+{
+    if (this->m_allocator == nullptr)
+    {
+        return;
+    }
+
+    this->m_buffer.Dispose(this->m_allocator);
+    this->m_allocator = nullptr;
+    this->m_mappedData = nullptr;
+}
+
+void Hush::VulkanUniformRing::BeginFrame(uint32_t frameIndex) noexcept
+{
+    this->m_frameBegin = (frameIndex % this->m_frameCount) * this->m_bytesPerFrame;
+    this->m_head = this->m_frameBegin;
+}
+
+Hush::VulkanUniformRing::Allocation Hush::VulkanUniformRing::Allocate(uint32_t size)
+{
+    const uint32_t offset = AlignUp(this->m_head, this->m_alignment);
+    const uint32_t frameEnd = this->m_frameBegin + this->m_bytesPerFrame;
+
+    if (this->m_mappedData == nullptr || offset + size > frameEnd)
+    {
+        HUSH_ASSERT(false, "Uniform ring is full, {} bytes requested with {} of {} bytes used", size,
+                    this->GetUsedBytes(), this->m_bytesPerFrame);
+        return {};
+    }
+
+    this->m_head = offset + size;
+
+    Allocation allocation;
+    allocation.buffer = this->m_buffer.GetBuffer();
+    allocation.offset = offset;
+    allocation.size = size;
+    allocation.data = this->m_mappedData + offset;
+
+    return allocation;
+}
+
+void Hush::VulkanUniformRing::Flush(const Allocation& allocation)
+{
+    // No-op for host coherent memory
+    vmaFlushAllocation(this->m_allocator, this->m_buffer.GetAllocation(), allocation.offset, allocation.size);
+}
+
+uint32_t Hush::VulkanUniformRing::GetUsedBytes() const noexcept
+{
+    return this->m_head - this->m_frameBegin;
+}
+
+uint32_t Hush::VulkanUniformRing::GetBytesPerFrame() const noexcept
+{
+    return this->m_bytesPerFrame;
+}
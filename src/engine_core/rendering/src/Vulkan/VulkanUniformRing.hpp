@@ -0,0 +1,101 @@
+/*! \file VulkanUniformRing.hpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Persistently mapped ring of per-frame uniform data
+*/
+
+#pragma once
+
+#include "VulkanAllocatedBuffer.hpp"
+#include "vk_mem_alloc.hpp"
+#include <vulkan/vulkan.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace Hush
+{
+    /// @brief A single uniform buffer, created once and mapped for its whole lifetime, split in one slice per frame in
+    /// flight. Dynamic uniforms are suballocated linearly from the slice of the current frame, so writing one is a
+    /// memcpy instead of a buffer allocation. A slice is only reused after the fence of its frame has been waited on
+    class VulkanUniformRing final
+    {
+      public:
+        /// @brief Suballocation inside the ring
+        struct Allocation
+        {
+            VkBuffer buffer = VK_NULL_HANDLE;
+            /// @brief Offset from the start of the buffer, aligned for uniform buffer bindings
+            uint32_t offset = 0;
+            uint32_t size = 0;
+            /// @brief Mapped memory of the allocation, nullptr if the allocation failed
+            void* data = nullptr;
+        };
+
+        VulkanUniformRing() = default;
+
+        VulkanUniformRing(const VulkanUniformRing&) = delete;
+        VulkanUniformRing& operator=(const VulkanUniformRing&) = delete;
+
+        /// @brief Creates and maps the buffer
+        /// @param allocator VMA allocator
+        /// @param bytesPerFrame Size of the slice of each frame
+        /// @param frameCount Number of frames in flight
+        /// @param minAlignment minUniformBufferOffsetAlignment of the device
+        void Init(VmaAllocator allocator, uint32_t bytesPerFrame, uint32_t frameCount, VkDeviceSize minAlignment);
+
+        void Dispose();
+
+        /// @brief Starts writing in the slice of a frame. The GPU must be done with the previous use of the slice
+        /// @param frameIndex Index of the frame in flight
+        void BeginFrame(uint32_t frameIndex) noexcept;
+
+        /// @brief Suballocates memory from the slice of the current frame
+        /// @param size Size in bytes
+        /// @return The allocation, with data set to nullptr if the slice is full
+        [[nodiscard]] Allocation Allocate(uint32_t size);
+
+        /// @brief Copies a value to a new allocation
+        /// @param value Value to copy, usually a uniform struct
+        /// @return The allocation, with data set to nullptr if the slice is full
+        template <typename T>
+        [[nodiscard]] Allocation Push(const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Uniform data is copied to the GPU byte by byte");
+
+            Allocation allocation = this->Allocate(static_cast<uint32_t>(sizeof(T)));
+            if (allocation.data != nullptr)
+            {
+                std::memcpy(allocation.data, &value, sizeof(T));
+                this->Flush(allocation);
+            }
+
+            return allocation;
+        }
+
+        /// @brief Makes the writes to an allocation visible to the device, only needed for non coherent memory
+        /// @param allocation Allocation that was written
+        void Flush(const Allocation& allocation);
+
+        /// @brief Gets the bytes used in the current frame, including alignment padding
+        [[nodiscard]] uint32_t GetUsedBytes() const noexcept;
+
+        [[nodiscard]] uint32_t GetBytesPerFrame() const noexcept;
+
+      private:
+        VulkanAllocatedBuffer m_buffer;
+        VmaAllocator m_allocator = nullptr;
+        std::byte* m_mappedData = nullptr;
+
+        uint32_t m_bytesPerFrame = 0;
+        uint32_t m_frameCount = 0;
+        uint32_t m_alignment = 1;
+
+        /// @brief Start of the slice of the current frame
+        uint32_t m_frameBegin = 0;
+        /// @brief Next free byte, relative to the start of the buffer
+        uint32_t m_head = 0;
+    };
+} // namespace Hush
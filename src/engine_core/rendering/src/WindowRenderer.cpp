@@ -49,44 +49,82 @@ Hush::WindowRenderer::WindowRenderer(const char *windowName) noexcept
 
 void Hush::WindowRenderer::HandleEvents(bool *applicationRunning)
 {
+    this->DrainEvents();
+
+    for (const SDL_Event &event : this->m_events)
+    {
+        switch (event.type)
+        {
+        case SDL_QUIT:
+            *applicationRunning = false;
+            break;
+        case SDL_KEYDOWN:
+            this->m_eventBatch.buttonEvents.emplace_back(KeyEvent{event.key.keysym.scancode, EKeyState::Pressed});
+            break;
+        case SDL_KEYUP:
+            this->m_eventBatch.buttonEvents.emplace_back(KeyEvent{event.key.keysym.scancode, EKeyState::Released});
+            break;
+        case SDL_MOUSEBUTTONDOWN:
+            this->m_eventBatch.buttonEvents.emplace_back(MouseButtonEvent{event.button.button, EKeyState::Pressed});
+            break;
+        case SDL_MOUSEBUTTONUP:
+            this->m_eventBatch.buttonEvents.emplace_back(MouseButtonEvent{event.button.button, EKeyState::Released});
+            break;
+        case SDL_MOUSEMOTION:
+            this->m_eventBatch.hasMouseMotion = true;
+            this->m_eventBatch.mousePositionX = event.motion.x;
+            this->m_eventBatch.mousePositionY = event.motion.y;
+            this->m_eventBatch.mouseDeltaX += event.motion.xrel;
+            this->m_eventBatch.mouseDeltaY += event.motion.yrel;
+            break;
+        case SDL_MOUSEWHEEL:
+            this->m_eventBatch.wheelDelta.x += event.wheel.preciseX;
+            this->m_eventBatch.wheelDelta.y += event.wheel.preciseY;
+            break;
+        case SDL_WINDOWEVENT:
+            CheckWindowState(event.window, &this->m_isActive, &this->m_hasFocus);
+            break;
+        default:
+            break;
+        }
+    }
+
+    InputManager::ProcessEventBatch(this->m_eventBatch);
+    // Forward the events to the renderer
+    this->m_windowRenderer->HandleEvents(this->m_events);
+}
+
+const Hush::InputEventBatch &Hush::WindowRenderer::GetEventBatch() const noexcept
+{
+    return this->m_eventBatch;
+}
+
+void Hush::WindowRenderer::DrainEvents()
+{
+    this->m_events.clear();
+    this->m_eventBatch.Clear();
+
     SDL_Event event;
-    KeyCode code = 0;
-    InputManager::ResetMouseAcceleration();
-    SDL_PollEvent(&event);
-    // Forward event to the renderer
-    switch (event.type)
+    while (SDL_PollEvent(&event) != 0)
     {
-    case SDL_QUIT:
-        *applicationRunning = false;
-        break;
-    case SDL_KEYDOWN:
-        code = event.key.keysym.scancode;
-        InputManager::SendKeyEvent(code, EKeyState::Pressed);
-        break;
-    case SDL_KEYUP:
-        code = event.key.keysym.scancode;
-        InputManager::SendKeyEvent(code, EKeyState::Released);
-        break;
-    case SDL_MOUSEBUTTONDOWN:
-        InputManager::SendMouseButtonEvent(event.button.button, EKeyState::Pressed);
-        break;
-    case SDL_MOUSEBUTTONUP:
-        InputManager::SendMouseButtonEvent(event.button.button, EKeyState::Released);
-        break;
-    case SDL_MOUSEMOTION:
-        InputManager::SendMouseMovementEvent(event.motion.x, event.motion.y, event.motion.xrel, event.motion.yrel);
-        break;
-    case SDL_MOUSEWHEEL:
-        //Send 0 as acceleration bc it will be calculated manually
-        InputManager::SendWheelEvent(event.wheel.preciseX, event.wheel.preciseY);
-        break;
-    case SDL_WINDOWEVENT:
-        CheckWindowState(event.window, &this->m_isActive);
-        break;
-    default:
-        break;
+        if (this->m_eventBatch.eventCount == 0)
+        {
+            this->m_eventBatch.oldestEventTimestamp = event.common.timestamp;
+        }
+        this->m_eventBatch.eventCount++;
+
+        // Only runs of motion events are merged, so buttons are still seen at the position they were clicked at
+        if (event.type == SDL_MOUSEMOTION && !this->m_events.empty() && this->m_events.back().type == SDL_MOUSEMOTION)
+        {
+            SDL_MouseMotionEvent &previousMotion = this->m_events.back().motion;
+            event.motion.xrel += previousMotion.xrel;
+            event.motion.yrel += previousMotion.yrel;
+            this->m_events.back() = event;
+            continue;
+        }
+
+        this->m_events.push_back(event);
     }
-    this->m_windowRenderer->HandleEvent(&event);
 }
 
 Hush::WindowRenderer::~WindowRenderer()
@@ -106,6 +144,11 @@ bool Hush::WindowRenderer::IsActive() const noexcept
     return this->m_isActive;
 }
 
+bool Hush::WindowRenderer::HasFocus() const noexcept
+{
+    return this->m_hasFocus;
+}
+
 bool Hush::WindowRenderer::InitSDLIfNotStarted() noexcept
 {
     if (SDL_WasInit(SDL_INIT_EVERYTHING) != 0)
@@ -117,7 +160,7 @@ bool Hush::WindowRenderer::InitSDLIfNotStarted() noexcept
     return rc == 0;
 }
 
-void Hush::WindowRenderer::CheckWindowState(const SDL_WindowEvent windowEvent, bool *isActive) noexcept
+void Hush::WindowRenderer::CheckWindowState(const SDL_WindowEvent windowEvent, bool *isActive, bool *hasFocus) noexcept
 {
     switch (windowEvent.event)
     {
@@ -127,5 +170,11 @@ void Hush::WindowRenderer::CheckWindowState(const SDL_WindowEvent windowEvent, b
     case SDL_WINDOWEVENT_RESTORED:
         *isActive = true;
         break;
+    case SDL_WINDOWEVENT_FOCUS_GAINED:
+        *hasFocus = true;
+        break;
+    case SDL_WINDOWEVENT_FOCUS_LOST:
+        *hasFocus = false;
+        break;
     }
 }
\ No newline at end of file
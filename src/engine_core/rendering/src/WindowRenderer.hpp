@@ -12,6 +12,7 @@
 #include <SDL2/SDL.h>
 #include <InputManager.hpp>
 #include <memory>
+#include <vector>
 
 #include "Renderer.hpp"
 
@@ -32,14 +33,22 @@ namespace Hush
 
         WindowRenderer &operator=(WindowRenderer &&) = default;
 
+        /// @brief Drains all the pending SDL events and hands them to the InputManager and the renderer as a single
+        /// batch. Consecutive mouse motion events are coalesced into one
         void HandleEvents(bool *applicationRunning);
 
+        /// @brief Gets the batch of events of the last HandleEvents call
+        [[nodiscard]] const InputEventBatch &GetEventBatch() const noexcept;
+
         ~WindowRenderer();
 
         IRenderer *GetInternalRenderer() noexcept;
 
         [[nodiscard]] bool IsActive() const noexcept;
 
+        /// @brief Whether the window has the keyboard focus
+        [[nodiscard]] bool HasFocus() const noexcept;
+
       private:
         /// @brief Pointer that represents the unique instance of an SDL window associated with this context
         /// (This is declared as a raw pointer for compatibility with C)
@@ -51,9 +60,19 @@ namespace Hush
 
         bool m_isActive = false;
 
+        bool m_hasFocus = true;
+
+        /// @brief Events of the current frame, reused every frame
+        std::vector<SDL_Event> m_events;
+
+        InputEventBatch m_eventBatch;
+
         bool InitSDLIfNotStarted() noexcept;
 
-        void CheckWindowState(const SDL_WindowEvent windowEvent, bool *isActive) noexcept;
+        /// @brief Polls every pending event into m_events, coalescing consecutive mouse motion events
+        void DrainEvents();
+
+        void CheckWindowState(const SDL_WindowEvent windowEvent, bool *isActive, bool *hasFocus) noexcept;
 
         constexpr uint32_t GetInitialRendererFlags()
         {
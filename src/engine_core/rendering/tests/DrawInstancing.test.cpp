@@ -0,0 +1,120 @@
+/*! \file DrawInstancing.test.cpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Instanced draw grouping tests
+*/
+
+#include "Vulkan/DrawInstancing.hpp"
+
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <glm/gtc/matrix_transform.hpp>
+#include <vector>
+
+namespace
+{
+    /// @brief Fake Vulkan handle, the instancer only compares them
+    template <typename Handle>
+    Handle MakeHandle(uintptr_t value)
+    {
+        return reinterpret_cast<Handle>(value);
+    }
+
+    /// @brief Surface whose transform holds its id in the x translation, so its instance can be traced back to it
+    Hush::VkRenderObject MakeSurface(Hush::VkMaterialInstance &material, VkBuffer indexBuffer, uint32_t firstIndex,
+                                     float id)
+    {
+        Hush::VkRenderObject surface{};
+        surface.indexCount = 36;
+        surface.firstIndex = firstIndex;
+        surface.indexBuffer = indexBuffer;
+        surface.material = &material;
+        surface.transform = glm::translate(glm::mat4(1.0f), glm::vec3(id, 0.0f, 0.0f));
+
+        return surface;
+    }
+} // namespace
+
+TEST_CASE("Identical draws are grouped into instanced draws", "[rendering]")
+{
+    Hush::VkMaterialPipeline instancedPipeline{};
+    instancedPipeline.instancedPipeline = MakeHandle<VkPipeline>(0x10);
+    Hush::VkMaterialPipeline plainPipeline{};
+
+    std::array<Hush::VkMaterialInstance, 2> instancedMaterials{};
+    for (Hush::VkMaterialInstance &material : instancedMaterials)
+    {
+        material.pipeline = &instancedPipeline;
+    }
+    Hush::VkMaterialInstance plainMaterial{};
+    plainMaterial.pipeline = &plainPipeline;
+
+    const auto firstBuffer = MakeHandle<VkBuffer>(0x1000);
+    const auto secondBuffer = MakeHandle<VkBuffer>(0x2000);
+
+    // Groups, in the order of their first surface:
+    // 0: surfaces 0, 2, 5 - 1: surfaces 1, 4 (other first index) - 2: surfaces 3, 9 (other index buffer)
+    // 3: surface 6 (other material) - 4 and 5: surfaces 7 and 8 (no instanced pipeline, never grouped)
+    const std::vector<Hush::VkRenderObject> surfaces = {
+        MakeSurface(instancedMaterials[0], firstBuffer, 0, 0.0f),
+        MakeSurface(instancedMaterials[0], firstBuffer, 36, 1.0f),
+        MakeSurface(instancedMaterials[0], firstBuffer, 0, 2.0f),
+        MakeSurface(instancedMaterials[0], secondBuffer, 0, 3.0f),
+        MakeSurface(instancedMaterials[0], firstBuffer, 36, 4.0f),
+        MakeSurface(instancedMaterials[0], firstBuffer, 0, 5.0f),
+        MakeSurface(instancedMaterials[1], firstBuffer, 0, 6.0f),
+        MakeSurface(plainMaterial, firstBuffer, 0, 7.0f),
+        MakeSurface(plainMaterial, firstBuffer, 0, 8.0f),
+        MakeSurface(instancedMaterials[0], secondBuffer, 0, 9.0f),
+    };
+
+    const std::vector<std::vector<float>> expectedGroups = {{0.0f, 2.0f, 5.0f}, {1.0f, 4.0f}, {3.0f, 9.0f},
+                                                            {6.0f},             {7.0f},       {8.0f}};
+
+    Hush::DrawInstancer instancer;
+    std::vector<Hush::InstancedDraw> draws;
+    std::vector<GPUDrawInstance> instances;
+
+    instancer.Build(surfaces, draws, instances);
+
+    REQUIRE(draws.size() == expectedGroups.size());
+    REQUIRE(instances.size() == surfaces.size());
+
+    uint32_t nextInstance = 0;
+    for (size_t group = 0; group < draws.size(); ++group)
+    {
+        const Hush::InstancedDraw &draw = draws[group];
+        const std::vector<float> &expectedIds = expectedGroups[group];
+
+        // Groups keep the state of their first surface and cover the next contiguous range of instances
+        REQUIRE(draw.surface.transform[3].x == expectedIds.front());
+        REQUIRE(draw.firstInstance == nextInstance);
+        REQUIRE(draw.instanceCount == expectedIds.size());
+
+        for (size_t i = 0; i < expectedIds.size(); ++i)
+        {
+            const GPUDrawInstance &instance = instances[draw.firstInstance + i];
+
+            REQUIRE(instance.worldMatrix[3].x == expectedIds[i]);
+            REQUIRE(instance.firstIndex == draw.surface.firstIndex);
+            REQUIRE(instance.indexCount == draw.surface.indexCount);
+        }
+
+        nextInstance += draw.instanceCount;
+    }
+
+    SECTION("Building again replaces the previous groups")
+    {
+        const std::vector<Hush::VkRenderObject> fewerSurfaces = {surfaces[1], surfaces[4]};
+
+        instancer.Build(fewerSurfaces, draws, instances);
+
+        REQUIRE(draws.size() == 1);
+        REQUIRE(draws.front().firstInstance == 0);
+        REQUIRE(draws.front().instanceCount == 2);
+        REQUIRE(instances.size() == 2);
+        REQUIRE(instances[0].worldMatrix[3].x == 1.0f);
+        REQUIRE(instances[1].worldMatrix[3].x == 4.0f);
+    }
+}
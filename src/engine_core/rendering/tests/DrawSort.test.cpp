@@ -0,0 +1,203 @@
+/*! \file DrawSort.test.cpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Draw list sorting tests
+*/
+
+#include "Vulkan/DrawSort.hpp"
+
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <glm/gtc/matrix_transform.hpp>
+#include <vector>
+
+namespace
+{
+    /// @brief Fake index buffer handle, the sorter only hashes it
+    VkBuffer MakeIndexBuffer(uintptr_t value)
+    {
+        return reinterpret_cast<VkBuffer>(value);
+    }
+
+    /// @brief Surface in front of the camera, firstIndex is only used to tell surfaces apart
+    Hush::VkRenderObject MakeSurface(Hush::VkMaterialInstance &material, VkBuffer indexBuffer, float depth,
+                                     uint32_t id)
+    {
+        Hush::VkRenderObject surface{};
+        surface.indexCount = 3;
+        surface.firstIndex = id;
+        surface.indexBuffer = indexBuffer;
+        surface.material = &material;
+        surface.transform = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -depth));
+
+        return surface;
+    }
+
+    /// @brief View space depth of a surface built by MakeSurface, with an identity view
+    float GetDepth(const Hush::VkRenderObject &surface)
+    {
+        return -surface.transform[3].z;
+    }
+
+    /// @brief Whether a comes before b, comparing pass, pipeline, material, index buffer and depth in that order.
+    /// The hashed fields are ordered by keys that only differ in that field
+    bool IsExpectedBefore(const Hush::VkRenderObject &a, const Hush::VkRenderObject &b)
+    {
+        using Hush::DrawSorter;
+
+        const bool isTransparentA = a.material->passType == Hush::EMaterialPass::Transparent;
+        const bool isTransparentB = b.material->passType == Hush::EMaterialPass::Transparent;
+        if (isTransparentA != isTransparentB)
+        {
+            return isTransparentB;
+        }
+
+        if (a.material->pipeline != b.material->pipeline)
+        {
+            Hush::VkMaterialInstance probe{};
+            probe.pipeline = a.material->pipeline;
+            const uint64_t keyA = DrawSorter::MakeOpaqueKey(MakeSurface(probe, a.indexBuffer, 0.0f, 0), 0.0f);
+            probe.pipeline = b.material->pipeline;
+            const uint64_t keyB = DrawSorter::MakeOpaqueKey(MakeSurface(probe, a.indexBuffer, 0.0f, 0), 0.0f);
+
+            REQUIRE(keyA != keyB);
+            return keyA < keyB;
+        }
+
+        if (a.material != b.material)
+        {
+            const uint64_t keyA = DrawSorter::MakeOpaqueKey(MakeSurface(*a.material, a.indexBuffer, 0.0f, 0), 0.0f);
+            const uint64_t keyB = DrawSorter::MakeOpaqueKey(MakeSurface(*b.material, a.indexBuffer, 0.0f, 0), 0.0f);
+
+            REQUIRE(keyA != keyB);
+            return keyA < keyB;
+        }
+
+        if (a.indexBuffer != b.indexBuffer)
+        {
+            const uint64_t keyA = DrawSorter::MakeOpaqueKey(MakeSurface(*a.material, a.indexBuffer, 0.0f, 0), 0.0f);
+            const uint64_t keyB = DrawSorter::MakeOpaqueKey(MakeSurface(*a.material, b.indexBuffer, 0.0f, 0), 0.0f);
+
+            REQUIRE(keyA != keyB);
+            return keyA < keyB;
+        }
+
+        return GetDepth(a) < GetDepth(b);
+    }
+} // namespace
+
+TEST_CASE("Opaque draws are sorted by state and then front to back", "[rendering]")
+{
+    // Two pipelines with two materials each, and a transparent material that always goes last
+    std::array<Hush::VkMaterialPipeline, 2> pipelines{};
+    std::array<Hush::VkMaterialInstance, 5> materials{};
+    for (size_t i = 0; i < materials.size(); ++i)
+    {
+        materials[i].pipeline = &pipelines[i / 2 % pipelines.size()];
+        materials[i].passType = Hush::EMaterialPass::MainColor;
+    }
+    materials.back().passType = Hush::EMaterialPass::Transparent;
+
+    const std::array<VkBuffer, 2> indexBuffers = {MakeIndexBuffer(0x1000), MakeIndexBuffer(0x2000)};
+    const std::array<float, 3> depths = {20.0f, 1.0f, 7.5f};
+
+    std::vector<Hush::VkRenderObject> surfaces;
+    for (float depth : depths)
+    {
+        for (VkBuffer indexBuffer : indexBuffers)
+        {
+            for (Hush::VkMaterialInstance &material : materials)
+            {
+                surfaces.push_back(MakeSurface(material, indexBuffer, depth, static_cast<uint32_t>(surfaces.size())));
+            }
+        }
+    }
+
+    SECTION("Keys compare each field before the ones after it")
+    {
+        for (const Hush::VkRenderObject &a : surfaces)
+        {
+            for (const Hush::VkRenderObject &b : surfaces)
+            {
+                if (a.firstIndex == b.firstIndex)
+                {
+                    continue;
+                }
+
+                const uint64_t keyA = Hush::DrawSorter::MakeOpaqueKey(a, GetDepth(a));
+                const uint64_t keyB = Hush::DrawSorter::MakeOpaqueKey(b, GetDepth(b));
+
+                REQUIRE((keyA < keyB) == IsExpectedBefore(a, b));
+            }
+        }
+    }
+
+    SECTION("Sorting follows the keys and keeps equal surfaces in order")
+    {
+        // Duplicates of the first surfaces, with the same state and depth but a later id
+        const size_t uniqueCount = surfaces.size();
+        for (size_t i = 0; i < materials.size(); ++i)
+        {
+            Hush::VkRenderObject duplicate = surfaces[i];
+            duplicate.firstIndex = static_cast<uint32_t>(surfaces.size());
+            surfaces.push_back(duplicate);
+        }
+
+        Hush::DrawSorter sorter;
+        sorter.SortOpaque(surfaces, glm::mat4(1.0f));
+
+        REQUIRE(surfaces.size() == uniqueCount + materials.size());
+
+        for (size_t i = 1; i < surfaces.size(); ++i)
+        {
+            const Hush::VkRenderObject &previous = surfaces[i - 1];
+            const Hush::VkRenderObject &current = surfaces[i];
+
+            const bool isSameState = previous.material == current.material &&
+                                     previous.indexBuffer == current.indexBuffer &&
+                                     GetDepth(previous) == GetDepth(current);
+            if (isSameState)
+            {
+                REQUIRE(previous.firstIndex < current.firstIndex);
+            }
+            else
+            {
+                REQUIRE(IsExpectedBefore(previous, current));
+            }
+        }
+    }
+}
+
+TEST_CASE("Transparent draws are sorted back to front", "[rendering]")
+{
+    Hush::VkMaterialPipeline pipeline{};
+    std::array<Hush::VkMaterialInstance, 2> materials{};
+    for (Hush::VkMaterialInstance &material : materials)
+    {
+        material.pipeline = &pipeline;
+        material.passType = Hush::EMaterialPass::Transparent;
+    }
+
+    const VkBuffer indexBuffer = MakeIndexBuffer(0x1000);
+
+    // The state must not matter, and surfaces at the same depth keep their order
+    std::vector<Hush::VkRenderObject> surfaces = {
+        MakeSurface(materials[0], indexBuffer, 5.0f, 0),  MakeSurface(materials[1], indexBuffer, 1.0f, 1),
+        MakeSurface(materials[0], indexBuffer, 50.0f, 2), MakeSurface(materials[1], indexBuffer, 5.0f, 3),
+        MakeSurface(materials[1], indexBuffer, 0.5f, 4),  MakeSurface(materials[0], indexBuffer, 5.0f, 5),
+    };
+
+    Hush::DrawSorter sorter;
+    sorter.SortTransparent(surfaces, glm::mat4(1.0f));
+
+    const std::array<uint32_t, 6> expectedOrder = {2, 0, 3, 5, 1, 4};
+
+    REQUIRE(surfaces.size() == expectedOrder.size());
+    for (size_t i = 0; i < expectedOrder.size(); ++i)
+    {
+        REQUIRE(surfaces[i].firstIndex == expectedOrder[i]);
+    }
+
+    REQUIRE(Hush::DrawSorter::MakeTransparentKey(50.0f) < Hush::DrawSorter::MakeTransparentKey(5.0f));
+}
@@ -0,0 +1,121 @@
+/*! \file Frustum.test.cpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Frustum culling tests
+*/
+
+#include "Shared/Frustum.hpp"
+
+#include <ThreadPool.hpp>
+#include <algorithm>
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <glm/gtc/matrix_transform.hpp>
+#include <vector>
+
+namespace
+{
+    /// @brief Bounding sphere of a box, as the renderer computes it for a surface
+    glm::vec4 BoxSphere(const glm::vec3 &center, const glm::vec3 &extents)
+    {
+        const std::array<glm::vec3, 2> corners = {-extents, extents};
+        const Hush::Bounds bounds = Hush::Bounds::FromPoints(corners);
+
+        return bounds.GetWorldSphere(glm::translate(glm::mat4(1.0f), center));
+    }
+
+    /// @brief Camera at the origin looking down -z, the frustum goes from z = -0.1 to z = -100
+    Hush::Frustum CreateFrustum()
+    {
+        const glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f);
+        const glm::mat4 view =
+            glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+        return Hush::Frustum::FromViewProjection(projection * view);
+    }
+} // namespace
+
+TEST_CASE("Frustum SIMD and scalar tests agree", "[rendering]")
+{
+    const Hush::Frustum frustum = CreateFrustum();
+
+    const std::vector<glm::vec4> inside = {
+        BoxSphere({0.0f, 0.0f, -10.0f}, glm::vec3(1.0f)),
+        BoxSphere({3.0f, -2.0f, -20.0f}, glm::vec3(0.5f)),
+        BoxSphere({-30.0f, 30.0f, -50.0f}, glm::vec3(2.0f)),
+        BoxSphere({0.0f, 0.0f, -90.0f}, {4.0f, 1.0f, 2.0f}),
+    };
+    const std::vector<glm::vec4> outside = {
+        BoxSphere({0.0f, 0.0f, 10.0f}, glm::vec3(1.0f)),
+        BoxSphere({0.0f, 0.0f, -200.0f}, glm::vec3(1.0f)),
+        BoxSphere({40.0f, 0.0f, -10.0f}, glm::vec3(1.0f)),
+        BoxSphere({0.0f, -40.0f, -10.0f}, {1.0f, 2.0f, 1.0f}),
+    };
+    const std::vector<glm::vec4> straddling = {
+        BoxSphere({10.0f, 0.0f, -10.0f}, glm::vec3(1.0f)),
+        BoxSphere({0.0f, -10.0f, -10.0f}, glm::vec3(1.0f)),
+        BoxSphere({0.0f, 0.0f, 0.0f}, glm::vec3(1.0f)),
+        BoxSphere({0.0f, 0.0f, -100.0f}, glm::vec3(1.0f)),
+    };
+
+    // One SIMD group of each kind, then a group mixing all of them and a remainder for the scalar tail
+    std::vector<glm::vec4> spheres;
+    spheres.insert(spheres.end(), inside.begin(), inside.end());
+    spheres.insert(spheres.end(), outside.begin(), outside.end());
+    spheres.insert(spheres.end(), straddling.begin(), straddling.end());
+    spheres.insert(spheres.end(), {inside[0], outside[0], straddling[0], outside[1]});
+    spheres.insert(spheres.end(), {straddling[1], inside[1], outside[2]});
+
+    std::vector<std::uint8_t> visible(spheres.size(), 2);
+    frustum.TestSpheres(spheres, visible);
+
+    for (std::size_t i = 0; i < spheres.size(); ++i)
+    {
+        REQUIRE(visible[i] == (frustum.IsSphereVisible(spheres[i]) ? 1 : 0));
+    }
+
+    for (const glm::vec4 &sphere : inside)
+    {
+        REQUIRE(frustum.IsSphereVisible(sphere));
+    }
+
+    for (const glm::vec4 &sphere : outside)
+    {
+        REQUIRE(!frustum.IsSphereVisible(sphere));
+    }
+
+    for (const glm::vec4 &sphere : straddling)
+    {
+        REQUIRE(frustum.IsSphereVisible(sphere));
+    }
+}
+
+TEST_CASE("Frustum tests split across a thread pool", "[rendering]")
+{
+    const Hush::Frustum frustum = CreateFrustum();
+    Hush::Threading::ThreadPool threadPool(4);
+
+    // Odd count, so the last chunk has a scalar tail
+    constexpr std::size_t NUM_SPHERES = Hush::Frustum::PARALLEL_THRESHOLD * 4 + 3;
+
+    std::vector<glm::vec4> spheres;
+    spheres.reserve(NUM_SPHERES);
+    for (std::size_t i = 0; i < NUM_SPHERES; ++i)
+    {
+        const float x = static_cast<float>(i % 64) - 32.0f;
+        const float y = static_cast<float>(i / 64 % 64) - 32.0f;
+        const float z = -static_cast<float>(i % 150);
+        spheres.emplace_back(x, y, z, 1.0f);
+    }
+
+    std::vector<std::uint8_t> serial(NUM_SPHERES, 2);
+    std::vector<std::uint8_t> parallel(NUM_SPHERES, 2);
+
+    frustum.TestSpheres(spheres, serial);
+    frustum.TestSpheres(spheres, parallel, &threadPool);
+
+    REQUIRE(parallel == serial);
+    REQUIRE(std::ranges::count(serial, std::uint8_t{0}) != 0);
+    REQUIRE(std::ranges::count(serial, std::uint8_t{1}) != 0);
+}
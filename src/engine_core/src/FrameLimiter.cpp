@@ -0,0 +1,61 @@
+/*! \file FrameLimiter.cpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Caps the frame rate of the main loop
+*/
+
+#include "FrameLimiter.hpp"
+
+#include <algorithm>
+#include <thread>
+
+void Hush::FrameLimiter::WaitForNextFrame(std::uint32_t frameRate)
+{
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+    if (frameRate == 0)
+    {
+        m_nextFrame = now;
+        return;
+    }
+
+    if (m_nextFrame == std::chrono::steady_clock::time_point{})
+    {
+        m_nextFrame = now;
+    }
+
+    m_nextFrame += std::chrono::nanoseconds(std::chrono::seconds(1)) / frameRate;
+
+    if (m_nextFrame <= now)
+    {
+        m_nextFrame = now;
+        return;
+    }
+
+    WaitUntil(m_nextFrame);
+}
+
+void Hush::FrameLimiter::Reset() noexcept
+{
+    m_nextFrame = {};
+}
+
+void Hush::FrameLimiter::WaitUntil(std::chrono::steady_clock::time_point deadline)
+{
+    const std::chrono::steady_clock::time_point wakeUp = deadline - m_spinMargin;
+
+    if (std::chrono::steady_clock::now() < wakeUp)
+    {
+        std::this_thread::sleep_until(wakeUp);
+
+        // Grow the margin right away when a sleep overshoots it, shrink it slowly otherwise
+        const std::chrono::nanoseconds overshoot = std::chrono::steady_clock::now() - wakeUp;
+        m_spinMargin = std::clamp<std::chrono::nanoseconds>(std::max(overshoot, m_spinMargin - m_spinMargin / 16),
+                                                            MIN_SPIN_MARGIN, MAX_SPIN_MARGIN);
+    }
+
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::yield();
+    }
+}
@@ -0,0 +1,60 @@
+/*! \file FrameLimiter.hpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Caps the frame rate of the main loop
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace Hush
+{
+    /// Frame rates of the main loop, see \ref HushEngine::SetFramePacing. A rate of 0 means uncapped.
+    struct FramePacingConfig
+    {
+        /// Frame rate while the window is focused. Vsync, if enabled, still applies on top of it.
+        std::uint32_t targetFrameRate = 120;
+
+        /// Frame rate while the window is visible but not focused.
+        std::uint32_t backgroundFrameRate = 30;
+
+        /// Rate at which events are polled while the window is minimized. Nothing is simulated or rendered meanwhile.
+        /// Never uncapped, 0 polls once per second.
+        std::uint32_t minimizedFrameRate = 10;
+    };
+
+    /// Waits until the deadline of the next frame. It sleeps until shortly before the deadline and spins for the rest,
+    /// because OS sleeps routinely overshoot by a millisecond or more. How early it wakes up adapts to the overshoot it
+    /// observes.
+    class FrameLimiter
+    {
+    public:
+        /// Minimum and maximum time spent spinning before a deadline. Platforms whose sleeps overshoot by more than
+        /// the maximum miss some deadlines rather than burn the CPU.
+        static constexpr std::chrono::microseconds MIN_SPIN_MARGIN{200};
+        static constexpr std::chrono::microseconds MAX_SPIN_MARGIN{1000};
+
+        /// Wait until one period after the previous deadline. If the frame overran its deadline, the schedule starts
+        /// over from now instead of running the next frames back to back to catch up.
+        /// @param frameRate Frames per second, 0 to return immediately.
+        void WaitForNextFrame(std::uint32_t frameRate);
+
+        /// Forget the previous deadline, the next wait is one period from now.
+        void Reset() noexcept;
+
+        /// @return Current spin margin.
+        [[nodiscard]]
+        std::chrono::nanoseconds GetSpinMargin() const noexcept
+        {
+            return m_spinMargin;
+        }
+
+    private:
+        void WaitUntil(std::chrono::steady_clock::time_point deadline);
+
+        std::chrono::steady_clock::time_point m_nextFrame{};
+        std::chrono::nanoseconds m_spinMargin = std::chrono::microseconds(500);
+    };
+} // namespace Hush
@@ -1,7 +1,14 @@
 #include "HushEngine.hpp"
 // #include <editor/UI.hpp>
 #include "ApplicationLoader.hpp"
+#include "Assertions.hpp"
+#include <InputManager.hpp>
+#include <Null/NullRenderer.hpp>
+#include <RenderThread.hpp>
 #include <WindowManager.hpp>
+#include <algorithm>
+#include <optional>
+#include <thread>
 #include <imgui/imgui.h>
 #include <spdlog/details/os-inl.h>
 
@@ -12,54 +19,229 @@ Hush::HushEngine::~HushEngine()
 
 void Hush::HushEngine::Run()
 {
+    // Registered before loading the application, so its systems can already use the frame resource
+    FrameAllocator::SetMain(&this->m_frameAllocator);
+
+    // The calling thread also runs a chunk of every parallel loop, so one worker less than there are cores
+    const std::uint32_t coreCount = std::thread::hardware_concurrency();
+    this->m_threadPool = std::make_unique<Threading::ThreadPool>(std::max(coreCount, 2u) - 1u);
+
     this->m_app = LoadApplication(this);
 
     this->m_isApplicationRunning = true;
+
+    if (this->m_isHeadless)
+    {
+        this->RunHeadless();
+    }
+    else
+    {
+        this->RunWindowed();
+    }
+
+    FrameAllocator::SetMain(nullptr);
+}
+
+void Hush::HushEngine::Quit()
+{
+    this->m_isApplicationRunning = false;
+}
+
+void Hush::HushEngine::SetRenderingPipelined(bool isPipelined)
+{
+    HUSH_ASSERT(!this->m_isApplicationRunning, "Rendering mode must be set before running the engine");
+
+    this->m_isRenderingPipelined = isPipelined;
+}
+
+void Hush::HushEngine::SetFramePacing(const FramePacingConfig &config)
+{
+    this->m_framePacing = config;
+}
+
+void Hush::HushEngine::SetFixedUpdateRate(std::uint32_t rate)
+{
+    HUSH_ASSERT(rate > 0, "Fixed update rate must be greater than 0");
+
+    this->m_fixedDeltaTime = std::chrono::nanoseconds(std::chrono::seconds(1)) / rate;
+}
+
+float Hush::HushEngine::GetFixedDeltaTime() const noexcept
+{
+    return std::chrono::duration<float>(this->m_fixedDeltaTime).count();
+}
+
+void Hush::HushEngine::SetMaxFixedStepsPerFrame(std::uint32_t maxSteps)
+{
+    HUSH_ASSERT(maxSteps > 0, "Max fixed steps per frame must be greater than 0");
+
+    this->m_maxFixedStepsPerFrame = maxSteps;
+}
+
+void Hush::HushEngine::SetHeadless(bool isHeadless)
+{
+    HUSH_ASSERT(!this->m_isApplicationRunning, "Headless mode must be set before running the engine");
+
+    this->m_isHeadless = isHeadless;
+}
+
+void Hush::HushEngine::SetHeadlessTickRate(std::uint32_t rate)
+{
+    this->m_headlessTickRate = rate;
+}
+
+void Hush::HushEngine::Init()
+{
+    this->m_app->Init();
+}
+
+void Hush::HushEngine::RunWindowed()
+{
     WindowRenderer mainRenderer(m_app->GetAppName().data());
     IRenderer *rendererImpl = mainRenderer.GetInternalRenderer();
+    rendererImpl->SetThreadPool(this->m_threadPool.get());
 
     // Initialize any static resources we need
     this->Init();
 
-    std::chrono::steady_clock::duration elapsed;
+    // Frame N is submitted by the render thread while the main thread simulates frame N+1
+    std::optional<RenderThread> renderThread;
+    if (this->m_isRenderingPipelined)
+    {
+        renderThread.emplace(rendererImpl);
+    }
+
+    // Timestamp of the oldest input event of the frame being submitted by the render thread
+    std::optional<std::uint32_t> pendingInputTimestamp;
+
+    FrameLimiter frameLimiter;
+    std::chrono::steady_clock::time_point previousFrame = std::chrono::steady_clock::now();
 
     while (this->m_isApplicationRunning)
     {
-        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
         mainRenderer.HandleEvents(&this->m_isApplicationRunning);
+        const InputEventBatch &eventBatch = mainRenderer.GetEventBatch();
         // TODO: Change this to the window renderer
         if (!mainRenderer.IsActive())
         {
-            // Arbitrary sleep to avoid taking all CPU usage
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            // Keep polling events at a low rate, so the window notices when it is restored
+            frameLimiter.WaitForNextFrame(std::max(this->m_framePacing.minimizedFrameRate, MIN_MINIMIZED_FRAME_RATE));
+            // Time spent inactive is not simulated
+            previousFrame = std::chrono::steady_clock::now();
             continue;
         }
 
-        const float deltaTime = std::chrono::duration<float>(elapsed).count();
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        const std::chrono::nanoseconds frameTime =
+            std::min<std::chrono::nanoseconds>(now - previousFrame, MAX_FRAME_TIME);
+        previousFrame = now;
+
+        const float deltaTime = std::chrono::duration<float>(frameTime).count();
+
+        this->SimulateFrame(rendererImpl, frameTime);
+
+        if (renderThread.has_value())
+        {
+            // Only one frame in flight, the renderer is not touched again until the previous one is submitted
+            renderThread->WaitIdle();
+            if (pendingInputTimestamp.has_value())
+            {
+                InputManager::RecordInputLatency(*pendingInputTimestamp);
+                pendingInputTimestamp.reset();
+            }
+
+            rendererImpl->Extract(deltaTime);
+            renderThread->Kick();
+
+            if (eventBatch.eventCount != 0)
+            {
+                pendingInputTimestamp = eventBatch.oldestEventTimestamp;
+            }
+        }
+        else
+        {
+            rendererImpl->Draw(deltaTime);
+
+            if (eventBatch.eventCount != 0)
+            {
+                InputManager::RecordInputLatency(eventBatch.oldestEventTimestamp);
+            }
+        }
 
-        this->m_app->Update(deltaTime);
+        this->m_app->OnPostRender();
 
-        this->m_app->OnPreRender();
+        frameLimiter.WaitForNextFrame(mainRenderer.HasFocus() ? this->m_framePacing.targetFrameRate
+                                                              : this->m_framePacing.backgroundFrameRate);
+    }
+}
 
-        rendererImpl->NewUIFrame();
+void Hush::HushEngine::RunHeadless()
+{
+    // No window, no GPU: the renderer only keeps an ImGui context around so applications can still build their UI
+    NullRenderer renderer;
+    renderer.InitImGui();
+
+    this->Init();
 
-        this->m_app->OnRender();
+    FrameLimiter frameLimiter;
+    std::chrono::steady_clock::time_point previousFrame = std::chrono::steady_clock::now();
 
-        rendererImpl->Draw(deltaTime);
+    while (this->m_isApplicationRunning)
+    {
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        const std::chrono::nanoseconds frameTime =
+            std::min<std::chrono::nanoseconds>(now - previousFrame, MAX_FRAME_TIME);
+        previousFrame = now;
+
+        const float deltaTime = std::chrono::duration<float>(frameTime).count();
+
+        this->SimulateFrame(&renderer, frameTime);
+
+        renderer.Draw(deltaTime);
 
         this->m_app->OnPostRender();
 
-        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
-        elapsed = end - start;
+        frameLimiter.WaitForNextFrame(this->m_headlessTickRate);
     }
 }
 
-void Hush::HushEngine::Quit()
+void Hush::HushEngine::SimulateFrame(IRenderer *renderer, std::chrono::nanoseconds frameTime)
 {
-    this->m_isApplicationRunning = false;
+    const float deltaTime = std::chrono::duration<float>(frameTime).count();
+
+    // Frame allocations of the previous frame stay alive, the render thread might still be reading them
+    this->m_frameAllocator.BeginFrame();
+
+    this->RunFixedUpdates(frameTime);
+
+    this->m_app->Update(deltaTime);
+
+    this->m_app->SetInterpolationAlpha(this->m_interpolationAlpha);
+    this->m_app->OnPreRender();
+
+    renderer->NewUIFrame();
+
+    this->m_app->OnRender();
 }
 
-void Hush::HushEngine::Init()
+void Hush::HushEngine::RunFixedUpdates(std::chrono::nanoseconds frameTime)
 {
-    this->m_app->Init();
+    const float fixedDeltaTime = this->GetFixedDeltaTime();
+
+    this->m_fixedTimeAccumulator += frameTime;
+
+    for (std::uint32_t step = 0;
+         step < this->m_maxFixedStepsPerFrame && this->m_fixedTimeAccumulator >= this->m_fixedDeltaTime; ++step)
+    {
+        this->m_app->FixedUpdate(fixedDeltaTime);
+        this->m_fixedTimeAccumulator -= this->m_fixedDeltaTime;
+    }
+
+    // Too far behind, drop the whole steps we could not run instead of carrying them over to the next frame
+    if (this->m_fixedTimeAccumulator >= this->m_fixedDeltaTime)
+    {
+        this->m_fixedTimeAccumulator %= this->m_fixedDeltaTime;
+    }
+
+    this->m_interpolationAlpha = std::chrono::duration<float>(this->m_fixedTimeAccumulator).count() / fixedDeltaTime;
 }
@@ -5,12 +5,20 @@
 */
 
 #pragma once
+#include "FrameAllocator.hpp"
+#include "FrameLimiter.hpp"
 #include "IApplication.hpp"
 
+#include <ThreadPool.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
 #include <string_view>
 
 namespace Hush
 {
+    class IRenderer;
+
     class HushEngine
     {
       public:
@@ -22,9 +30,9 @@ namespace Hush
         HushEngine(const HushEngine &) = delete;
         HushEngine &operator=(const HushEngine &) = delete;
 
-        HushEngine(HushEngine &&) noexcept = default;
-
-        HushEngine &operator=(HushEngine &&) noexcept = default;
+        // The frame allocator cannot be moved, it owns a mutex and other threads hold pointers to its arenas.
+        HushEngine(HushEngine &&) = delete;
+        HushEngine &operator=(HushEngine &&) = delete;
 
         ~HushEngine();
 
@@ -38,12 +46,150 @@ namespace Hush
         /// </summary>
         void Quit();
 
+        /// <summary>
+        /// Enables pipelined rendering. Frames are extracted into a snapshot on the main thread and submitted on a
+        /// render thread, which overlaps the submission of a frame with the simulation of the next one, at the cost of
+        /// one frame of latency. Must be called before Run
+        /// </summary>
+        /// <param name="isPipelined">Whether rendering is pipelined</param>
+        void SetRenderingPipelined(bool isPipelined);
+
+        /// <summary>
+        /// Enables headless mode, for servers and automated tests without a display or a GPU. The application and its
+        /// scenes run as usual, but no window is created and rendering goes to a null renderer. Must be called before
+        /// Run
+        /// </summary>
+        /// <param name="isHeadless">Whether the engine runs headless</param>
+        void SetHeadless(bool isHeadless);
+
+        /// <summary>
+        /// Sets how many frames per second are run in headless mode. There is no vsync to pace them otherwise
+        /// </summary>
+        /// <param name="rate">Frames per second, 0 to run as fast as possible</param>
+        void SetHeadlessTickRate(std::uint32_t rate);
+
+        /// <summary>
+        /// Sets the frame rate caps of the main loop, for the focused, background and minimized window. Can be
+        /// changed while running
+        /// </summary>
+        /// <param name="config">Frame pacing configuration</param>
+        void SetFramePacing(const FramePacingConfig &config);
+
+        /// <summary>
+        /// Gets the frame rate caps of the main loop
+        /// </summary>
+        [[nodiscard]]
+        const FramePacingConfig &GetFramePacing() const noexcept
+        {
+            return m_framePacing;
+        }
+
+        /// <summary>
+        /// Sets how many times per second FixedUpdate is called
+        /// </summary>
+        /// <param name="rate">Fixed updates per second, must be greater than 0</param>
+        void SetFixedUpdateRate(std::uint32_t rate);
+
+        /// <summary>
+        /// Gets the time step passed to FixedUpdate, in seconds
+        /// </summary>
+        [[nodiscard]]
+        float GetFixedDeltaTime() const noexcept;
+
+        /// <summary>
+        /// Sets the max number of fixed updates run in a single frame. When a frame takes longer than this many
+        /// steps, the remaining time is dropped and the simulation runs slower than real time instead of falling
+        /// further behind every frame
+        /// </summary>
+        /// <param name="maxSteps">Max fixed updates per frame, must be greater than 0</param>
+        void SetMaxFixedStepsPerFrame(std::uint32_t maxSteps);
+
+        /// <summary>
+        /// Gets how far the current frame is between the last fixed update and the next one, in [0, 1). Render
+        /// systems use it to interpolate between the previous and the current fixed update state
+        /// </summary>
+        [[nodiscard]]
+        float GetInterpolationAlpha() const noexcept
+        {
+            return m_interpolationAlpha;
+        }
+
+        /// <summary>
+        /// Gets the per-frame allocator. Memory allocated from it is released automatically two frames later, so
+        /// systems can use it for scratch containers without touching the heap
+        /// </summary>
+        [[nodiscard]]
+        FrameAllocator &GetFrameAllocator() noexcept
+        {
+            return m_frameAllocator;
+        }
+
+        /// <summary>
+        /// Gets the worker threads of the engine. The renderer splits the culling and the command recording of big
+        /// scenes across them, and applications can give them to their scenes (see Scene::SetThreadPool). Created by
+        /// Run, nullptr before
+        /// </summary>
+        [[nodiscard]]
+        Threading::ThreadPool *GetThreadPool() const noexcept
+        {
+            return m_threadPool.get();
+        }
+
       private:
         void Init();
 
+        /// <summary>
+        /// Main loop with a window and a GPU renderer
+        /// </summary>
+        void RunWindowed();
+
+        /// <summary>
+        /// Main loop without a window, see SetHeadless
+        /// </summary>
+        void RunHeadless();
+
+        /// <summary>
+        /// Runs the application part of a frame, up to and including OnRender
+        /// </summary>
+        /// <param name="renderer">Renderer the UI frame is started with</param>
+        /// <param name="frameTime">Time since the last frame</param>
+        void SimulateFrame(IRenderer *renderer, std::chrono::nanoseconds frameTime);
+
+        /// <summary>
+        /// Runs the fixed updates that fit in the accumulated time and updates the interpolation alpha
+        /// </summary>
+        /// <param name="frameTime">Time since the last frame</param>
+        void RunFixedUpdates(std::chrono::nanoseconds frameTime);
+
+        static constexpr std::uint32_t DEFAULT_FIXED_UPDATE_RATE = 60;
+        static constexpr std::uint32_t DEFAULT_MAX_FIXED_STEPS_PER_FRAME = 8;
+        static constexpr std::uint32_t DEFAULT_HEADLESS_TICK_RATE = 60;
+
+        /// Frames longer than this (breakpoints, loading hitches) are clamped, so they do not turn into a burst of
+        /// fixed updates and a huge delta time
+        static constexpr std::chrono::milliseconds MAX_FRAME_TIME{250};
+
+        /// Lowest rate events are polled at while minimized. An uncapped rate would spin on an empty loop
+        static constexpr std::uint32_t MIN_MINIMIZED_FRAME_RATE = 1;
+
+        /// Declared before the application, so it outlives the scenes using it
+        std::unique_ptr<Threading::ThreadPool> m_threadPool;
+
         std::unique_ptr<IApplication> m_app;
 
+        std::chrono::nanoseconds m_fixedDeltaTime = std::chrono::nanoseconds(std::chrono::seconds(1)) /
+                                                    DEFAULT_FIXED_UPDATE_RATE;
+        std::chrono::nanoseconds m_fixedTimeAccumulator{0};
+        std::uint32_t m_maxFixedStepsPerFrame = DEFAULT_MAX_FIXED_STEPS_PER_FRAME;
+        float m_interpolationAlpha = 0.0f;
+
         bool m_isApplicationRunning = false;
+        FramePacingConfig m_framePacing;
+        FrameAllocator m_frameAllocator;
+
+        bool m_isRenderingPipelined = false;
+        bool m_isHeadless = false;
+        std::uint32_t m_headlessTickRate = DEFAULT_HEADLESS_TICK_RATE;
         static constexpr std::string_view ENGINE_WINDOW_NAME = "Hush Engine";
     };
 
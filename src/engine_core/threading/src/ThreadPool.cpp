@@ -13,6 +13,15 @@
 #include <semaphore>
 #include <thread>
 
+namespace
+{
+    /// Thread pool of the calling thread, nullptr if it is not a worker thread.
+    thread_local const Hush::Threading::ThreadPool *CurrentThreadPool = nullptr;
+
+    /// Index of the calling thread in its thread pool.
+    thread_local std::uint32_t CurrentThreadIndex = 0;
+} // namespace
+
 Hush::Threading::impl::WorkerQueue::WorkerQueue(ThreadPool *threadPool)
     : m_threadPool(threadPool),
       m_tasks(),
@@ -226,6 +235,9 @@ void Hush::Threading::impl::WorkerThread::Notify()
 
 void Hush::Threading::impl::WorkerThread::ThreadFunction(std::stop_token stopToken)
 {
+    CurrentThreadPool = m_workerQueue->GetThreadPool();
+    CurrentThreadIndex = m_threadIndex;
+
     m_state = EWorkerThreadState::Running;
 
     while (!stopToken.stop_requested())
@@ -429,6 +441,16 @@ void Hush::Threading::ThreadPool::Start()
     }
 }
 
+std::optional<std::uint32_t> Hush::Threading::ThreadPool::GetCurrentThreadIndex() const noexcept
+{
+    if (CurrentThreadPool != this)
+    {
+        return std::nullopt;
+    }
+
+    return CurrentThreadIndex;
+}
+
 void Hush::Threading::ThreadPool::WaitUntilDone()
 {
     // Wait until all threads are Idle AND the global queue is empty
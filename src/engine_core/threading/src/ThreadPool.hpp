@@ -9,13 +9,18 @@
 #include "async/SyncWait.hpp"
 #include "async/Task.hpp"
 
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <coroutine>
+#include <functional>
 #include <mutex>
+#include <optional>
 #include <span>
 #include <thread>
 #include <deque>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace Hush::Threading
@@ -66,6 +71,14 @@ namespace Hush::Threading
             /// @return Steals a task from another thread.
             TaskOperation * StealFromOtherThread(std::uint32_t threadNumber);
 
+            /// Gets the thread pool the queue belongs to.
+            /// @return The thread pool.
+            [[nodiscard]]
+            ThreadPool *GetThreadPool() const noexcept
+            {
+                return m_threadPool;
+            }
+
         private:
             /// Reference to the thread pool, it is used to push tasks to the global queue in case the worker queue is
             /// full.
@@ -268,6 +281,62 @@ namespace Hush::Threading
             return std::move(task);
         }
 
+        /// Runs a function over the range [0, count), split in at most one chunk per thread. The calling thread runs
+        /// the first chunk and waits for the rest, so the function only needs to live until this returns.
+        ///
+        /// Called from a worker of this pool (i.e. nested in another ParallelFor), the whole range runs in the calling
+        /// thread: the worker would otherwise wait for chunks that only busy workers can pick up.
+        /// @tparam Fn The function type, called as function(first, last) for each chunk [first, last).
+        /// @param count Number of elements.
+        /// @param minBatch Minimum number of elements of a chunk, the size of every chunk but the last one is a
+        /// multiple of it. If the whole range fits in one chunk, it runs in the calling thread.
+        /// @param function Function to run for each chunk. It is called concurrently.
+        template <typename Fn>
+            requires std::is_invocable_v<Fn &, std::size_t, std::size_t>
+        void ParallelFor(std::size_t count, std::size_t minBatch, Fn &&function)
+        {
+            if (count == 0)
+            {
+                return;
+            }
+
+            minBatch = std::max<std::size_t>(minBatch, 1);
+            const std::size_t maxChunks = GetNumThreads() + 1;
+            const std::size_t chunkSize = ((count + maxChunks - 1) / maxChunks + minBatch - 1) / minBatch * minBatch;
+
+            if (chunkSize >= count || GetCurrentThreadIndex().has_value())
+            {
+                std::invoke(function, std::size_t{0}, count);
+                return;
+            }
+
+            const auto runChunk = [&function](std::pair<std::size_t, std::size_t> chunk) {
+                std::invoke(function, chunk.first, chunk.second);
+            };
+
+            // Jobs take the function and their arguments by reference, so the chunks are stored until they finish.
+            std::vector<std::pair<std::size_t, std::size_t>> chunks;
+            chunks.reserve((count + chunkSize - 1) / chunkSize);
+            for (std::size_t first = 0; first < count; first += chunkSize)
+            {
+                chunks.emplace_back(first, std::min(first + chunkSize, count));
+            }
+
+            std::vector<Job> jobs;
+            jobs.reserve(chunks.size() - 1);
+            for (std::size_t i = 1; i < chunks.size(); ++i)
+            {
+                jobs.push_back(ScheduleFunction(runChunk, chunks[i]));
+            }
+
+            runChunk(chunks.front());
+
+            for (Job &job : jobs)
+            {
+                job.Wait();
+            }
+        }
+
         /// Starts the thread pool.
         void Start();
 
@@ -283,6 +352,12 @@ namespace Hush::Threading
             return static_cast<std::uint32_t>(m_workerThreads.size());
         }
 
+        /// Gets the index of the calling thread in the thread pool.
+        /// @return Index of the worker thread, in [0, GetNumThreads()). std::nullopt if the calling thread is not a
+        /// worker of this thread pool.
+        [[nodiscard]]
+        std::optional<std::uint32_t> GetCurrentThreadIndex() const noexcept;
+
     private:
         /// Steals a task from another thread.
         /// @param threadNumber The thread number of the current thread.
@@ -7,10 +7,13 @@
 #include "ThreadPool.hpp"
 
 #include <Logger.hpp>
+#include <algorithm>
+#include <atomic>
 #include <catch2/catch_test_macros.hpp>
 #include <fstream>
 #include <random>
 #include <set>
+#include <thread>
 
 using ThreadPool = Hush::Threading::ThreadPool;
 template <typename T>
@@ -172,4 +175,114 @@ TEST_CASE("Multithread")
         // Assert
         REQUIRE(threadIds.size() == threadPool.GetNumThreads());
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("GetCurrentThreadIndex")
+{
+    ThreadPool threadPool(2);
+    threadPool.Start();
+
+    ThreadPool otherThreadPool(1);
+    otherThreadPool.Start();
+
+    SECTION("GetCurrentThreadIndex")
+    {
+        // Arrange
+        std::optional<std::uint32_t> index;
+        std::optional<std::uint32_t> otherIndex;
+        auto threadFunction = [&]() {
+            index = threadPool.GetCurrentThreadIndex();
+            otherIndex = otherThreadPool.GetCurrentThreadIndex();
+        };
+
+        // Act
+        Job job = threadPool.ScheduleFunction(threadFunction);
+        Hush::Threading::Wait(job);
+
+        // Assert
+        REQUIRE(!threadPool.GetCurrentThreadIndex().has_value());
+        REQUIRE(index.has_value());
+        REQUIRE(*index < threadPool.GetNumThreads());
+        REQUIRE(!otherIndex.has_value());
+    }
+}
+
+TEST_CASE("ParallelFor")
+{
+    ThreadPool threadPool(3);
+    threadPool.Start();
+
+    SECTION("Every element is visited once")
+    {
+        // Arrange
+        constexpr std::size_t count = 10007;
+        constexpr std::size_t minBatch = 16;
+        std::vector<std::uint32_t> visits(count, 0);
+        std::mutex mutex;
+        std::vector<std::pair<std::size_t, std::size_t>> chunks;
+
+        // Act
+        threadPool.ParallelFor(count, minBatch, [&](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i)
+            {
+                ++visits[i];
+            }
+
+            std::lock_guard lock(mutex);
+            chunks.emplace_back(first, last);
+        });
+
+        // Assert
+        REQUIRE(std::ranges::all_of(visits, [](std::uint32_t visit) { return visit == 1; }));
+        REQUIRE(chunks.size() <= threadPool.GetNumThreads() + 1);
+        for (const auto &[first, last] : chunks)
+        {
+            REQUIRE((last == count || (last - first) % minBatch == 0));
+        }
+    }
+
+    SECTION("Small ranges run in the calling thread")
+    {
+        // Arrange
+        std::thread::id threadId;
+
+        // Act
+        threadPool.ParallelFor(8, 16, [&threadId](std::size_t first, std::size_t last) {
+            REQUIRE(first == 0);
+            REQUIRE(last == 8);
+            threadId = std::this_thread::get_id();
+        });
+
+        // Assert
+        REQUIRE(threadId == std::this_thread::get_id());
+    }
+
+    SECTION("Nested loops run inline in the workers")
+    {
+        // Arrange
+        constexpr std::size_t outerCount = 64;
+        constexpr std::size_t innerCount = 1000;
+        std::atomic<std::size_t> visits = 0;
+        std::atomic<std::size_t> innerCallsOffCaller = 0;
+
+        // Act, every worker runs a nested loop while the others are busy too
+        threadPool.ParallelFor(outerCount, 1, [&](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i)
+            {
+                const std::thread::id outerThread = std::this_thread::get_id();
+                const bool isOuterWorker = threadPool.GetCurrentThreadIndex().has_value();
+                threadPool.ParallelFor(innerCount, 1, [&](std::size_t innerFirst, std::size_t innerLast) {
+                    visits.fetch_add(innerLast - innerFirst);
+                    if (isOuterWorker && std::this_thread::get_id() != outerThread)
+                    {
+                        innerCallsOffCaller.fetch_add(1);
+                    }
+                });
+            }
+        });
+
+        // Assert
+        REQUIRE(visits.load() == outerCount * innerCount);
+        REQUIRE(innerCallsOffCaller.load() == 0);
+    }
+}
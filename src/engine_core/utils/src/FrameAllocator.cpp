@@ -0,0 +1,226 @@
+/*! \file FrameAllocator.cpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Per-frame linear allocator
+*/
+
+#include "FrameAllocator.hpp"
+
+#include <algorithm>
+#include <new>
+
+namespace
+{
+    /// Alignment of every block, allocations with a bigger alignment are aligned inside the block.
+    constexpr std::size_t BLOCK_ALIGNMENT = alignof(std::max_align_t) > 64 ? alignof(std::max_align_t) : 64;
+
+    std::atomic<std::uint64_t> g_nextAllocatorId = 1;
+
+    std::atomic<Hush::FrameAllocator *> g_mainFrameAllocator = nullptr;
+
+    std::uintptr_t AlignUp(std::uintptr_t value, std::size_t alignment) noexcept
+    {
+        return (value + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+    }
+} // namespace
+
+Hush::LinearArena::LinearArena(std::size_t blockSize) noexcept
+    : m_blockSize(std::max<std::size_t>(blockSize, BLOCK_ALIGNMENT))
+{
+}
+
+Hush::LinearArena::~LinearArena()
+{
+    FreeBlocks();
+}
+
+void Hush::LinearArena::Reset()
+{
+    if (m_blocks.size() > 1)
+    {
+        // Coalesce, the next frame will probably need as much memory as this one.
+        const std::size_t totalSize = m_capacity.load(std::memory_order_relaxed);
+        FreeBlocks();
+        AddBlock(totalSize);
+    }
+
+    m_currentBlock = 0;
+    m_offset = 0;
+    m_usedBytes.store(0, std::memory_order_relaxed);
+}
+
+void *Hush::LinearArena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    while (true)
+    {
+        if (m_currentBlock < m_blocks.size())
+        {
+            const Block &block = m_blocks[m_currentBlock];
+            const auto base = reinterpret_cast<std::uintptr_t>(block.data);
+            const std::uintptr_t aligned = AlignUp(base + m_offset, alignment);
+
+            if (aligned + bytes <= base + block.size)
+            {
+                const std::size_t newOffset = aligned + bytes - base;
+                const std::size_t used = m_usedBytes.load(std::memory_order_relaxed) + (newOffset - m_offset);
+                m_offset = newOffset;
+
+                m_usedBytes.store(used, std::memory_order_relaxed);
+                if (used > m_highWaterMark.load(std::memory_order_relaxed))
+                {
+                    m_highWaterMark.store(used, std::memory_order_relaxed);
+                }
+
+                return reinterpret_cast<void *>(aligned);
+            }
+
+            if (m_currentBlock + 1 < m_blocks.size())
+            {
+                ++m_currentBlock;
+                m_offset = 0;
+                continue;
+            }
+        }
+
+        AddBlock(bytes + alignment);
+        m_currentBlock = m_blocks.size() - 1;
+        m_offset = 0;
+    }
+}
+
+void Hush::LinearArena::AddBlock(std::size_t minSize)
+{
+    const std::size_t lastSize = m_blocks.empty() ? m_blockSize : m_blocks.back().size * 2;
+    const std::size_t size = AlignUp(std::max(minSize, lastSize), BLOCK_ALIGNMENT);
+
+    auto *data = static_cast<std::byte *>(::operator new(size, std::align_val_t{BLOCK_ALIGNMENT}));
+    m_blocks.push_back({data, size});
+
+    m_capacity.fetch_add(size, std::memory_order_relaxed);
+    m_blockAllocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Hush::LinearArena::FreeBlocks() noexcept
+{
+    for (const Block &block : m_blocks)
+    {
+        ::operator delete(block.data, std::align_val_t{BLOCK_ALIGNMENT});
+    }
+
+    m_blocks.clear();
+    m_capacity.store(0, std::memory_order_relaxed);
+}
+
+Hush::FrameAllocator::FrameAllocator(std::uint32_t framesInFlight, std::size_t blockSize) noexcept
+    : m_framesInFlight(std::clamp<std::uint32_t>(framesInFlight, 1, MAX_FRAMES_IN_FLIGHT)),
+      m_blockSize(blockSize),
+      m_id(g_nextAllocatorId.fetch_add(1, std::memory_order_relaxed))
+{
+}
+
+Hush::FrameAllocator::~FrameAllocator()
+{
+    FrameAllocator *self = this;
+    g_mainFrameAllocator.compare_exchange_strong(self, nullptr);
+}
+
+void Hush::FrameAllocator::BeginFrame() noexcept
+{
+    m_frame.fetch_add(1, std::memory_order_acq_rel);
+}
+
+std::pmr::memory_resource *Hush::FrameAllocator::GetResource()
+{
+    ThreadArenas &threadArenas = GetThreadArenas();
+
+    const std::uint64_t frame = m_frame.load(std::memory_order_acquire);
+    const std::size_t index = frame % m_framesInFlight;
+
+    // The arena was last used framesInFlight frames ago (or never), nothing can reference it anymore.
+    if (threadArenas.frames[index].load(std::memory_order_relaxed) != frame)
+    {
+        threadArenas.arenas[index].Reset();
+        threadArenas.frames[index].store(frame, std::memory_order_relaxed);
+    }
+
+    return &threadArenas.arenas[index];
+}
+
+Hush::FrameAllocatorStats Hush::FrameAllocator::GetStats() const
+{
+    std::scoped_lock lock(m_threadsMutex);
+
+    const std::uint64_t frame = m_frame.load(std::memory_order_acquire);
+    const std::size_t index = frame % m_framesInFlight;
+
+    FrameAllocatorStats stats;
+    stats.threadCount = static_cast<std::uint32_t>(m_threads.size());
+
+    for (const std::unique_ptr<ThreadArenas> &threadArenas : m_threads)
+    {
+        // Only count the arena if it was used this frame, otherwise it still holds the bytes of an older frame.
+        if (threadArenas->frames[index].load(std::memory_order_relaxed) == frame)
+        {
+            stats.usedBytes += threadArenas->arenas[index].GetUsedBytes();
+        }
+
+        for (std::uint32_t i = 0; i < m_framesInFlight; ++i)
+        {
+            const LinearArena &arena = threadArenas->arenas[i];
+            stats.highWaterMark += arena.GetHighWaterMark();
+            stats.capacity += arena.GetCapacity();
+            stats.blockAllocations += arena.GetBlockAllocations();
+        }
+    }
+
+    return stats;
+}
+
+Hush::FrameAllocator *Hush::FrameAllocator::GetMain() noexcept
+{
+    return g_mainFrameAllocator.load(std::memory_order_acquire);
+}
+
+void Hush::FrameAllocator::SetMain(FrameAllocator *allocator) noexcept
+{
+    g_mainFrameAllocator.store(allocator, std::memory_order_release);
+}
+
+Hush::FrameAllocator::ThreadArenas &Hush::FrameAllocator::GetThreadArenas()
+{
+    // Most threads only ever talk to the main allocator, so caching the last one avoids taking the lock.
+    thread_local std::uint64_t cachedAllocatorId = 0;
+    thread_local ThreadArenas *cachedArenas = nullptr;
+
+    if (cachedAllocatorId == m_id)
+    {
+        return *cachedArenas;
+    }
+
+    const std::thread::id threadId = std::this_thread::get_id();
+
+    std::scoped_lock lock(m_threadsMutex);
+
+    auto it = std::find_if(m_threads.begin(), m_threads.end(),
+                           [threadId](const std::unique_ptr<ThreadArenas> &arenas) {
+                               return arenas->threadId == threadId;
+                           });
+
+    if (it == m_threads.end())
+    {
+        m_threads.push_back(std::make_unique<ThreadArenas>(threadId, m_blockSize));
+        it = std::prev(m_threads.end());
+    }
+
+    cachedAllocatorId = m_id;
+    cachedArenas = it->get();
+
+    return *cachedArenas;
+}
+
+std::pmr::memory_resource *Hush::GetFrameResource()
+{
+    FrameAllocator *allocator = FrameAllocator::GetMain();
+
+    return allocator != nullptr ? allocator->GetResource() : std::pmr::get_default_resource();
+}
@@ -0,0 +1,214 @@
+/*! \file FrameAllocator.hpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Per-frame linear allocator
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Hush
+{
+    /// Bump allocator backed by a list of blocks. Deallocation is a no-op, memory is only reclaimed by Reset().
+    /// Not thread safe, each thread should use its own arena.
+    class LinearArena final : public std::pmr::memory_resource
+    {
+      public:
+        /// Size of the first block of the arena.
+        constexpr static std::size_t DEFAULT_BLOCK_SIZE = 256 * 1024;
+
+        /// Constructs an empty arena. No memory is allocated until the first allocation.
+        /// @param blockSize Size of the first block.
+        explicit LinearArena(std::size_t blockSize = DEFAULT_BLOCK_SIZE) noexcept;
+
+        LinearArena(const LinearArena &) = delete;
+        LinearArena &operator=(const LinearArena &) = delete;
+
+        ~LinearArena() override;
+
+        /// Releases every allocation at once. If the last use spilled into several blocks, they are replaced by a
+        /// single block big enough for all of them, so the same workload fits in one block from now on.
+        void Reset();
+
+        /// @return Bytes allocated since the last reset, including alignment padding.
+        [[nodiscard]]
+        std::size_t GetUsedBytes() const noexcept
+        {
+            return m_usedBytes.load(std::memory_order_relaxed);
+        }
+
+        /// @return Maximum number of bytes used between two resets.
+        [[nodiscard]]
+        std::size_t GetHighWaterMark() const noexcept
+        {
+            return m_highWaterMark.load(std::memory_order_relaxed);
+        }
+
+        /// @return Size of all the blocks owned by the arena.
+        [[nodiscard]]
+        std::size_t GetCapacity() const noexcept
+        {
+            return m_capacity.load(std::memory_order_relaxed);
+        }
+
+        /// @return Number of blocks requested to the heap during the lifetime of the arena.
+        [[nodiscard]]
+        std::uint64_t GetBlockAllocations() const noexcept
+        {
+            return m_blockAllocations.load(std::memory_order_relaxed);
+        }
+
+      protected:
+        void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+        void do_deallocate(void *, std::size_t, std::size_t) override
+        {
+            // Memory is released in Reset.
+        }
+
+        [[nodiscard]]
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+        {
+            return this == &other;
+        }
+
+      private:
+        struct Block
+        {
+            std::byte *data;
+            std::size_t size;
+        };
+
+        /// Allocates a new block at the end of the block list.
+        /// @param minSize Minimum size of the block.
+        void AddBlock(std::size_t minSize);
+
+        void FreeBlocks() noexcept;
+
+        std::vector<Block> m_blocks;
+        std::size_t m_currentBlock = 0;
+        std::size_t m_offset = 0;
+        std::size_t m_blockSize;
+
+        // Stats are atomic so other threads can read them while the owner allocates.
+        std::atomic<std::size_t> m_usedBytes = 0;
+        std::atomic<std::size_t> m_highWaterMark = 0;
+        std::atomic<std::size_t> m_capacity = 0;
+        std::atomic<std::uint64_t> m_blockAllocations = 0;
+    };
+
+    /// Stats of a FrameAllocator, aggregated over all threads.
+    struct FrameAllocatorStats
+    {
+        /// Number of threads that allocated from the allocator.
+        std::uint32_t threadCount = 0;
+        /// Bytes used by all threads in the current frame.
+        std::size_t usedBytes = 0;
+        /// Sum of the high-water marks of every arena.
+        std::size_t highWaterMark = 0;
+        /// Memory reserved by all arenas.
+        std::size_t capacity = 0;
+        /// Blocks requested to the heap since creation. Stops growing once the arenas are warm.
+        std::uint64_t blockAllocations = 0;
+    };
+
+    /// Multi-buffered per-frame allocator. Each thread gets its own LinearArena per frame in flight, so jobs can
+    /// allocate without locks. Memory allocated during frame N stays valid until frame N + framesInFlight begins, which
+    /// lets a pipelined render thread read data produced in the previous frame.
+    /// Arenas are reset lazily by their owner thread the first time they are used in a new frame.
+    class FrameAllocator
+    {
+      public:
+        /// Maximum number of frames whose memory can be alive at the same time.
+        constexpr static std::uint32_t MAX_FRAMES_IN_FLIGHT = 3;
+
+        /// Constructs a frame allocator.
+        /// @param framesInFlight Number of frames an allocation survives, in [1, MAX_FRAMES_IN_FLIGHT].
+        /// @param blockSize Size of the first block of every arena.
+        explicit FrameAllocator(std::uint32_t framesInFlight = 2,
+                                std::size_t blockSize = LinearArena::DEFAULT_BLOCK_SIZE) noexcept;
+
+        FrameAllocator(const FrameAllocator &) = delete;
+        FrameAllocator &operator=(const FrameAllocator &) = delete;
+
+        ~FrameAllocator();
+
+        /// Starts a new frame. Must be called when no other thread is allocating for the frame that is ending.
+        void BeginFrame() noexcept;
+
+        /// Gets the arena of the calling thread for the current frame.
+        /// @return Memory resource that can be used with std::pmr containers.
+        [[nodiscard]]
+        std::pmr::memory_resource *GetResource();
+
+        /// @return Number of frames started since the allocator was created.
+        [[nodiscard]]
+        std::uint64_t GetFrameNumber() const noexcept
+        {
+            return m_frame.load(std::memory_order_acquire);
+        }
+
+        /// @return Number of frames an allocation survives.
+        [[nodiscard]]
+        std::uint32_t GetFramesInFlight() const noexcept
+        {
+            return m_framesInFlight;
+        }
+
+        /// @return Stats aggregated over all threads.
+        [[nodiscard]]
+        FrameAllocatorStats GetStats() const;
+
+        /// Gets the allocator used by the engine, might be nullptr if no engine is running.
+        /// @return The main frame allocator.
+        [[nodiscard]]
+        static FrameAllocator *GetMain() noexcept;
+
+        /// Sets the allocator used by the engine.
+        /// @param allocator Frame allocator, or nullptr to clear it.
+        static void SetMain(FrameAllocator *allocator) noexcept;
+
+      private:
+        struct ThreadArenas
+        {
+            std::thread::id threadId;
+            std::array<LinearArena, MAX_FRAMES_IN_FLIGHT> arenas;
+            /// Frame number each arena was last reset for.
+            std::array<std::atomic<std::uint64_t>, MAX_FRAMES_IN_FLIGHT> frames{};
+
+            static_assert(MAX_FRAMES_IN_FLIGHT == 3, "Update the arena initializer");
+
+            ThreadArenas(std::thread::id id, std::size_t blockSize) noexcept
+                : threadId(id),
+                  arenas{LinearArena(blockSize), LinearArena(blockSize), LinearArena(blockSize)}
+            {
+            }
+        };
+
+        /// Gets or creates the arenas of the calling thread.
+        ThreadArenas &GetThreadArenas();
+
+        std::uint32_t m_framesInFlight;
+        std::size_t m_blockSize;
+        /// Unique id used to invalidate the thread local cache when an allocator is destroyed.
+        std::uint64_t m_id;
+        std::atomic<std::uint64_t> m_frame = 0;
+
+        mutable std::mutex m_threadsMutex;
+        std::vector<std::unique_ptr<ThreadArenas>> m_threads;
+    };
+
+    /// Gets the calling thread's arena of the main frame allocator.
+    /// @return Frame memory resource, or the default memory resource if there is no main frame allocator.
+    [[nodiscard]]
+    std::pmr::memory_resource *GetFrameResource();
+} // namespace Hush
@@ -0,0 +1,154 @@
+/*! \file MappedFile.cpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Read-only memory mapped file
+*/
+
+#include "MappedFile.hpp"
+#include "Platform.hpp"
+
+#include <utility>
+
+#if HUSH_PLATFORM_WIN
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+Hush::MappedFile::MappedFile(const std::byte *data, std::size_t size, void *mappingHandle) noexcept
+    : m_data(data),
+      m_size(size),
+      m_mappingHandle(mappingHandle)
+{
+}
+
+Hush::MappedFile::MappedFile(MappedFile &&rhs) noexcept
+    : m_data(std::exchange(rhs.m_data, nullptr)),
+      m_size(std::exchange(rhs.m_size, 0)),
+      m_mappingHandle(std::exchange(rhs.m_mappingHandle, nullptr))
+{
+}
+
+Hush::MappedFile &Hush::MappedFile::operator=(MappedFile &&rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        Unmap();
+        m_data = std::exchange(rhs.m_data, nullptr);
+        m_size = std::exchange(rhs.m_size, 0);
+        m_mappingHandle = std::exchange(rhs.m_mappingHandle, nullptr);
+    }
+
+    return *this;
+}
+
+Hush::MappedFile::~MappedFile()
+{
+    Unmap();
+}
+
+Hush::Result<Hush::MappedFile, Hush::MappedFile::EError> Hush::MappedFile::Open(
+    const std::filesystem::path &path) noexcept
+{
+#if HUSH_PLATFORM_WIN
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return EError::CannotOpen;
+    }
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize))
+    {
+        CloseHandle(file);
+        return EError::CannotOpen;
+    }
+
+    const auto size = static_cast<std::size_t>(fileSize.QuadPart);
+    if (size == 0)
+    {
+        CloseHandle(file);
+        return MappedFile();
+    }
+
+    // The mapping keeps its own reference to the file.
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+
+    if (mapping == nullptr)
+    {
+        return EError::CannotMap;
+    }
+
+    void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr)
+    {
+        CloseHandle(mapping);
+        return EError::CannotMap;
+    }
+
+    return MappedFile(static_cast<const std::byte *>(data), size, mapping);
+#else
+    const int file = open(path.c_str(), O_RDONLY);
+
+    if (file == -1)
+    {
+        return EError::CannotOpen;
+    }
+
+    struct stat fileStat
+    {
+    };
+    if (fstat(file, &fileStat) != 0)
+    {
+        close(file);
+        return EError::CannotOpen;
+    }
+
+    const auto size = static_cast<std::size_t>(fileStat.st_size);
+    if (size == 0)
+    {
+        close(file);
+        return MappedFile();
+    }
+
+    // The mapping keeps its own reference to the file.
+    void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+
+    if (data == MAP_FAILED)
+    {
+        return EError::CannotMap;
+    }
+
+    // Files are usually read front to back.
+    madvise(data, size, MADV_SEQUENTIAL);
+
+    return MappedFile(static_cast<const std::byte *>(data), size, nullptr);
+#endif
+}
+
+void Hush::MappedFile::Unmap() noexcept
+{
+    if (m_data == nullptr)
+    {
+        return;
+    }
+
+#if HUSH_PLATFORM_WIN
+    UnmapViewOfFile(m_data);
+    CloseHandle(m_mappingHandle);
+#else
+    munmap(const_cast<std::byte *>(m_data), m_size);
+#endif
+
+    m_data = nullptr;
+    m_size = 0;
+    m_mappingHandle = nullptr;
+}
@@ -0,0 +1,63 @@
+/*! \file MappedFile.hpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Read-only memory mapped file
+*/
+
+#pragma once
+#include <Result.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace Hush
+{
+    /// Read-only view of a whole file mapped in memory. Pages are loaded by the OS on first access, so reading the
+    /// file does not require copying it to a buffer.
+    class MappedFile
+    {
+      public:
+        /// MappedFile error
+        enum class EError
+        {
+            CannotOpen,
+            CannotMap,
+        };
+
+        MappedFile() = default;
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        MappedFile(MappedFile &&rhs) noexcept;
+        MappedFile &operator=(MappedFile &&rhs) noexcept;
+
+        ~MappedFile();
+
+        /// Map a file in memory.
+        /// @param path Path of the file.
+        /// @return The mapped file, or an error if the file cannot be opened or mapped.
+        [[nodiscard]]
+        static Result<MappedFile, EError> Open(const std::filesystem::path &path) noexcept;
+
+        /// Gets the contents of the file. Valid while this object is alive.
+        /// @return Contents of the file.
+        [[nodiscard]]
+        std::span<const std::byte> GetData() const noexcept
+        {
+            return {m_data, m_size};
+        }
+
+      private:
+        MappedFile(const std::byte *data, std::size_t size, void *mappingHandle) noexcept;
+
+        void Unmap() noexcept;
+
+        const std::byte *m_data = nullptr;
+        std::size_t m_size = 0;
+
+        /// Handle of the file mapping, only used in Windows.
+        void *m_mappingHandle = nullptr;
+    };
+} // namespace Hush
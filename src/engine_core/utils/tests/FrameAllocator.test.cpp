@@ -0,0 +1,213 @@
+/*! \file FrameAllocator.test.cpp
+    \author Alan Ramirez
+    \date 2026-10-18
+    \brief Frame allocator tests
+*/
+
+#include "FrameAllocator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /// Small blocks, so a few allocations are enough to spill into new ones.
+    constexpr std::size_t TEST_BLOCK_SIZE = 256;
+
+    bool IsFilledWith(const std::byte *data, std::size_t size, std::byte value)
+    {
+        return std::all_of(data, data + size, [value](std::byte byte) { return byte == value; });
+    }
+} // namespace
+
+TEST_CASE("LinearArena", "[frame_allocator]")
+{
+    Hush::LinearArena arena(TEST_BLOCK_SIZE);
+
+    SECTION("No memory is reserved before the first allocation")
+    {
+        REQUIRE(arena.GetCapacity() == 0);
+        REQUIRE(arena.GetBlockAllocations() == 0);
+    }
+
+    SECTION("Allocations are aligned and do not overlap")
+    {
+        // Arrange
+        std::vector<std::byte *> allocations;
+
+        // Act
+        for (std::size_t alignment : {1, 4, 16, 64, 8, 128})
+        {
+            auto *data = static_cast<std::byte *>(arena.allocate(24, alignment));
+            std::memset(data, static_cast<int>(allocations.size()), 24);
+            allocations.push_back(data);
+
+            REQUIRE(reinterpret_cast<std::uintptr_t>(data) % alignment == 0);
+        }
+
+        // Assert
+        for (std::size_t i = 0; i < allocations.size(); ++i)
+        {
+            REQUIRE(IsFilledWith(allocations[i], 24, static_cast<std::byte>(i)));
+        }
+    }
+
+    SECTION("Blocks grow when full and are coalesced on reset")
+    {
+        // Arrange, two halves fill the first block
+        constexpr std::size_t half = TEST_BLOCK_SIZE / 2;
+        constexpr std::size_t big = TEST_BLOCK_SIZE * 16;
+
+        (void)arena.allocate(half, 1);
+        (void)arena.allocate(half, 1);
+        REQUIRE(arena.GetBlockAllocations() == 1);
+        REQUIRE(arena.GetCapacity() == TEST_BLOCK_SIZE);
+
+        // Act, the next block doubles in size
+        (void)arena.allocate(half, 1);
+
+        // Assert
+        REQUIRE(arena.GetBlockAllocations() == 2);
+        REQUIRE(arena.GetCapacity() == TEST_BLOCK_SIZE * 3);
+        REQUIRE(arena.GetUsedBytes() == half * 3);
+
+        // A big allocation gets a block at least as big as itself
+        (void)arena.allocate(big, 1);
+        REQUIRE(arena.GetBlockAllocations() == 3);
+        REQUIRE(arena.GetCapacity() >= TEST_BLOCK_SIZE * 3 + big);
+
+        // After a reset the same workload fits in a single block
+        const std::size_t capacity = arena.GetCapacity();
+        arena.Reset();
+        REQUIRE(arena.GetUsedBytes() == 0);
+        REQUIRE(arena.GetHighWaterMark() == half * 3 + big);
+        REQUIRE(arena.GetCapacity() == capacity);
+        REQUIRE(arena.GetBlockAllocations() == 4);
+
+        (void)arena.allocate(half, 1);
+        (void)arena.allocate(half, 1);
+        (void)arena.allocate(half, 1);
+        (void)arena.allocate(big, 1);
+        REQUIRE(arena.GetBlockAllocations() == 4);
+    }
+
+    SECTION("Memory is reused after a reset")
+    {
+        void *first = arena.allocate(64, 16);
+
+        arena.Reset();
+
+        REQUIRE(arena.allocate(64, 16) == first);
+        REQUIRE(arena.GetBlockAllocations() == 1);
+    }
+}
+
+TEST_CASE("FrameAllocator", "[frame_allocator]")
+{
+    constexpr std::uint32_t framesInFlight = 2;
+    Hush::FrameAllocator allocator(framesInFlight, TEST_BLOCK_SIZE);
+
+    SECTION("Frames in flight are clamped")
+    {
+        REQUIRE(Hush::FrameAllocator(0).GetFramesInFlight() == 1);
+        REQUIRE(Hush::FrameAllocator(10).GetFramesInFlight() == Hush::FrameAllocator::MAX_FRAMES_IN_FLIGHT);
+    }
+
+    SECTION("Allocations live for framesInFlight frames and are then reused")
+    {
+        // Arrange, one allocation per frame in flight
+        std::array<std::byte *, framesInFlight> frameData{};
+        std::array<std::pmr::memory_resource *, framesInFlight> frameResources{};
+
+        for (std::uint32_t frame = 0; frame < framesInFlight; ++frame)
+        {
+            if (frame != 0)
+            {
+                allocator.BeginFrame();
+            }
+
+            frameResources[frame] = allocator.GetResource();
+            frameData[frame] = static_cast<std::byte *>(frameResources[frame]->allocate(64, 16));
+            std::memset(frameData[frame], static_cast<int>(frame + 1), 64);
+        }
+
+        // Assert, every frame has its own arena and the older frames are untouched
+        REQUIRE(frameResources[0] != frameResources[1]);
+        REQUIRE(IsFilledWith(frameData[0], 64, std::byte{1}));
+        REQUIRE(IsFilledWith(frameData[1], 64, std::byte{2}));
+
+        const std::uint64_t blockAllocations = allocator.GetStats().blockAllocations;
+
+        // Act, framesInFlight frames later the first arena comes back, reset
+        allocator.BeginFrame();
+        std::pmr::memory_resource *resource = allocator.GetResource();
+
+        REQUIRE(allocator.GetFrameNumber() == framesInFlight);
+        REQUIRE(resource == frameResources[0]);
+        REQUIRE(allocator.GetStats().usedBytes == 0);
+
+        auto *data = static_cast<std::byte *>(resource->allocate(64, 16));
+
+        // Assert
+        REQUIRE(data == frameData[0]);
+        REQUIRE(IsFilledWith(frameData[1], 64, std::byte{2}));
+        REQUIRE(allocator.GetStats().blockAllocations == blockAllocations);
+    }
+
+    SECTION("Each thread gets its own arenas")
+    {
+        // Arrange
+        constexpr std::size_t numThreads = 4;
+        constexpr std::size_t allocationsPerThread = 64;
+        constexpr std::size_t allocationSize = 48;
+
+        std::array<std::pmr::memory_resource *, numThreads> resources{};
+        std::array<std::vector<std::byte *>, numThreads> allocations;
+
+        // Act, every thread spills into several blocks at the same time
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < numThreads; ++i)
+        {
+            threads.emplace_back([&, i]() {
+                resources[i] = allocator.GetResource();
+
+                for (std::size_t j = 0; j < allocationsPerThread; ++j)
+                {
+                    auto *data = static_cast<std::byte *>(resources[i]->allocate(allocationSize, 16));
+                    std::memset(data, static_cast<int>(i + 1), allocationSize);
+                    allocations[i].push_back(data);
+                }
+            });
+        }
+
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+
+        // Assert
+        const std::set<std::pmr::memory_resource *> uniqueResources(resources.begin(), resources.end());
+        REQUIRE(uniqueResources.size() == numThreads);
+
+        for (std::size_t i = 0; i < numThreads; ++i)
+        {
+            for (const std::byte *data : allocations[i])
+            {
+                REQUIRE(IsFilledWith(data, allocationSize, static_cast<std::byte>(i + 1)));
+            }
+        }
+
+        const Hush::FrameAllocatorStats stats = allocator.GetStats();
+        REQUIRE(stats.threadCount == numThreads);
+        REQUIRE(stats.usedBytes >= numThreads * allocationsPerThread * allocationSize);
+        REQUIRE(stats.blockAllocations > numThreads);
+    }
+}